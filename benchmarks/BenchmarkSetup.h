@@ -0,0 +1,69 @@
+//
+// BenchmarkSetup.h
+//
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+
+#include "Objects/ParticleStorage.h"
+
+namespace benchmarks {
+    /**
+     * @brief distance of neighbouring lattice points, close to the minimum of the Lennard-Jones potential with sigma 1
+     */
+    constexpr double latticeSpacing = 1.1225;
+
+    /**
+     * @brief cutoff radius of the linked cell benchmarks
+     */
+    constexpr double cutoffRadius = 2.5;
+
+    /**
+     * @brief places particles on a cubic lattice, filled row by row, with small deterministic velocities
+     * @param numParticles number of particles
+     * @param edgeLength set to the edge length of the cube that contains the lattice
+     * @return the particles
+     */
+    inline ParticleStorage createLattice(size_t numParticles, double &edgeLength) {
+        const auto perDimension = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(numParticles))));
+        edgeLength = static_cast<double>(perDimension) * latticeSpacing;
+        ParticleStorage particles;
+        particles.reserve(numParticles);
+        for (size_t i = 0; i < numParticles; ++i) {
+            const size_t x = i % perDimension;
+            const size_t y = (i / perDimension) % perDimension;
+            const size_t z = i / (perDimension * perDimension);
+            particles.push_back(Particle({(x + 0.5) * latticeSpacing, (y + 0.5) * latticeSpacing,
+                                          (z + 0.5) * latticeSpacing},
+                                         {0.01 * static_cast<double>(i * 7 % 5) - 0.02,
+                                          0.01 * static_cast<double>(i * 3 % 5) - 0.02,
+                                          0.01 * static_cast<double>(i % 5) - 0.02}, 1.0, 0));
+        }
+        return particles;
+    }
+
+    /**
+     * @brief reports the molecule updates per second (MUPS) of a benchmark that processes every particle once per
+     * iteration
+     * @param state state of the running benchmark
+     * @param numParticles number of particles processed per iteration
+     */
+    inline void reportMoleculeUpdates(benchmark::State &state, size_t numParticles) {
+        state.counters["MUPS"] = benchmark::Counter(static_cast<double>(numParticles),
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    /**
+     * @brief reports the number of bytes per particle, e.g. the size of an output file divided by its particles
+     * @param state state of the running benchmark
+     * @param numBytes number of bytes per iteration
+     * @param numParticles number of particles per iteration
+     */
+    inline void reportBytesPerParticle(benchmark::State &state, size_t numBytes, size_t numParticles) {
+        state.counters["bytes/particle"] = static_cast<double>(numBytes) / static_cast<double>(numParticles);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(numBytes));
+    }
+}
@@ -0,0 +1,196 @@
+//
+// CalculatorBenchmark.cpp
+//
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchmarkSetup.h"
+#include "Calculator/GravityCalculator.h"
+#include "Calculator/LennardJonesCalculator.h"
+#include "Calculator/LennardJonesSIMDCalculator.h"
+#include "Calculator/TabulatedCalculator.h"
+#include "Objects/Containers/BarnesHut/BarnesHutContainer.h"
+#include "Objects/Containers/DirectSum/DirectSumContainer.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+
+namespace {
+    /**
+     * @brief force between two particles at distances between 0.9 and the cutoff radius
+     */
+    template<class Calc>
+    void BM_CalculateFIJ(benchmark::State &state) {
+        Calc calculator;
+        constexpr size_t numDistances = 1024;
+        std::vector<std::array<double, 3> > distances(numDistances);
+        std::vector<double> norms(numDistances);
+        for (size_t i = 0; i < numDistances; ++i) {
+            const double norm = 0.9 + (benchmarks::cutoffRadius - 0.9) * static_cast<double>(i) / numDistances;
+            distances[i] = {norm * 0.6, norm * 0.8, 0.0};
+            norms[i] = norm;
+        }
+        size_t i = 0;
+        for (auto _: state) {
+            benchmark::DoNotOptimize(calculator.calculateFIJ(distances[i], 1.0, 1.0, norms[i]));
+            i = (i + 1) % numDistances;
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    BENCHMARK_TEMPLATE(BM_CalculateFIJ, Calculators::GravityCalculator);
+    BENCHMARK_TEMPLATE(BM_CalculateFIJ, Calculators::LennardJonesCalculator);
+    BENCHMARK_TEMPLATE(BM_CalculateFIJ, Calculators::LennardJonesSIMDCalculator);
+
+    /**
+     * @brief all pairs of a lattice of state.range(0) particles
+     */
+    template<class Calc>
+    void BM_CalculateFDirectSum(benchmark::State &state) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        double edgeLength;
+        ParticleContainers::DirectSumContainer container;
+        container.addParticles(benchmarks::createLattice(numParticles, edgeLength));
+        Calc calculator;
+        for (auto _: state) {
+            calculator.calculateF(container);
+            benchmark::ClobberMemory();
+        }
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    // the direct sum is quadratic, larger sizes take minutes per iteration
+    BENCHMARK_TEMPLATE(BM_CalculateFDirectSum, Calculators::LennardJonesCalculator)
+        ->RangeMultiplier(4)->Range(1 << 10, 1 << 14)->Unit(benchmark::kMillisecond);
+    BENCHMARK_TEMPLATE(BM_CalculateFDirectSum, Calculators::GravityCalculator)
+        ->RangeMultiplier(4)->Range(1 << 10, 1 << 14)->Unit(benchmark::kMillisecond);
+
+    /**
+     * @brief gravitational forces of state.range(0) particles in a Gaussian cloud with the opening angle
+     * state.range(1) / 10, reports the relative L2 error of the forces against the direct sum
+     */
+    void BM_CalculateFBarnesHut(benchmark::State &state) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        const double theta = static_cast<double>(state.range(1)) / 10;
+        // a dense core with a sparse halo, the same cloud for every theta
+        std::mt19937 generator(42);
+        std::normal_distribution<double> distribution(0.0, 10.0);
+        ParticleStorage particles;
+        particles.reserve(numParticles);
+        for (size_t i = 0; i < numParticles; ++i) {
+            particles.push_back(Particle({distribution(generator), distribution(generator), distribution(generator)},
+                                         {0.0, 0.0, 0.0}, 0.5 + static_cast<double>(i % 7) * 0.25, 0));
+        }
+        Calculators::GravityCalculator calculator;
+        ParticleContainers::DirectSumContainer direct;
+        direct.addParticles(particles);
+        calculator.calculateF(direct);
+
+        ParticleContainers::BarnesHutContainer tree(theta);
+        tree.addParticles(particles);
+        for (auto _: state) {
+            calculator.calculateF(tree);
+            benchmark::ClobberMemory();
+        }
+
+        const ParticleStorage &expected = direct.getStorage();
+        const ParticleStorage &actual = tree.getStorage();
+        double error = 0;
+        double norm = 0;
+        for (size_t i = 0; i < numParticles; ++i) {
+            error += std::pow(expected.fx[i] - actual.fx[i], 2) + std::pow(expected.fy[i] - actual.fy[i], 2) +
+                     std::pow(expected.fz[i] - actual.fz[i], 2);
+            norm += std::pow(expected.fx[i], 2) + std::pow(expected.fy[i], 2) + std::pow(expected.fz[i], 2);
+        }
+        state.counters["relativeError"] = std::sqrt(error / norm);
+        state.SetLabel("theta=" + std::to_string(theta).substr(0, 3));
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    // the same sizes as the direct sum above, theta = 0 is the exact direct sum through the tree
+    BENCHMARK(BM_CalculateFBarnesHut)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 14, 4), {0, 5, 8, 12}})
+        ->ArgNames({"N", "thetaTenths"})->Unit(benchmark::kMillisecond);
+
+    /**
+     * @brief linked cell force calculation of a lattice of state.range(0) particles in a cube with cells of
+     * 1 / state.range(1) of the cutoff radius
+     */
+    template<class Calc>
+    void BM_CalculateFLinkedCell(benchmark::State &state) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        double edgeLength;
+        ParticleStorage particles = benchmarks::createLattice(numParticles, edgeLength);
+        ParticleContainers::LinkedCellContainer container({edgeLength, edgeLength, edgeLength},
+                                                          benchmarks::cutoffRadius, 0, 0,
+                                                          1.0 / static_cast<double>(state.range(1)));
+        container.addParticles(particles);
+        container.updateParticlesInCell();
+        Calc calculator;
+        for (auto _: state) {
+            calculator.calculateF(container);
+            benchmark::ClobberMemory();
+        }
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    BENCHMARK_TEMPLATE(BM_CalculateFLinkedCell, Calculators::LennardJonesCalculator)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {1, 2, 3}})
+        ->ArgNames({"N", "cellsPerCutoff"})->Unit(benchmark::kMillisecond);
+    BENCHMARK_TEMPLATE(BM_CalculateFLinkedCell, Calculators::LennardJonesSIMDCalculator)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {1, 2, 3}})
+        ->ArgNames({"N", "cellsPerCutoff"})->Unit(benchmark::kMillisecond);
+
+    /**
+     * @brief complete time step with position, force and velocity update on linked cells
+     */
+    template<class Calc>
+    void BM_CalculateXFVLinkedCell(benchmark::State &state) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        double edgeLength;
+        ParticleStorage particles = benchmarks::createLattice(numParticles, edgeLength);
+        // leave room for the particles to move without leaving the domain
+        const double domainSize = edgeLength + 2 * benchmarks::cutoffRadius;
+        ParticleContainers::LinkedCellContainer container({domainSize, domainSize, domainSize},
+                                                          benchmarks::cutoffRadius);
+        container.addParticles(particles);
+        Calc calculator;
+        calculator.calculateF(container);
+        for (auto _: state) {
+            calculator.calculateXFV(container, 0.0005);
+            benchmark::ClobberMemory();
+        }
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    BENCHMARK_TEMPLATE(BM_CalculateXFVLinkedCell, Calculators::LennardJonesCalculator)
+        ->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond);
+
+    /**
+     * @brief linked cell force calculation of a lattice of state.range(0) particles with the tabulated potential
+     * state.range(1) of LJ, Morse and a Mie potential with non-integer exponents
+     */
+    void BM_CalculateFLinkedCellTabulated(benchmark::State &state) {
+        const char *const specifications[] = {"LJ", "Morse:5,1.5,1.1225", "Mie:5,1,13.5,6.5"};
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        double edgeLength;
+        ParticleStorage particles = benchmarks::createLattice(numParticles, edgeLength);
+        ParticleContainers::LinkedCellContainer container({edgeLength, edgeLength, edgeLength},
+                                                          benchmarks::cutoffRadius);
+        container.addParticles(particles);
+        container.updateParticlesInCell();
+        Calculators::TabulatedCalculator calculator(Calculators::TabulatedPotential::fromSpecification(
+            specifications[state.range(1)], benchmarks::cutoffRadius));
+        for (auto _: state) {
+            calculator.calculateF(container);
+            benchmark::ClobberMemory();
+        }
+        state.SetLabel(specifications[state.range(1)]);
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    BENCHMARK(BM_CalculateFLinkedCellTabulated)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0, 1, 2}})
+        ->ArgNames({"N", "potential"})->Unit(benchmark::kMillisecond);
+}
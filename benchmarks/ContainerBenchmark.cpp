@@ -0,0 +1,73 @@
+//
+// ContainerBenchmark.cpp
+//
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "BenchmarkSetup.h"
+#include "Objects/Containers/LinkedCell/BoundaryHandler.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+
+namespace {
+    /**
+     * @brief cell update of a lattice of state.range(0) particles. With state.range(1) = 0 no particle changed its
+     * cell, otherwise the storage is reversed before every update and the particles have to be sorted again.
+     */
+    void BM_UpdateParticlesInCell(benchmark::State &state) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        const bool reorder = state.range(1) != 0;
+        double edgeLength;
+        ParticleStorage particles = benchmarks::createLattice(numParticles, edgeLength);
+        ParticleContainers::LinkedCellContainer container({edgeLength, edgeLength, edgeLength},
+                                                          benchmarks::cutoffRadius);
+        container.addParticles(particles);
+        container.updateParticlesInCell();
+
+        std::vector<size_t> reversed(numParticles);
+        std::iota(reversed.rbegin(), reversed.rend(), 0);
+        ParticleStorage shuffled;
+        for (auto _: state) {
+            if (reorder) {
+                state.PauseTiming();
+                shuffled.gather(container.getStorage(), reversed);
+                std::swap(container.getStorage(), shuffled);
+                state.ResumeTiming();
+            }
+            container.updateParticlesInCell();
+            benchmark::ClobberMemory();
+        }
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    BENCHMARK(BM_UpdateParticlesInCell)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0, 1}})
+        ->ArgNames({"N", "reorder"})->Unit(benchmark::kMicrosecond);
+
+    /**
+     * @brief boundary handling of a lattice of state.range(0) particles filling the domain, with reflecting
+     * boundaries if state.range(1) is 1 and outflow boundaries otherwise
+     */
+    void BM_HandleBoundaries(benchmark::State &state) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        const bool reflecting = state.range(1) != 0;
+        double edgeLength;
+        ParticleStorage particles = benchmarks::createLattice(numParticles, edgeLength);
+        ParticleContainers::LinkedCellContainer container({edgeLength, edgeLength, edgeLength},
+                                                          benchmarks::cutoffRadius);
+        container.addParticles(particles);
+        container.updateParticlesInCell();
+        std::array<bool, 6> conditions{};
+        conditions.fill(reflecting);
+        BoundaryHandler handler(1, conditions, container);
+        for (auto _: state) {
+            handler.handleBoundaries();
+            benchmark::ClobberMemory();
+        }
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+    }
+
+    BENCHMARK(BM_HandleBoundaries)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0, 1}})
+        ->ArgNames({"N", "reflecting"})->Unit(benchmark::kMicrosecond);
+}
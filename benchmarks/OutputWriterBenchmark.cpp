@@ -0,0 +1,59 @@
+//
+// OutputWriterBenchmark.cpp
+//
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "BenchmarkSetup.h"
+#include "IO/Output/outputWriter/VTKBinaryWriter.h"
+#include "IO/Output/outputWriter/VTKWriter.h"
+#include "IO/Output/outputWriter/XYZWriter.h"
+#include "Objects/Containers/DirectSum/DirectSumContainer.h"
+
+namespace {
+    /**
+     * @brief writes one file of a lattice of state.range(0) particles per iteration
+     * @param writer the writer to be measured
+     * @param extension file extension of the writer
+     */
+    void benchmarkWriter(benchmark::State &state, outputWriters::OutputWriter &writer, const std::string &extension) {
+        const auto numParticles = static_cast<size_t>(state.range(0));
+        double edgeLength;
+        ParticleContainers::DirectSumContainer container;
+        container.addParticles(benchmarks::createLattice(numParticles, edgeLength));
+
+        const std::string baseName = (std::filesystem::temp_directory_path() / "MolSimBench").string();
+        for (auto _: state) {
+            writer.plotParticles(0, container, baseName);
+        }
+        writer.flush();
+        const std::string fileName = baseName + "_0000." + extension;
+        benchmarks::reportBytesPerParticle(state, std::filesystem::file_size(fileName), numParticles);
+        benchmarks::reportMoleculeUpdates(state, numParticles);
+        std::remove(fileName.c_str());
+    }
+
+    void BM_VTKWriter(benchmark::State &state) {
+        outputWriters::VTKWriter writer;
+        benchmarkWriter(state, writer, "vtu");
+    }
+
+    void BM_VTKBinaryWriter(benchmark::State &state) {
+        outputWriters::VTKBinaryWriter writer(state.range(1) != 0 ? outputWriters::VTKBinaryWriter::Encoding::BASE64
+                                                                  : outputWriters::VTKBinaryWriter::Encoding::RAW);
+        benchmarkWriter(state, writer, "vtu");
+    }
+
+    void BM_XYZWriter(benchmark::State &state) {
+        outputWriters::XYZWriter writer;
+        benchmarkWriter(state, writer, "xyz");
+    }
+
+    BENCHMARK(BM_VTKWriter)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_VTKBinaryWriter)
+        ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 19, 8), {0, 1}})
+        ->ArgNames({"N", "base64"})->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_XYZWriter)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,66 @@
+# microbenchmarks of the force kernels, containers and output writers, built with -DBUILD_BENCHMARKS=ON
+
+include(FetchContent)
+
+# fetch Google Benchmark from the github repository, without its own tests
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+FetchContent_Declare(
+        googlebenchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG        v1.8.3
+)
+FetchContent_MakeAvailable(googlebenchmark)
+
+# collect all benchmarks and the sources of the simulation without its main function
+file(GLOB_RECURSE BENCH_SRC
+        "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp"
+        "${CMAKE_CURRENT_SOURCE_DIR}/src/*.cpp"
+)
+list(FILTER BENCH_SRC EXCLUDE REGEX ".*/src/MolSim\\.cpp$")
+
+# create benchmark executable
+add_executable(MolSimBench ${BENCH_SRC})
+
+target_compile_features(MolSimBench
+        PRIVATE
+        cxx_std_17
+)
+
+target_include_directories(MolSimBench
+        PUBLIC
+        ${CMAKE_CURRENT_SOURCE_DIR}/libs/libxsd
+        PRIVATE
+        ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks
+        ${CMAKE_CURRENT_SOURCE_DIR}/src
+)
+
+target_link_libraries(MolSimBench
+        PUBLIC
+        xerces-c
+        cxxopts
+        PRIVATE
+        benchmark::benchmark
+        benchmark::benchmark_main
+        spdlog
+)
+
+find_package(OpenMP)
+if(OpenMP_CXX_FOUND)
+    target_link_libraries(MolSimBench PRIVATE OpenMP::OpenMP_CXX)
+endif()
+
+find_package(Threads REQUIRED)
+target_link_libraries(MolSimBench PRIVATE Threads::Threads)
+
+# always optimized and without sanitizers, independent of CMAKE_BUILD_TYPE. Only warnings are logged, so that the
+# logging does not show up in the measurements
+target_compile_options(MolSimBench
+        PRIVATE
+        $<$<CXX_COMPILER_ID:GNU>: -O3 -Wall>
+)
+target_compile_definitions(MolSimBench
+        PRIVATE
+        NDEBUG
+        SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_WARN
+)
@@ -7,14 +7,33 @@
 class Particle;
 #include <Objects/Particle.h>
 #include "../Objects/Containers/DirectSum/DirectSumContainer.h"
+#include "../Objects/Containers/BarnesHut/BarnesHutContainer.h"
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
+#include <stdexcept>
 #include "spdlog/spdlog.h"
 #include "utils/ArrayUtils.h"
 #include "../Objects/Containers/LinkedCell/BoundaryHandler.h"
 
 
 namespace Calculators {
+    /**
+     * @brief constants of the Störmer-Verlet integration that only depend on the time step, computed once per step
+     */
+    struct IntegrationStep {
+        /**
+         * @param deltaT timestep between iterations
+         */
+        explicit IntegrationStep(double deltaT)
+            : deltaT(deltaT), halfDeltaT(0.5 * deltaT), halfDeltaTSquared(0.5 * deltaT * deltaT) {}
+
+        double deltaT;
+        double halfDeltaT;
+        double halfDeltaTSquared;
+    };
+
     class Calculator {
     public:
         Calculator() = default;
@@ -22,18 +41,60 @@ namespace Calculators {
         virtual ~Calculator() = default;
 
         /**
-        * Updates all particle values for one iteration and updates the container if necessary
+        * Updates all particle values for one iteration and updates the container if necessary.
+        *
+        * The particles are moved, their forces are reset and they are sorted into their cells in a single sweep.
+        * The velocities are updated in the force pass where the calculator supports it, otherwise in a second sweep.
         * @param particleContainer the container that is operated on
         * @param delta_t timestep between iterations
         */
         void calculateXFV(ParticleContainers::ParticleContainer &particleContainer, double delta_t) {
             SPDLOG_TRACE("executing calculateXFV");
-            calculateX(particleContainer, delta_t);
-            calculateF(particleContainer);
-            calculateV(particleContainer, delta_t);
+            calculateXAndSort(particleContainer, delta_t);
+            calculateFV(particleContainer, delta_t);
+        }
+
+        /**
+        * First half of calculateXFV: moves the particles, makes their force the old force, resets the force and sorts
+        * the particles into their cells
+        * @param particleContainer the container that is operated on
+        * @param delta_t timestep between iterations
+        */
+        void calculateXAndSort(ParticleContainers::ParticleContainer &particleContainer, double delta_t) {
+            const IntegrationStep step(delta_t);
+            ParticleStorage &particles = particleContainer.getStorage();
+            // the current force becomes the old force, the position update resets the new force
+            particles.oldFx.swap(particles.fx);
+            particles.oldFy.swap(particles.fy);
+            particles.oldFz.swap(particles.fz);
+
+            if (auto lcCont = dynamic_cast<ParticleContainers::LinkedCellContainer *>(&particleContainer)) {
+                lcCont->updateParticlesInCell([&particles, &step](size_t i) { updatePosition(particles, i, step); });
+                return;
+            }
+            const size_t numParticles = particles.size();
+            for (size_t i = 0; i < numParticles; ++i) {
+                updatePosition(particles, i, step);
+            }
+        }
+
+        /**
+        * Second half of calculateXFV: calculates the new forces and updates the velocities, has to follow
+        * calculateXAndSort
+        * @param particleContainer the container that is operated on
+        * @param delta_t timestep between iterations
+        */
+        void calculateFV(ParticleContainers::ParticleContainer &particleContainer, double delta_t) {
+            const IntegrationStep step(delta_t);
             if (auto lcCont = dynamic_cast<ParticleContainers::LinkedCellContainer *>(&particleContainer)) {
-                lcCont->updateParticlesInCell();
+                // the halo cells of periodic boundaries hold images of the opposite side while the forces are computed
+                lcCont->createPeriodicImages();
+                calculateFVLinkedCell(*lcCont, step);
+                lcCont->removePeriodicImages();
+                return;
             }
+            calculateFContainer(particleContainer);
+            updateVelocities(particleContainer.getStorage(), step);
         }
 
         /**
@@ -42,107 +103,52 @@ namespace Calculators {
         */
         void calculateF(ParticleContainers::ParticleContainer &particleContainer) {
             SPDLOG_TRACE("executing calculateF");
-            // initialize sigma with zeros
-            std::array<double, 3> sigma = {0.0, 0.0, 0.0};
+            ParticleStorage &particles = particleContainer.getStorage();
 
-            for (auto &p: particleContainer) {
-                p.setOldF(p.getF());
-                p.setF(sigma);
-            }
+            // the current force becomes the old force, the new force is initialized with zeros
+            particles.oldFx.swap(particles.fx);
+            particles.oldFy.swap(particles.fy);
+            particles.oldFz.swap(particles.fz);
+            std::fill(particles.fx.begin(), particles.fx.end(), 0.0);
+            std::fill(particles.fy.begin(), particles.fy.end(), 0.0);
+            std::fill(particles.fz.begin(), particles.fz.end(), 0.0);
 
-            if (auto dsCont = dynamic_cast<ParticleContainers::DirectSumContainer *>(&particleContainer)) {
-                calculateFDirectSum(*dsCont);
-            } else if (auto lcCont = dynamic_cast<ParticleContainers::LinkedCellContainer *>(&particleContainer)) {
+            if (auto lcCont = dynamic_cast<ParticleContainers::LinkedCellContainer *>(&particleContainer)) {
+                // the halo cells of periodic boundaries hold images of the opposite side while the forces are computed
+                lcCont->createPeriodicImages();
                 calculateFLinkedCell(*lcCont);
+                lcCont->removePeriodicImages();
+            } else {
+                calculateFContainer(particleContainer);
             }
         }
 
-        /**Calculates the force for all particles in a DirectSumContainer 
+        /**Calculates the force for all particles in a DirectSumContainer
          * @param particleContainer the DirectSumContainer that is operated on
         */
-        
-        void calculateFDirectSum(ParticleContainers::DirectSumContainer &particleContainer) {
-            for (auto it1 = particleContainer.begin(); it1 != particleContainer.end(); ++it1) {
-                for (auto it2 = it1 + 1; it2 != particleContainer.end(); ++it2) {
-                    std::array<double, 3> sub = operator-(it2->getX(), it1->getX());
-                    double norm = ArrayUtils::L2Norm(sub);
-
-                    // calculate Force between the current pair of particles
-                    std::array<double, 3> fij = calculateFIJ(sub, it1->getM(), it2->getM(), norm);
-                    SPDLOG_TRACE("fij {} from particles {} and {}", fij[0], it1->getID(), it2->getID());
-                    // add force of this pair to the overall force of particle 1
-                    it1->setF(operator+(it1->getF(), fij));
-                    // make use of Newton's third law and add the negative force calculated above to particle 2
-                    it2->setF(operator-(it2->getF(), fij));
-                }
-            }
-        }
+        virtual void calculateFDirectSum(ParticleContainers::DirectSumContainer &particleContainer) = 0;
 
-         /**Calculates the force for all particles in a LinkedCellContainer 
-         * @param particleContainer the LinkedCellContainer that is operated on
+        /**Calculates the force for all particles in a LinkedCellContainer
+         * @param lcCon the LinkedCellContainer that is operated on
          */
-        void calculateFLinkedCell(ParticleContainers::LinkedCellContainer &lcCon) {
-            for (auto itCell = lcCon.beginCells(); itCell != lcCon.endCells(); ++itCell) {
-                for (auto itParticle1 = itCell->beginParticle(); itParticle1 != itCell->endParticle(); ++itParticle1) {
-                    if (*itParticle1 == nullptr) {
-                        continue;
-                    }
-                    for (auto itParticle2 = itParticle1 + 1; itParticle2 != itCell->endParticle(); ++itParticle2) {
-                        if (*itParticle2 == nullptr) {
-                            continue;
-                        }
-
-                        std::array<double, 3> sub = operator-((*itParticle2)->getX(), (*itParticle1)->getX());
-                        double normCubed = ArrayUtils::L2Norm(sub);
-
-                        // calculate Force between the current pair of particles
-                        std::array<double, 3> fij = calculateFIJ(sub, (*itParticle1)->getM(), (*itParticle2)->getM(),
-                                                                 normCubed);
-                        SPDLOG_TRACE("fij {} from particles {} and {}", fij[0], (*itParticle1)->getID(),
-                                     (*itParticle2)->getID());
-                        // add force of this pair to the overall force of particle 1
-                        (*itParticle1)->setF(operator+((*itParticle1)->getF(), fij));
-                        // make use of Newton's third law and add the negative force calculated above to particle 2
-                        (*itParticle2)->setF(operator-((*itParticle2)->getF(), fij));
-                    }
+        virtual void calculateFLinkedCell(ParticleContainers::LinkedCellContainer &lcCon) = 0;
 
-                }
-                for (Cell *neighbourCell: itCell->getNeighbourCells()) {
-                    if (neighbourCell == nullptr) {
-                        continue;
-                    }
+        /**Calculates the force for all particles in a LinkedCellContainer and updates their velocities.
+         * Calculators can override this to update the velocity of a particle as soon as its force is complete.
+         * @param lcCon the LinkedCellContainer that is operated on
+         * @param step constants of the current time step
+         */
+        virtual void calculateFVLinkedCell(ParticleContainers::LinkedCellContainer &lcCon, const IntegrationStep &step) {
+            calculateFLinkedCell(lcCon);
+            updateVelocities(lcCon.getStorage(), step);
+        }
 
-                    if (itCell->getInfluencedByCells().find(neighbourCell) != itCell->endInfluencedBy()) {
-                        continue;
-                    }
-                    for (auto itParticle1 = itCell->beginParticle(); itParticle1 != itCell->endParticle(); ++itParticle1) {
-                        for (Particle *neighbourP: neighbourCell->getParticlesInCell()) {
-                         //   SPDLOG_INFO("PASSED 2.1");
-                            if (neighbourP == nullptr) {
-                                continue;
-                            }
-
-                            std::array<double, 3> sub = operator-(neighbourP->getX(),(*itParticle1)->getX());
-                            double normL2 = ArrayUtils::L2Norm(sub);
-                            if (normL2 > lcCon.getCutoff()) {
-                                continue;
-                            }
-
-
-                            std::array<double, 3> fij = calculateFIJ(sub, (*itParticle1)->getM(), neighbourP->getM(),
-                                                                     normL2);
-                            SPDLOG_TRACE("fij {} from particles {} and {}", fij[0], (*itParticle1)->getID(),
-                                         neighbourP->getID());
-                            // add force of this pair to the overall force of particle 1
-                            (*itParticle1)->setF(operator+((*itParticle1)->getF(), fij));
-                            // make use of Newton's third law and add the negative force calculated above to particle 2
-                            neighbourP->setF(operator-(neighbourP->getF(), fij));
-                        }
-                        neighbourCell->addInfluencedByCell(&(*itCell));
-                       // SPDLOG_INFO("PASSED 2.2");
-                    }
-                }
-            }
+        /**Calculates the force for all particles in a BarnesHutContainer from its tree.
+         * Only calculators whose force can be approximated by the total mass of a node support this.
+         * @param bhCon the BarnesHutContainer that is operated on, its tree has to be up to date
+         */
+        virtual void calculateFBarnesHut(ParticleContainers::BarnesHutContainer &/*bhCon*/) {
+            throw std::runtime_error("The Barnes-Hut container is not supported by the calculator " + toString());
         }
 
         /**
@@ -163,28 +169,309 @@ namespace Calculators {
          */
         void calculateX(ParticleContainers::ParticleContainer &particleContainer, double delta_t) {
             SPDLOG_TRACE("executing calculateX");
-            for (auto &p: particleContainer) {
-                std::array<double, 3> newX = operator+(
-                    p.getX(), operator+(operator*(delta_t, p.getV()),
-                                        operator*(0.5 * pow(delta_t, 2) / p.getM(), p.getF())));
-                p.setX(newX);
+            const IntegrationStep step(delta_t);
+            ParticleStorage &particles = particleContainer.getStorage();
+            const size_t numParticles = particles.size();
+            for (size_t i = 0; i < numParticles; ++i) {
+                const double scale = step.halfDeltaTSquared / particles.m[i];
+                particles.x[i] += step.deltaT * particles.vx[i] + scale * particles.fx[i];
+                particles.y[i] += step.deltaT * particles.vy[i] + scale * particles.fy[i];
+                particles.z[i] += step.deltaT * particles.vz[i] + scale * particles.fz[i];
             }
         }
 
         /**
-         * calculate the position for all particles
+         * calculate the velocity for all particles
          * @param particleContainer the container that is operated on
          * @param delta_t timestep between iterations
          */
         void calculateV(ParticleContainers::ParticleContainer &particleContainer, double delta_t) {
             SPDLOG_TRACE("executing calculateV");
-            for (auto &particle: particleContainer) {
-                std::array<double, 3> newV = operator+(particle.getV(),
-                                                       operator*(delta_t * 0.5 / particle.getM(),
-                                                                 operator+(particle.getOldF(), particle.getF())));
-                particle.setV(newV);
+            updateVelocities(particleContainer.getStorage(), IntegrationStep(delta_t));
+        }
+
+        /**
+         * moves particle i with its current velocity and old force and resets its force,
+         * the force has to be swapped into the old force before
+         * @param particles storage containing the particle
+         * @param i storage index of the particle
+         * @param step constants of the current time step
+         */
+        static inline void updatePosition(ParticleStorage &particles, size_t i, const IntegrationStep &step) {
+            const double scale = step.halfDeltaTSquared / particles.m[i];
+            particles.x[i] += step.deltaT * particles.vx[i] + scale * particles.oldFx[i];
+            particles.y[i] += step.deltaT * particles.vy[i] + scale * particles.oldFy[i];
+            particles.z[i] += step.deltaT * particles.vz[i] + scale * particles.oldFz[i];
+            particles.fx[i] = 0.0;
+            particles.fy[i] = 0.0;
+            particles.fz[i] = 0.0;
+        }
+
+        /**
+         * updates the velocity of particle i from its old and its new force
+         * @param particles storage containing the particle
+         * @param i storage index of the particle
+         * @param step constants of the current time step
+         */
+        static inline void updateVelocity(ParticleStorage &particles, size_t i, const IntegrationStep &step) {
+            const double scale = step.halfDeltaT / particles.m[i];
+            particles.vx[i] += scale * (particles.oldFx[i] + particles.fx[i]);
+            particles.vy[i] += scale * (particles.oldFy[i] + particles.fy[i]);
+            particles.vz[i] += scale * (particles.oldFz[i] + particles.fz[i]);
+        }
+
+        /**
+         * updates the velocities of all particles in the storage
+         * @param particles storage containing the particles
+         * @param step constants of the current time step
+         */
+        static void updateVelocities(ParticleStorage &particles, const IntegrationStep &step) {
+            const size_t numParticles = particles.size();
+            for (size_t i = 0; i < numParticles; ++i) {
+                updateVelocity(particles, i, step);
             }
         }
+
+        /**
+         * @return the per-type Lennard-Jones parameters of the calculator or nullptr if it does not use them
+         */
+        virtual LennardJonesMixingTable *getLennardJonesParameters() {
+            return nullptr;
+        }
+
         virtual std::string toString() = 0;
+
+    private:
+        /**
+         * calculates the force for all particles of a DirectSumContainer or BarnesHutContainer, the forces have to
+         * be reset before
+         * @param particleContainer the container that is operated on
+         */
+        void calculateFContainer(ParticleContainers::ParticleContainer &particleContainer) {
+            if (auto dsCont = dynamic_cast<ParticleContainers::DirectSumContainer *>(&particleContainer)) {
+                calculateFDirectSum(*dsCont);
+            } else if (auto bhCont = dynamic_cast<ParticleContainers::BarnesHutContainer *>(&particleContainer)) {
+                bhCont->buildTree();
+                calculateFBarnesHut(*bhCont);
+            }
+        }
+    };
+
+    /**
+     * @brief Base class for calculators with a pairwise force.
+     *
+     * The force traversals are instantiated for every derived calculator (CRTP), so that the force kernel
+     * Kernel::forceFactor is inlined into the inner loops instead of being called virtually per pair.
+     * Kernel has to provide
+     * double forceFactor(double normSquared, const ParticleStorage &particles, size_t i, size_t j) const,
+     * returning the factor f such that f * (xj - xi) is the force acting on particle i.
+     * It can additionally hide prepareKernel, calculateCell and calculateCellPair, e.g. with vectorized cell kernels.
+     * @tparam Kernel the derived calculator
+     */
+    template <class Kernel>
+    class ForceCalculator : public Calculator {
+    public:
+        /**Calculates the force for all particles in a DirectSumContainer
+         * @param particleContainer the DirectSumContainer that is operated on
+        */
+        void calculateFDirectSum(ParticleContainers::DirectSumContainer &particleContainer) override {
+            ParticleStorage &particles = particleContainer.getStorage();
+            kernel().prepareKernel(particles);
+            const size_t numParticles = particles.size();
+            for (size_t i = 0; i < numParticles; ++i) {
+                for (size_t j = i + 1; j < numParticles; ++j) {
+                    calculatePair(particles, i, j);
+                }
+            }
+        }
+
+         /**Calculates the force for all particles in a LinkedCellContainer 
+         * @param particleContainer the LinkedCellContainer that is operated on
+         */
+        void calculateFLinkedCell(ParticleContainers::LinkedCellContainer &lcCon) override {
+            kernel().prepareKernel(lcCon.getStorage());
+            if (lcCon.usesVerletList()) {
+                calculateFVerletList(lcCon);
+                return;
+            }
+            calculateFLinkedCellColoured(lcCon, nullptr);
+        }
+
+        /**Calculates the force for all particles in a LinkedCellContainer and updates their velocities.
+         *
+         * The cell traversal updates the velocities of the particles of a cell right after the last colour that adds
+         * to their forces instead of in a separate sweep at the end. The Verlet list updates the velocities in a
+         * separate sweep.
+         * @param lcCon the LinkedCellContainer that is operated on
+         * @param step constants of the current time step
+         */
+        void calculateFVLinkedCell(ParticleContainers::LinkedCellContainer &lcCon, const IntegrationStep &step) override {
+            if (lcCon.usesVerletList()) {
+                calculateFLinkedCell(lcCon);
+                updateVelocities(lcCon.getStorage(), step);
+                return;
+            }
+            kernel().prepareKernel(lcCon.getStorage());
+            calculateFLinkedCellColoured(lcCon, &step);
+        }
+
+        /**Calculates the force for all particles in a LinkedCellContainer with all available OpenMP threads.
+         *
+         * The blocks of cells are processed colour by colour, also by a single thread, and every block visits its
+         * cells in the order of their index. Every cell computes the pairs inside itself and with its forward
+         * neighbours. Blocks of one colour never write the same cell, so no two threads write the force of the same
+         * particle and the blocks can be distributed freely. Every particle receives its contributions in the same
+         * order for any number of threads, so the forces and the trajectory are bitwise reproducible.
+         * @param lcCon the LinkedCellContainer that is operated on
+         * @param step constants of the current time step to update the velocities with, nullptr to only compute the
+         * forces
+         */
+        void calculateFLinkedCellColoured(ParticleContainers::LinkedCellContainer &lcCon, const IntegrationStep *step) {
+            ParticleStorage &particles = lcCon.getStorage();
+            const double cutoffSquared = lcCon.getCutoff() * lcCon.getCutoff();
+            auto cells = lcCon.beginCells();
+            const auto &colours = lcCon.getColouredBlocks();
+            const std::vector<std::vector<size_t> > &completedCells = lcCon.getCellsCompletedByColour();
+#pragma omp parallel
+            for (size_t c = 0; c < colours.size(); ++c) {
+                const std::vector<std::vector<size_t> > &colour = colours[c];
+#pragma omp for schedule(dynamic)
+                for (size_t k = 0; k < colour.size(); ++k) {
+                    for (size_t index: colour[k]) {
+                        calculateCellAndForwardNeighbours(particles, cells[index], cutoffSquared);
+                    }
+                }
+                if (step != nullptr) {
+                    const std::vector<size_t> &completed = completedCells[c];
+#pragma omp for schedule(static)
+                    for (size_t k = 0; k < completed.size(); ++k) {
+                        for (size_t i: cells[completed[k]].getParticlesInCell()) {
+                            updateVelocity(particles, i, *step);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**Calculates the forces within a cell and between the cell and its forward neighbours.
+         *
+         * The particles are sorted by cell, so neighbours with consecutive storage ranges, e.g. a row of small cells,
+         * are handed to the kernel as one range. Empty cells are skipped, which matters for cells smaller than the
+         * cutoff radius that hold a particle or less on average.
+         * @param particles storage containing the particles of the cells
+         * @param cell the cell
+         * @param cutoffSquared pairs with a squared distance above this value are skipped
+         */
+        void calculateCellAndForwardNeighbours(ParticleStorage &particles, const Cell &cell, double cutoffSquared) {
+            if (cell.getParticlesInCell().empty()) {
+                return;
+            }
+            kernel().calculateCell(particles, cell, cutoffSquared);
+            size_t begin = 0;
+            size_t end = 0;
+            for (const Cell *neighbourCell: cell.getForwardNeighbourCells()) {
+                const Cell::IndexRange neighbours = neighbourCell->getParticlesInCell();
+                if (neighbours.empty()) {
+                    continue;
+                }
+                if (*neighbours.begin() != end) {
+                    if (begin != end) {
+                        kernel().calculateCellPair(particles, cell, Cell::IndexRange(begin, end), cutoffSquared);
+                    }
+                    begin = *neighbours.begin();
+                }
+                end = *neighbours.end();
+            }
+            if (begin != end) {
+                kernel().calculateCellPair(particles, cell, Cell::IndexRange(begin, end), cutoffSquared);
+            }
+        }
+
+        /**Calculates the force for all particles in a LinkedCellContainer from its Verlet list
+         * @param lcCon the LinkedCellContainer that is operated on
+         */
+        void calculateFVerletList(ParticleContainers::LinkedCellContainer &lcCon) {
+            const double cutoffSquared = lcCon.getCutoff() * lcCon.getCutoff();
+            const auto &pairs = lcCon.getVerletPairs();
+            ParticleStorage &particles = lcCon.getStorage();
+            for (const auto &pair: pairs) {
+                calculatePair(particles, pair.first, pair.second, cutoffSquared);
+            }
+        }
+
+        /**
+         * called once before every force calculation. Derived calculators can hide this function to update
+         * state that depends on the particles (e.g. per-type parameters) outside of the pair loops.
+         * @param particles storage containing all particles
+         */
+        inline void prepareKernel(ParticleStorage &/*particles*/) {}
+
+        /**
+         * calculate the forces between all particles within one cell. Derived calculators can hide this
+         * function to provide a specialized cell kernel.
+         * @param particles storage containing the particles of the cell
+         * @param cell the cell
+         * @param cutoffSquared pairs with a squared distance above this value are skipped
+         */
+        inline void calculateCell(ParticleStorage &particles, const Cell &cell, double cutoffSquared) {
+            for (auto itParticle1 = cell.beginParticle(); itParticle1 != cell.endParticle(); ++itParticle1) {
+                for (auto itParticle2 = itParticle1 + 1; itParticle2 != cell.endParticle(); ++itParticle2) {
+                    calculatePair(particles, *itParticle1, *itParticle2, cutoffSquared);
+                }
+            }
+        }
+
+        /**
+         * calculate the forces between all particles of a cell and the particles of neighbouring cells. Derived
+         * calculators can hide this function to provide a specialized cell pair kernel.
+         * @param particles storage containing the particles of the cell and its neighbours
+         * @param cell the cell
+         * @param neighbours storage indices of the particles of one or more neighbouring cells
+         * @param cutoffSquared pairs with a squared distance above this value are skipped
+         */
+        inline void calculateCellPair(ParticleStorage &particles, const Cell &cell, Cell::IndexRange neighbours,
+                                      double cutoffSquared) {
+            for (size_t i: cell.getParticlesInCell()) {
+                for (size_t j: neighbours) {
+                    calculatePair(particles, i, j, cutoffSquared);
+                }
+            }
+        }
+
+        /**
+         * calculate the force between the particles with storage indices i and j and add it to both particles
+         * @param particles storage containing both particles
+         * @param i index of the first particle
+         * @param j index of the second particle
+         * @param cutoffSquared pairs with a squared distance above this value are skipped
+         */
+        inline void calculatePair(ParticleStorage &particles, size_t i, size_t j,
+                                  double cutoffSquared = std::numeric_limits<double>::infinity()) {
+            const double dx = particles.x[j] - particles.x[i];
+            const double dy = particles.y[j] - particles.y[i];
+            const double dz = particles.z[j] - particles.z[i];
+            const double normSquared = dx * dx + dy * dy + dz * dz;
+            if (normSquared > cutoffSquared) {
+                return;
+            }
+
+            // calculate Force between the current pair of particles, the force acting on i is factor * (xj - xi)
+            const double factor = kernel().forceFactor(normSquared, particles, i, j);
+            SPDLOG_TRACE("fij {} from particles {} and {}", factor * dx, particles.id[i], particles.id[j]);
+            // add force of this pair to the overall force of particle 1
+            particles.fx[i] += factor * dx;
+            particles.fy[i] += factor * dy;
+            particles.fz[i] += factor * dz;
+            // make use of Newton's third law and add the negative force calculated above to particle 2
+            particles.fx[j] -= factor * dx;
+            particles.fy[j] -= factor * dy;
+            particles.fz[j] -= factor * dz;
+        }
+
+    private:
+        /**
+         * @return the derived calculator that provides the force kernel
+         */
+        inline Kernel &kernel() { return static_cast<Kernel &>(*this); }
     };
 }
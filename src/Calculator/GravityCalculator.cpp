@@ -4,10 +4,71 @@
 
 #include "GravityCalculator.h"
 namespace Calculators {
-    std::array<double, 3> GravityCalculator::calculateFIJ(const std::array<double,3> &sub, double m1, double m2, double normCubed) {
-        return operator*(1.0/pow(normCubed, 3), operator*(m1*m2, sub));
+    void GravityCalculator::calculateFBarnesHut(ParticleContainers::BarnesHutContainer &bhCon) {
+        using Node = ParticleContainers::BarnesHutContainer::Node;
+        ParticleStorage &particles = bhCon.getStorage();
+        const std::vector<Node> &nodes = bhCon.getNodes();
+        const std::vector<size_t> &treeOrder = bhCon.getTreeOrder();
+        if (nodes.empty()) {
+            return;
+        }
+        const double thetaSquared = bhCon.getTheta() * bhCon.getTheta();
+        const long numParticles = static_cast<long>(treeOrder.size());
+
+        // particles are processed in tree order, so consecutive particles traverse similar parts of the tree
+#pragma omp parallel for schedule(dynamic, 64)
+        for (long k = 0; k < numParticles; ++k) {
+            const size_t i = treeOrder[k];
+            const double xi = particles.x[i], yi = particles.y[i], zi = particles.z[i];
+            const double mi = particles.m[i];
+            double fx = 0, fy = 0, fz = 0;
+
+            // at most 7 siblings per level wait on the stack
+            size_t stack[8 * (ParticleContainers::BarnesHutContainer::maxDepth + 1)];
+            size_t stackSize = 0;
+            stack[stackSize++] = 0;
+            while (stackSize > 0) {
+                const Node &node = nodes[stack[--stackSize]];
+                if (node.numChildren == 0) {
+                    for (size_t l = node.particlesBegin; l < node.particlesEnd; ++l) {
+                        const size_t j = treeOrder[l];
+                        if (j == i) {
+                            continue;
+                        }
+                        const double dx = particles.x[j] - xi;
+                        const double dy = particles.y[j] - yi;
+                        const double dz = particles.z[j] - zi;
+                        const double factor = gravityFactor(dx * dx + dy * dy + dz * dz, mi, particles.m[j]);
+                        fx += factor * dx;
+                        fy += factor * dy;
+                        fz += factor * dz;
+                    }
+                    continue;
+                }
+                const double dx = node.centerOfMass[0] - xi;
+                const double dy = node.centerOfMass[1] - yi;
+                const double dz = node.centerOfMass[2] - zi;
+                const double normSquared = dx * dx + dy * dy + dz * dz;
+                const double size = 2 * node.halfSize;
+                if (size * size < thetaSquared * normSquared) {
+                    // the node is far enough away to act as a single particle
+                    const double factor = gravityFactor(normSquared, mi, node.mass);
+                    fx += factor * dx;
+                    fy += factor * dy;
+                    fz += factor * dz;
+                } else {
+                    for (size_t child = node.firstChild; child < node.firstChild + node.numChildren; ++child) {
+                        stack[stackSize++] = child;
+                    }
+                }
+            }
+            particles.fx[i] += fx;
+            particles.fy[i] += fy;
+            particles.fz[i] += fz;
+        }
     }
+
     std::string GravityCalculator::toString() {
         return "Default";
     }
-}
\ No newline at end of file
+}
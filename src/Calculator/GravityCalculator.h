@@ -6,21 +6,58 @@
 #include "Calculator.h"
 
 namespace Calculators {
-    class GravityCalculator : public Calculator {
+    class GravityCalculator : public ForceCalculator<GravityCalculator> {
     public:
 
         GravityCalculator() = default;
 
         ~GravityCalculator() override = default;
+
         /**
-        *  function for calculating the force FIJ acting between two particles according to newton's law
-        * @param sub: subtraction of positions
+        *  Gravity force kernel according to newton's law
+        * @param normSquared: squared distance r^2 of the particles
         * @param m1: mass of particle i
-        * @param m2:mass of particle j
-        * @param normCubed: the cube of the norm
-        * @return force fij between the particle i and j
+        * @param m2: mass of particle j
+        * @return factor f such that f * (xj - xi) is the force acting on particle i
         */
-        std::array<double, 3> calculateFIJ(const std::array<double,3> &sub, double m1, double m2, double normCubed) override;
+        static inline double gravityFactor(double normSquared, double m1, double m2) {
+            return m1 * m2 / (normSquared * std::sqrt(normSquared));
+        }
+
+        /**
+        *  Gravity force kernel for the particles i and j of a storage
+        * @param normSquared: squared distance r^2 of the particles
+        * @param particles: storage containing both particles
+        * @param i: index of the first particle
+        * @param j: index of the second particle
+        * @return factor f such that f * (xj - xi) is the force acting on particle i
+        */
+        inline double forceFactor(double normSquared, const ParticleStorage &particles, size_t i, size_t j) const {
+            return gravityFactor(normSquared, particles.m[i], particles.m[j]);
+        }
+
+        /**
+        * calculate the gravitational force between particle i and j
+        * @param sub difference of the positions of j and i
+        * @param m1 mass of i
+        * @param m2 mass of j
+        * @param normCubed norm of sub
+        * @return force between i and j
+        */
+        std::array<double, 3> calculateFIJ(const std::array<double, 3> &sub, double m1, double m2,
+                                           double normCubed) override {
+            const double factor = gravityFactor(normCubed * normCubed, m1, m2);
+            return {factor * sub[0], factor * sub[1], factor * sub[2]};
+        }
+
+        /**Calculates the gravitational force for all particles in a BarnesHutContainer.
+         * Every particle traverses the tree on its own: nodes that appear smaller than the opening angle are
+         * replaced by their total mass at their center of mass, the particles of the remaining leaves interact
+         * directly. The particles only write their own force, so they are distributed over the OpenMP threads.
+         * @param bhCon the BarnesHutContainer that is operated on, its tree has to be up to date
+         */
+        void calculateFBarnesHut(ParticleContainers::BarnesHutContainer &bhCon) override;
+
         std::string toString() override;
 
     };
@@ -5,28 +5,123 @@
 #pragma once
 
 #include "Calculator.h"
+#include "LennardJonesMixingTable.h"
 #include "Objects/Particle.h"
 #include "../Objects/Containers/DirectSum/DirectSumContainer.h"
+#include <algorithm>
+#include <stdexcept>
 
 
 namespace Calculators{
-    class LennardJonesCalculator : public Calculator {
+    /**
+     * @brief Shared part of the Lennard-Jones calculators: the per-type parameters and the scalar kernel.
+     *
+     * The parameters of a pair are looked up in a LennardJonesMixingTable by the types of both particles.
+     * @tparam Derived the concrete calculator
+     */
+    template <class Derived>
+    class LennardJonesForceCalculator : public ForceCalculator<Derived> {
         public:
+          /**
+          *  Lennard-Jones force kernel. Computes (sigma/r)^6 from 1/r^2 with multiplications only.
+          * @param normSquared: squared distance r^2 of the particles
+          * @param parameters: mixed parameters of the types of both particles
+          * @return factor f such that f * (xj - xi) is the force acting on particle i
+          */
+          static inline double lennardJonesFactor(double normSquared,
+                                                  const LennardJonesMixingTable::PairParameters &parameters) {
+              const double invNormSquared = 1.0 / normSquared;
+              const double sr6 = parameters.sigma6 * invNormSquared * invNormSquared * invNormSquared;
+              return parameters.epsilon24 * invNormSquared * (sr6 - 2 * sr6 * sr6);
+          }
 
-          LennardJonesCalculator() = default;
+          /**
+          *  Lennard-Jones force kernel for the particles i and j of a storage
+          * @param normSquared: squared distance r^2 of the particles
+          * @param particles: storage containing both particles
+          * @param i: index of the first particle
+          * @param j: index of the second particle
+          * @return factor f such that f * (xj - xi) is the force acting on particle i
+          */
+          inline double forceFactor(double normSquared, const ParticleStorage &particles, size_t i, size_t j) const {
+              // with a single type the lookup of the particle types is skipped
+              if (singleType) {
+                  return lennardJonesFactor(normSquared, singleTypeParameters);
+              }
+              return lennardJonesFactor(normSquared, mixingTable.get(particles.type[i], particles.type[j]));
+          }
+
+          /**
+          * makes sure the mixing table contains every type of the particles, so the pair loops need no checks
+          * @param particles storage containing all particles
+          */
+          inline void prepareKernel(ParticleStorage &particles) {
+              if (particles.type.empty()) {
+                  return;
+              }
+              const auto [minType, maxType] = std::minmax_element(particles.type.begin(), particles.type.end());
+              if (*minType < 0) {
+                  throw std::invalid_argument("Particle types must not be negative");
+              }
+              mixingTable.ensureType(*maxType);
+              singleType = mixingTable.getNumTypes() == 1;
+              singleTypeParameters = mixingTable.get(0, 0);
+          }
+
+          /**
+          * calculate the Lennard-Jones force between two particles of type 0
+          * @param sub difference of the positions of j and i
+          * @param m1 mass of i (unused)
+          * @param m2 mass of j (unused)
+          * @param normCubed norm of sub
+          * @return force between i and j
+          */
+          std::array<double, 3> calculateFIJ(const std::array<double, 3> &sub, double /*m1*/, double /*m2*/,
+                                             double normCubed) override {
+              const double factor = lennardJonesFactor(normCubed * normCubed, mixingTable.get(0, 0));
+              return {factor * sub[0], factor * sub[1], factor * sub[2]};
+          }
+
+          /**
+          * sets epsilon and sigma of one particle type
+          * @param type the particle type, must not be negative
+          * @param epsilon depth of the potential well of the type
+          * @param sigma zero crossing of the potential of the type
+          */
+          void setTypeParameters(int type, double epsilon, double sigma) {
+              mixingTable.setTypeParameters(type, epsilon, sigma);
+          }
 
-          ~LennardJonesCalculator() override = default;
           /**
-          *  function for calculating the force FIJ acting between two particles according to lennard jones
-          * @param sub: subtraction of positions
-          * @param m1: mass of particle i
-          * @param m2:mass of particle j
-          * @param normCubed: the cube of the norm
-          * @return force fij between the particle i and j
+          * @return the parameters of all particle types
           */
-        std::array<double, 3> calculateFIJ(const std::array<double,3> &sub, double m1, double m2, double normCubed) override;
+          const LennardJonesMixingTable &getMixingTable() const { return mixingTable; }
+
+          /**
+          * @return the parameters of all particle types
+          */
+          LennardJonesMixingTable &getMixingTable() { return mixingTable; }
+
+          LennardJonesMixingTable *getLennardJonesParameters() override { return &mixingTable; }
+
+        protected:
+          /** parameters of every particle type and every pair of types */
+          LennardJonesMixingTable mixingTable;
+
+        private:
+          /** whether all particles have type 0, updated by prepareKernel */
+          bool singleType = true;
+          /** parameters of type 0, kept next to the flag so the single type kernel needs no table lookup */
+          LennardJonesMixingTable::PairParameters singleTypeParameters{};
+    };
+
+    class LennardJonesCalculator : public LennardJonesForceCalculator<LennardJonesCalculator> {
+        public:
+          LennardJonesCalculator() = default;
+
+          ~LennardJonesCalculator() override = default;
+
         std::string toString() override;
 
     };
 }
-
@@ -0,0 +1,62 @@
+//
+// LennardJonesMixingTable.cpp
+//
+
+#include "LennardJonesMixingTable.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace Calculators {
+    LennardJonesMixingTable::LennardJonesMixingTable(double defaultEpsilon, double defaultSigma)
+        : defaultEpsilon(defaultEpsilon), defaultSigma(defaultSigma) {
+        ensureType(0);
+    }
+
+    void LennardJonesMixingTable::setTypeParameters(int type, double epsilon, double sigma) {
+        if (type < 0) {
+            throw std::invalid_argument("Particle types must not be negative");
+        }
+        if (type >= numTypes) {
+            epsilons.resize(type + 1, defaultEpsilon);
+            sigmas.resize(type + 1, defaultSigma);
+            numTypes = type + 1;
+        }
+        epsilons[type] = epsilon;
+        sigmas[type] = sigma;
+        rebuild();
+    }
+
+    void LennardJonesMixingTable::ensureType(int maxType) {
+        if (maxType < numTypes) {
+            return;
+        }
+        if (maxType < 0) {
+            throw std::invalid_argument("Particle types must not be negative");
+        }
+        epsilons.resize(maxType + 1, defaultEpsilon);
+        sigmas.resize(maxType + 1, defaultSigma);
+        numTypes = maxType + 1;
+        rebuild();
+    }
+
+    double LennardJonesMixingTable::getEpsilon(int type) const {
+        return type >= 0 && type < numTypes ? epsilons[type] : defaultEpsilon;
+    }
+
+    double LennardJonesMixingTable::getSigma(int type) const {
+        return type >= 0 && type < numTypes ? sigmas[type] : defaultSigma;
+    }
+
+    void LennardJonesMixingTable::rebuild() {
+        table.resize(numTypes * numTypes);
+        for (int i = 0; i < numTypes; ++i) {
+            for (int j = 0; j < numTypes; ++j) {
+                const double sigma = 0.5 * (sigmas[i] + sigmas[j]);
+                const double sigmaSquared = sigma * sigma;
+                table[i * numTypes + j] = {24 * std::sqrt(epsilons[i] * epsilons[j]),
+                                           sigmaSquared * sigmaSquared * sigmaSquared};
+            }
+        }
+    }
+}
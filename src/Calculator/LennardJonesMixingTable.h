@@ -0,0 +1,103 @@
+//
+// LennardJonesMixingTable.h
+//
+
+#pragma once
+
+#include <vector>
+
+namespace Calculators {
+    /**
+     * @brief Lennard-Jones parameters for every particle type and every pair of types.
+     *
+     * The parameters of two different types are mixed with the Lorentz-Berthelot rules
+     * sigma_ij = (sigma_i + sigma_j) / 2 and epsilon_ij = sqrt(epsilon_i * epsilon_j).
+     * The mixed values are precomputed in the form the force kernels need them and packed into one small
+     * contiguous array, so that looking up the parameters of a pair is a single indexed load.
+     * Types that were never configured use the default parameters.
+     */
+    class LennardJonesMixingTable {
+    public:
+        /**
+         * @brief precomputed parameters of one pair of types
+         */
+        struct PairParameters {
+            /** 24 * epsilon_ij */
+            double epsilon24;
+            /** sigma_ij^6 */
+            double sigma6;
+        };
+
+        /**
+         * @brief Constructor for a table with only the default type 0
+         * @param defaultEpsilon epsilon of every type that is not configured explicitly
+         * @param defaultSigma sigma of every type that is not configured explicitly
+         */
+        explicit LennardJonesMixingTable(double defaultEpsilon = 5, double defaultSigma = 1);
+
+        /**
+         * @brief sets the parameters of one particle type and recomputes the mixed parameters of all pairs
+         * @param type the particle type, must not be negative
+         * @param epsilon depth of the potential well of the type
+         * @param sigma zero crossing of the potential of the type
+         */
+        void setTypeParameters(int type, double epsilon, double sigma);
+
+        /**
+         * @brief makes sure the table contains the types 0 to maxType, new types get the default parameters
+         * @param maxType largest type that has to be contained
+         */
+        void ensureType(int maxType);
+
+        /**
+         * Looks up the mixed parameters of two types. Both types have to be contained in the table.
+         * @param type1 type of the first particle
+         * @param type2 type of the second particle
+         * @return the precomputed parameters of the pair
+         */
+        inline const PairParameters &get(int type1, int type2) const {
+            return table[type1 * numTypes + type2];
+        }
+
+        /**
+         * @param type the particle type
+         * @return epsilon of the type, the default epsilon if the type was not configured
+         */
+        double getEpsilon(int type) const;
+
+        /**
+         * @param type the particle type
+         * @return sigma of the type, the default sigma if the type was not configured
+         */
+        double getSigma(int type) const;
+
+        /**
+         * @return number of types contained in the table
+         */
+        int getNumTypes() const { return numTypes; }
+
+        /**
+         * @return pointer to the packed table, the parameters of (type1, type2) are at index type1 * getNumTypes() + type2
+         */
+        const PairParameters *data() const { return table.data(); }
+
+    private:
+        /** epsilon used for types that were not configured */
+        double defaultEpsilon;
+        /** sigma used for types that were not configured */
+        double defaultSigma;
+        /** number of types contained in the table */
+        int numTypes = 0;
+        /** epsilon per type */
+        std::vector<double> epsilons;
+        /** sigma per type */
+        std::vector<double> sigmas;
+        /** mixed parameters, numTypes x numTypes entries */
+        std::vector<PairParameters> table;
+
+        /**
+         * @brief recomputes the mixed parameters of all pairs from the parameters of the single types
+         */
+        void rebuild();
+    };
+}
@@ -0,0 +1,283 @@
+//
+// LennardJonesSIMDCalculator.cpp
+//
+
+#include "LennardJonesSIMDCalculator.h"
+
+#include "spdlog/spdlog.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MOLSIM_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Calculators {
+    namespace {
+        using PairParameters = LennardJonesMixingTable::PairParameters;
+
+        /**
+         * @brief scalar interaction of particle i with the particles [begin, end), used for the remainders of the
+         * vectorized loops. The force on i is added to fxi, fyi and fzi, the forces on the partners are written directly.
+         */
+        inline void scalarRow(ParticleStorage &particles, const LennardJonesMixingTable &mixingTable, size_t i,
+                              size_t begin, size_t end, double cutoffSquared, double &fxi, double &fyi, double &fzi) {
+            for (size_t j = begin; j < end; ++j) {
+                const double dx = particles.x[j] - particles.x[i];
+                const double dy = particles.y[j] - particles.y[i];
+                const double dz = particles.z[j] - particles.z[i];
+                const double normSquared = dx * dx + dy * dy + dz * dz;
+                if (normSquared > cutoffSquared) {
+                    continue;
+                }
+                const double factor = LennardJonesCalculator::lennardJonesFactor(
+                    normSquared, mixingTable.get(particles.type[i], particles.type[j]));
+                fxi += factor * dx;
+                fyi += factor * dy;
+                fzi += factor * dz;
+                particles.fx[j] -= factor * dx;
+                particles.fy[j] -= factor * dy;
+                particles.fz[j] -= factor * dz;
+            }
+        }
+
+#ifdef MOLSIM_X86_SIMD
+        /**
+         * @brief AVX2 kernel, processes 4 partners of particle i at once. Pairs beyond the cutoff get a factor of 0.
+         * @tparam Mixed whether the particles have different types, then the parameters are gathered per lane
+         */
+        template <bool Mixed>
+        __attribute__((target("avx2,fma")))
+        void rangesAVX2(ParticleStorage &particles, const LennardJonesMixingTable &mixingTable, size_t begin1,
+                        size_t end1, size_t begin2, size_t end2, bool sameCell, double cutoffSquared) {
+            const double *x = particles.x.data();
+            const double *y = particles.y.data();
+            const double *z = particles.z.data();
+            const int *type = particles.type.data();
+            double *fx = particles.fx.data();
+            double *fy = particles.fy.data();
+            double *fz = particles.fz.data();
+            // the table is read as pairs of doubles, lane index 2k is epsilon24 and 2k + 1 is sigma6 of entry k
+            const double *table = &mixingTable.data()->epsilon24;
+            const __m256d cutoff = _mm256_set1_pd(cutoffSquared);
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d two = _mm256_set1_pd(2.0);
+            __m256d epsilon24 = _mm256_set1_pd(mixingTable.get(0, 0).epsilon24);
+            __m256d sigma6 = _mm256_set1_pd(mixingTable.get(0, 0).sigma6);
+
+            for (size_t i = begin1; i < end1; ++i) {
+                const __m256d xi = _mm256_set1_pd(x[i]);
+                const __m256d yi = _mm256_set1_pd(y[i]);
+                const __m256d zi = _mm256_set1_pd(z[i]);
+                const __m128i row = _mm_set1_epi32(type[i] * mixingTable.getNumTypes());
+                __m256d fxi = _mm256_setzero_pd();
+                __m256d fyi = _mm256_setzero_pd();
+                __m256d fzi = _mm256_setzero_pd();
+
+                size_t j = sameCell ? i + 1 : begin2;
+                for (; j + 4 <= end2; j += 4) {
+                    const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + j), xi);
+                    const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + j), yi);
+                    const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z + j), zi);
+                    const __m256d normSquared = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+                    const __m256d inCutoff = _mm256_cmp_pd(normSquared, cutoff, _CMP_LE_OQ);
+                    if (_mm256_movemask_pd(inCutoff) == 0) {
+                        continue;
+                    }
+                    if (Mixed) {
+                        const __m128i typeJ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(type + j));
+                        const __m128i index = _mm_slli_epi32(_mm_add_epi32(row, typeJ), 1);
+                        epsilon24 = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), table, index, inCutoff, 8);
+                        sigma6 = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), table + 1, index, inCutoff, 8);
+                    }
+                    const __m256d invNormSquared = _mm256_div_pd(one, normSquared);
+                    const __m256d invNormSixth = _mm256_mul_pd(_mm256_mul_pd(invNormSquared, invNormSquared), invNormSquared);
+                    const __m256d sr6 = _mm256_mul_pd(sigma6, invNormSixth);
+                    const __m256d lj = _mm256_sub_pd(sr6, _mm256_mul_pd(_mm256_mul_pd(two, sr6), sr6));
+                    const __m256d factor = _mm256_and_pd(
+                        inCutoff, _mm256_mul_pd(_mm256_mul_pd(epsilon24, invNormSquared), lj));
+
+                    const __m256d fxij = _mm256_mul_pd(factor, dx);
+                    const __m256d fyij = _mm256_mul_pd(factor, dy);
+                    const __m256d fzij = _mm256_mul_pd(factor, dz);
+                    fxi = _mm256_add_pd(fxi, fxij);
+                    fyi = _mm256_add_pd(fyi, fyij);
+                    fzi = _mm256_add_pd(fzi, fzij);
+                    _mm256_storeu_pd(fx + j, _mm256_sub_pd(_mm256_loadu_pd(fx + j), fxij));
+                    _mm256_storeu_pd(fy + j, _mm256_sub_pd(_mm256_loadu_pd(fy + j), fyij));
+                    _mm256_storeu_pd(fz + j, _mm256_sub_pd(_mm256_loadu_pd(fz + j), fzij));
+                }
+
+                // horizontal reduction of the force on particle i
+                alignas(32) double sum[3][4];
+                _mm256_store_pd(sum[0], fxi);
+                _mm256_store_pd(sum[1], fyi);
+                _mm256_store_pd(sum[2], fzi);
+                double fxSum = (sum[0][0] + sum[0][1]) + (sum[0][2] + sum[0][3]);
+                double fySum = (sum[1][0] + sum[1][1]) + (sum[1][2] + sum[1][3]);
+                double fzSum = (sum[2][0] + sum[2][1]) + (sum[2][2] + sum[2][3]);
+                scalarRow(particles, mixingTable, i, j, end2, cutoffSquared, fxSum, fySum, fzSum);
+                fx[i] += fxSum;
+                fy[i] += fySum;
+                fz[i] += fzSum;
+            }
+        }
+
+        /**
+         * @brief AVX-512 kernel, processes 8 partners of particle i at once. The remainder is handled with a masked
+         * load, pairs beyond the cutoff are excluded with the comparison mask.
+         * @tparam Mixed whether the particles have different types, then the parameters are gathered per lane
+         */
+        template <bool Mixed>
+        __attribute__((target("avx512f,avx512vl")))
+        void rangesAVX512(ParticleStorage &particles, const LennardJonesMixingTable &mixingTable, size_t begin1,
+                          size_t end1, size_t begin2, size_t end2, bool sameCell, double cutoffSquared) {
+            const double *x = particles.x.data();
+            const double *y = particles.y.data();
+            const double *z = particles.z.data();
+            const int *type = particles.type.data();
+            double *fx = particles.fx.data();
+            double *fy = particles.fy.data();
+            double *fz = particles.fz.data();
+            // the table is read as pairs of doubles, lane index 2k is epsilon24 and 2k + 1 is sigma6 of entry k
+            const double *table = &mixingTable.data()->epsilon24;
+            const __m512d cutoff = _mm512_set1_pd(cutoffSquared);
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d two = _mm512_set1_pd(2.0);
+            __m512d epsilon24 = _mm512_set1_pd(mixingTable.get(0, 0).epsilon24);
+            __m512d sigma6 = _mm512_set1_pd(mixingTable.get(0, 0).sigma6);
+
+            for (size_t i = begin1; i < end1; ++i) {
+                const __m512d xi = _mm512_set1_pd(x[i]);
+                const __m512d yi = _mm512_set1_pd(y[i]);
+                const __m512d zi = _mm512_set1_pd(z[i]);
+                const __m256i row = _mm256_set1_epi32(type[i] * mixingTable.getNumTypes());
+                __m512d fxi = _mm512_setzero_pd();
+                __m512d fyi = _mm512_setzero_pd();
+                __m512d fzi = _mm512_setzero_pd();
+
+                for (size_t j = sameCell ? i + 1 : begin2; j < end2; j += 8) {
+                    const size_t remaining = end2 - j;
+                    const __mmask8 valid = remaining >= 8 ? 0xFF : static_cast<__mmask8>((1u << remaining) - 1);
+                    const __m512d dx = _mm512_sub_pd(_mm512_mask_loadu_pd(xi, valid, x + j), xi);
+                    const __m512d dy = _mm512_sub_pd(_mm512_mask_loadu_pd(yi, valid, y + j), yi);
+                    const __m512d dz = _mm512_sub_pd(_mm512_mask_loadu_pd(zi, valid, z + j), zi);
+                    const __m512d normSquared = _mm512_fmadd_pd(dz, dz, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dx, dx)));
+                    const __mmask8 inCutoff = _mm512_mask_cmp_pd_mask(valid, normSquared, cutoff, _CMP_LE_OQ);
+                    if (inCutoff == 0) {
+                        continue;
+                    }
+                    if (Mixed) {
+                        const __m256i typeJ = _mm256_maskz_loadu_epi32(valid, type + j);
+                        const __m256i index = _mm256_slli_epi32(_mm256_add_epi32(row, typeJ), 1);
+                        epsilon24 = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), inCutoff, index, table, 8);
+                        sigma6 = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), inCutoff, index, table + 1, 8);
+                    }
+                    const __m512d invNormSquared = _mm512_maskz_div_pd(inCutoff, one, normSquared);
+                    const __m512d invNormSixth = _mm512_mul_pd(_mm512_mul_pd(invNormSquared, invNormSquared), invNormSquared);
+                    const __m512d sr6 = _mm512_mul_pd(sigma6, invNormSixth);
+                    const __m512d lj = _mm512_sub_pd(sr6, _mm512_mul_pd(_mm512_mul_pd(two, sr6), sr6));
+                    const __m512d factor = _mm512_maskz_mul_pd(inCutoff, _mm512_mul_pd(epsilon24, invNormSquared), lj);
+
+                    const __m512d fxij = _mm512_mul_pd(factor, dx);
+                    const __m512d fyij = _mm512_mul_pd(factor, dy);
+                    const __m512d fzij = _mm512_mul_pd(factor, dz);
+                    fxi = _mm512_add_pd(fxi, fxij);
+                    fyi = _mm512_add_pd(fyi, fyij);
+                    fzi = _mm512_add_pd(fzi, fzij);
+                    _mm512_mask_storeu_pd(fx + j, valid, _mm512_sub_pd(_mm512_maskz_loadu_pd(valid, fx + j), fxij));
+                    _mm512_mask_storeu_pd(fy + j, valid, _mm512_sub_pd(_mm512_maskz_loadu_pd(valid, fy + j), fyij));
+                    _mm512_mask_storeu_pd(fz + j, valid, _mm512_sub_pd(_mm512_maskz_loadu_pd(valid, fz + j), fzij));
+                }
+
+                // horizontal reduction of the force on particle i
+                alignas(64) double sum[3][8];
+                _mm512_store_pd(sum[0], fxi);
+                _mm512_store_pd(sum[1], fyi);
+                _mm512_store_pd(sum[2], fzi);
+                fx[i] += ((sum[0][0] + sum[0][1]) + (sum[0][2] + sum[0][3])) +
+                         ((sum[0][4] + sum[0][5]) + (sum[0][6] + sum[0][7]));
+                fy[i] += ((sum[1][0] + sum[1][1]) + (sum[1][2] + sum[1][3])) +
+                         ((sum[1][4] + sum[1][5]) + (sum[1][6] + sum[1][7]));
+                fz[i] += ((sum[2][0] + sum[2][1]) + (sum[2][2] + sum[2][3])) +
+                         ((sum[2][4] + sum[2][5]) + (sum[2][6] + sum[2][7]));
+            }
+        }
+#endif
+    }
+
+    LennardJonesSIMDCalculator::LennardJonesSIMDCalculator() : instructionSet(detectInstructionSet()) {
+        SPDLOG_DEBUG("LJC-SIMD uses instruction set {}", static_cast<int>(instructionSet));
+    }
+
+    LennardJonesSIMDCalculator::LennardJonesSIMDCalculator(InstructionSet instructionSet)
+        : instructionSet(instructionSet) {
+        if (instructionSet > detectInstructionSet()) {
+            SPDLOG_WARN("Requested instruction set is not supported by this CPU, using the widest supported one");
+            this->instructionSet = detectInstructionSet();
+        }
+    }
+
+    LennardJonesSIMDCalculator::InstructionSet LennardJonesSIMDCalculator::detectInstructionSet() {
+#ifdef MOLSIM_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) {
+            return InstructionSet::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return InstructionSet::AVX2;
+        }
+#endif
+        return InstructionSet::SCALAR;
+    }
+
+    LennardJonesSIMDCalculator::InstructionSet LennardJonesSIMDCalculator::getInstructionSet() const {
+        return instructionSet;
+    }
+
+    void LennardJonesSIMDCalculator::calculateRanges(ParticleStorage &particles, size_t begin1, size_t end1,
+                                                     size_t begin2, size_t end2, bool sameCell, double cutoffSquared) {
+        const bool mixed = mixingTable.getNumTypes() > 1;
+        switch (instructionSet) {
+#ifdef MOLSIM_X86_SIMD
+            case InstructionSet::AVX512:
+                if (mixed) {
+                    rangesAVX512<true>(particles, mixingTable, begin1, end1, begin2, end2, sameCell, cutoffSquared);
+                } else {
+                    rangesAVX512<false>(particles, mixingTable, begin1, end1, begin2, end2, sameCell, cutoffSquared);
+                }
+                return;
+            case InstructionSet::AVX2:
+                if (mixed) {
+                    rangesAVX2<true>(particles, mixingTable, begin1, end1, begin2, end2, sameCell, cutoffSquared);
+                } else {
+                    rangesAVX2<false>(particles, mixingTable, begin1, end1, begin2, end2, sameCell, cutoffSquared);
+                }
+                return;
+#endif
+            default:
+                for (size_t i = begin1; i < end1; ++i) {
+                    double fxi = 0, fyi = 0, fzi = 0;
+                    scalarRow(particles, mixingTable, i, sameCell ? i + 1 : begin2, end2, cutoffSquared, fxi, fyi, fzi);
+                    particles.fx[i] += fxi;
+                    particles.fy[i] += fyi;
+                    particles.fz[i] += fzi;
+                }
+        }
+    }
+
+    void LennardJonesSIMDCalculator::calculateCell(ParticleStorage &particles, const Cell &cell,
+                                                   double cutoffSquared) {
+        calculateRanges(particles, *cell.beginParticle(), *cell.endParticle(), *cell.beginParticle(),
+                        *cell.endParticle(), true, cutoffSquared);
+    }
+
+    void LennardJonesSIMDCalculator::calculateCellPair(ParticleStorage &particles, const Cell &cell,
+                                                       Cell::IndexRange neighbours, double cutoffSquared) {
+        calculateRanges(particles, *cell.beginParticle(), *cell.endParticle(), *neighbours.begin(), *neighbours.end(),
+                        false, cutoffSquared);
+    }
+
+    std::string LennardJonesSIMDCalculator::toString() {
+        return "LJC-SIMD";
+    }
+}
@@ -0,0 +1,87 @@
+//
+// LennardJonesSIMDCalculator.h
+//
+
+#pragma once
+
+#include "Calculator.h"
+#include "LennardJonesCalculator.h"
+
+namespace Calculators {
+    /**
+     * @brief Lennard-Jones calculator with vectorized cell kernels for the LinkedCellContainer.
+     *
+     * Since the particles of a cell are contiguous in the storage, the interactions of one particle with a whole cell
+     * are computed 8 (AVX-512) or 4 (AVX2) pairs at a time, with the cutoff applied as a mask.
+     * The instruction set is chosen at runtime, on other CPUs the scalar kernel of LennardJonesCalculator is used.
+     * With a single particle type the pair parameters are broadcast once, with several types they are gathered
+     * from the mixing table per lane. The direct sum and the Verlet list use the scalar kernel.
+     */
+    class LennardJonesSIMDCalculator : public LennardJonesForceCalculator<LennardJonesSIMDCalculator> {
+    public:
+        /**
+         * Instruction sets the cell kernels can be executed with
+         */
+        enum class InstructionSet {
+            SCALAR,
+            AVX2,
+            AVX512
+        };
+
+        /**
+         * @brief Constructor, selects the widest instruction set supported by the CPU
+         */
+        LennardJonesSIMDCalculator();
+
+        /**
+         * @brief Constructor for a fixed instruction set, e.g. for testing the fallback
+         * @param instructionSet the instruction set to use, has to be supported by the CPU
+         */
+        explicit LennardJonesSIMDCalculator(InstructionSet instructionSet);
+
+        ~LennardJonesSIMDCalculator() override = default;
+
+        /**
+         * calculate the forces between all particles within one cell with the selected instruction set
+         * @param particles storage containing the particles of the cell
+         * @param cell the cell
+         * @param cutoffSquared pairs with a squared distance above this value are skipped
+         */
+        void calculateCell(ParticleStorage &particles, const Cell &cell, double cutoffSquared);
+
+        /**
+         * calculate the forces between all particles of a cell and of neighbouring cells with the selected instruction set
+         * @param particles storage containing the particles of the cell and its neighbours
+         * @param cell the cell
+         * @param neighbours storage indices of the particles of one or more neighbouring cells
+         * @param cutoffSquared pairs with a squared distance above this value are skipped
+         */
+        void calculateCellPair(ParticleStorage &particles, const Cell &cell, Cell::IndexRange neighbours,
+                               double cutoffSquared);
+
+        /**
+         * @return the instruction set used by the cell kernels
+         */
+        InstructionSet getInstructionSet() const;
+
+        /**
+         * @return the widest instruction set supported by the CPU
+         */
+        static InstructionSet detectInstructionSet();
+
+        std::string toString() override;
+
+    private:
+        /**
+         * @brief instruction set used by the cell kernels
+         */
+        InstructionSet instructionSet;
+
+        /**
+         * @brief calculates the forces of the particles [begin1, end1) with the particles [begin2, end2).
+         * If sameCell is true both ranges are the same and every pair is only calculated once.
+         */
+        void calculateRanges(ParticleStorage &particles, size_t begin1, size_t end1, size_t begin2, size_t end2,
+                             bool sameCell, double cutoffSquared);
+    };
+}
@@ -0,0 +1,16 @@
+//
+// TabulatedCalculator.cpp
+//
+
+#include "TabulatedCalculator.h"
+
+namespace Calculators {
+    TabulatedCalculator::TabulatedCalculator(TabulatedPotential potential) : potential(std::move(potential)) {
+        SPDLOG_INFO("Tabulated potential {} with {} intervals, truncated and shifted at {}",
+                    this->potential.getDescription(), this->potential.getTableSize(), this->potential.getCutoff());
+    }
+
+    std::string TabulatedCalculator::toString() {
+        return "TAB";
+    }
+}
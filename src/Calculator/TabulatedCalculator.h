@@ -0,0 +1,62 @@
+//
+// TabulatedCalculator.h
+//
+#pragma once
+
+#include "Calculator.h"
+#include "TabulatedPotential.h"
+
+namespace Calculators {
+    /**
+     * @brief Calculator for any radial pair potential, looked up in the tables of a TabulatedPotential.
+     *
+     * Every pair costs one table lookup and a cubic polynomial regardless of the potential. All particle types interact
+     * with the same potential.
+     */
+    class TabulatedCalculator : public ForceCalculator<TabulatedCalculator> {
+    public:
+        /**
+         * @param potential the tabulated potential, truncated and shifted at the cutoff radius of the container
+         */
+        explicit TabulatedCalculator(TabulatedPotential potential);
+
+        ~TabulatedCalculator() override = default;
+
+        /**
+        *  Tabulated force kernel for the particles i and j of a storage
+        * @param normSquared: squared distance r^2 of the particles
+        * @param particles: storage containing both particles (unused)
+        * @param i: index of the first particle (unused)
+        * @param j: index of the second particle (unused)
+        * @return factor f such that f * (xj - xi) is the force acting on particle i
+        */
+        inline double forceFactor(double normSquared, const ParticleStorage &/*particles*/, size_t /*i*/,
+                                  size_t /*j*/) const {
+            return potential.forceFactor(normSquared);
+        }
+
+        /**
+        * calculate the force between two particles from the table
+        * @param sub difference of the positions of j and i
+        * @param m1 mass of i (unused)
+        * @param m2 mass of j (unused)
+        * @param normCubed norm of sub
+        * @return force between i and j
+        */
+        std::array<double, 3> calculateFIJ(const std::array<double, 3> &sub, double /*m1*/, double /*m2*/,
+                                           double normCubed) override {
+            const double factor = potential.forceFactor(normCubed * normCubed);
+            return {factor * sub[0], factor * sub[1], factor * sub[2]};
+        }
+
+        /**
+         * @return the tabulated potential
+         */
+        const TabulatedPotential &getPotential() const { return potential; }
+
+        std::string toString() override;
+
+    private:
+        TabulatedPotential potential;
+    };
+}
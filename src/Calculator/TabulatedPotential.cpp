@@ -0,0 +1,218 @@
+//
+// TabulatedPotential.cpp
+//
+
+#include "TabulatedPotential.h"
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "spdlog/spdlog.h"
+
+namespace {
+    /**
+     * @return coefficients in t of the cubic Hermite polynomial with the values and the derivatives with respect to
+     * t at t = 0 and t = 1
+     */
+    std::array<double, 4> hermite(double value0, double value1, double slope0, double slope1) {
+        return {value0, slope0, 3 * (value1 - value0) - 2 * slope0 - slope1, 2 * (value0 - value1) + slope0 + slope1};
+    }
+
+    [[noreturn]] void invalidPotential(const std::string &message) {
+        SPDLOG_ERROR("{}", message);
+        throw std::invalid_argument(message);
+    }
+
+    std::vector<double> parseParameters(const std::string &parameters, const std::string &specification) {
+        std::vector<double> values;
+        std::stringstream stream(parameters);
+        for (std::string value; std::getline(stream, value, ',');) {
+            try {
+                size_t length;
+                values.push_back(std::stod(value, &length));
+                if (length != value.size()) {
+                    throw std::invalid_argument(value);
+                }
+            } catch (const std::exception &) {
+                invalidPotential("Invalid parameter '" + value + "' of the potential " + specification);
+            }
+        }
+        return values;
+    }
+}
+
+namespace Calculators {
+    TabulatedPotential::TabulatedPotential(const std::function<double(double)> &potential,
+                                           const std::function<double(double)> &derivative, double minDistance,
+                                           double cutoff, size_t tableSize, std::string description)
+        : minSquared(minDistance * minDistance), cutoffSquared(cutoff * cutoff), description(std::move(description)) {
+        if (!(minDistance > 0 && minDistance < cutoff)) {
+            invalidPotential("The potential " + this->description + " needs a minimum distance between 0 and the "
+                             "cutoff radius " + std::to_string(cutoff));
+        }
+        if (tableSize == 0 || tableSize > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            invalidPotential("The table of a potential needs between 1 and INT_MAX intervals");
+        }
+        lastInterval = static_cast<int>(tableSize) - 1;
+        const double spacing = (cutoffSquared - minSquared) / static_cast<double>(tableSize);
+        inverseSpacing = 1 / spacing;
+
+        // the force factor as a function of r^2, its derivative is approximated by central differences
+        const auto forceOfSquare = [&derivative](double normSquared) {
+            const double norm = std::sqrt(normSquared);
+            return derivative(norm) / norm;
+        };
+        const double shift = potential(cutoff);
+        std::vector<double> forces(tableSize + 1), forceSlopes(tableSize + 1), energies(tableSize + 1);
+        for (size_t k = 0; k <= tableSize; ++k) {
+            const double normSquared = minSquared + static_cast<double>(k) * spacing;
+            const double delta = std::min(spacing / 16, normSquared / 2);
+            forces[k] = forceOfSquare(normSquared);
+            forceSlopes[k] = (forceOfSquare(normSquared + delta) - forceOfSquare(normSquared - delta)) / (2 * delta);
+            energies[k] = potential(std::sqrt(normSquared)) - shift;
+        }
+        forceTable.reserve(tableSize);
+        energyTable.reserve(tableSize);
+        for (size_t k = 0; k < tableSize; ++k) {
+            forceTable.push_back(hermite(forces[k], forces[k + 1], spacing * forceSlopes[k],
+                                         spacing * forceSlopes[k + 1]));
+            // dU/d(r^2) = U'(r) / (2r) is half the force factor
+            energyTable.push_back(hermite(energies[k], energies[k + 1], 0.5 * spacing * forces[k],
+                                          0.5 * spacing * forces[k + 1]));
+        }
+        SPDLOG_DEBUG("Tabulated {} with {} intervals between r = {} and the cutoff radius {}", this->description,
+                     tableSize, minDistance, cutoff);
+    }
+
+    TabulatedPotential TabulatedPotential::lennardJones(double epsilon, double sigma, double cutoff,
+                                                        size_t tableSize) {
+        TabulatedPotential result = mie(epsilon, sigma, 12, 6, cutoff, tableSize);
+        std::stringstream stream;
+        stream << "LJ(epsilon=" << epsilon << ", sigma=" << sigma << ")";
+        result.description = stream.str();
+        return result;
+    }
+
+    TabulatedPotential TabulatedPotential::morse(double depth, double width, double equilibriumDistance,
+                                                 double cutoff, size_t tableSize) {
+        if (!(depth > 0 && width > 0 && equilibriumDistance > 0)) {
+            invalidPotential("The depth, width and equilibrium distance of the Morse potential have to be positive");
+        }
+        std::stringstream stream;
+        stream << "Morse(D=" << depth << ", a=" << width << ", r0=" << equilibriumDistance << ")";
+        return {
+            [=](double r) {
+                const double e = std::exp(-width * (r - equilibriumDistance));
+                return depth * (e * e - 2 * e);
+            },
+            [=](double r) {
+                const double e = std::exp(-width * (r - equilibriumDistance));
+                return -2 * width * depth * (e * e - e);
+            },
+            equilibriumDistance / 2, cutoff, tableSize, stream.str()
+        };
+    }
+
+    TabulatedPotential TabulatedPotential::mie(double epsilon, double sigma, double repulsiveExponent,
+                                               double attractiveExponent, double cutoff, size_t tableSize) {
+        if (!(epsilon > 0 && sigma > 0 && attractiveExponent > 0 && repulsiveExponent > attractiveExponent)) {
+            invalidPotential("The Mie potential needs positive epsilon and sigma and exponents n > m > 0");
+        }
+        const double n = repulsiveExponent;
+        const double m = attractiveExponent;
+        const double prefactor = epsilon * n / (n - m) * std::pow(n / m, m / (n - m));
+        std::stringstream stream;
+        stream << "Mie(epsilon=" << epsilon << ", sigma=" << sigma << ", n=" << n << ", m=" << m << ")";
+        return {
+            [=](double r) {
+                return prefactor * (std::pow(sigma / r, n) - std::pow(sigma / r, m));
+            },
+            [=](double r) {
+                return prefactor / r * (m * std::pow(sigma / r, m) - n * std::pow(sigma / r, n));
+            },
+            sigma / 2, cutoff, tableSize, stream.str()
+        };
+    }
+
+    TabulatedPotential TabulatedPotential::fromFile(const std::string &filename, double cutoff, size_t tableSize) {
+        std::ifstream file(filename);
+        if (!file) {
+            invalidPotential("Could not open the potential file " + filename);
+        }
+        std::vector<double> distances, potentials, forces;
+        for (std::string line; std::getline(file, line);) {
+            std::stringstream stream(line);
+            double r, u, f;
+            if (line.empty() || line[0] == '#' || !(stream >> r)) {
+                continue;
+            }
+            if (!(stream >> u >> f) || r <= 0 || (!distances.empty() && r <= distances.back())) {
+                invalidPotential("Invalid line '" + line + "' in the potential file " + filename +
+                                 ", expected increasing r > 0 followed by U(r) and -dU/dr");
+            }
+            distances.push_back(r);
+            potentials.push_back(u);
+            forces.push_back(f);
+        }
+        if (distances.size() < 2 || distances.back() < cutoff) {
+            invalidPotential("The potential file " + filename + " has to cover the cutoff radius " +
+                             std::to_string(cutoff));
+        }
+
+        // cubic Hermite interpolation in r between the samples, the slopes are the negative forces
+        auto segment = [distances](double r) {
+            const auto upper = std::upper_bound(distances.begin(), distances.end(), r);
+            const auto k = std::distance(distances.begin(), upper) - 1;
+            return static_cast<size_t>(std::clamp<std::ptrdiff_t>(k, 0, static_cast<std::ptrdiff_t>(distances.size()) - 2));
+        };
+        auto potential = [=](double r) {
+            const size_t k = segment(r);
+            const double h = distances[k + 1] - distances[k];
+            const std::array<double, 4> c = hermite(potentials[k], potentials[k + 1], -h * forces[k],
+                                                    -h * forces[k + 1]);
+            const double t = (r - distances[k]) / h;
+            return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        };
+        auto derivative = [=](double r) {
+            const size_t k = segment(r);
+            const double h = distances[k + 1] - distances[k];
+            const std::array<double, 4> c = hermite(potentials[k], potentials[k + 1], -h * forces[k],
+                                                    -h * forces[k + 1]);
+            const double t = (r - distances[k]) / h;
+            return (c[1] + t * (2 * c[2] + t * 3 * c[3])) / h;
+        };
+        return {potential, derivative, distances.front(), cutoff, tableSize, "file " + filename};
+    }
+
+    TabulatedPotential TabulatedPotential::fromSpecification(const std::string &specification, double cutoff,
+                                                             size_t tableSize) {
+        const size_t colon = specification.find(':');
+        const std::string name = specification.substr(0, colon);
+        const std::string arguments = colon == std::string::npos ? "" : specification.substr(colon + 1);
+        if (name == "file") {
+            return fromFile(arguments, cutoff, tableSize);
+        }
+        const std::vector<double> parameters = parseParameters(arguments, specification);
+        if (name == "LJ" && parameters.empty()) {
+            return lennardJones(5, 1, cutoff, tableSize);
+        }
+        if (name == "LJ" && parameters.size() == 2) {
+            return lennardJones(parameters[0], parameters[1], cutoff, tableSize);
+        }
+        if (name == "Morse" && parameters.size() == 3) {
+            return morse(parameters[0], parameters[1], parameters[2], cutoff, tableSize);
+        }
+        if (name == "Mie" && parameters.size() == 4) {
+            return mie(parameters[0], parameters[1], parameters[2], parameters[3], cutoff, tableSize);
+        }
+        invalidPotential("Invalid potential " + specification + ", expected LJ, LJ:{epsilon},{sigma}, "
+                         "Morse:{D},{a},{r0}, Mie:{epsilon},{sigma},{n},{m} or file:{path}");
+    }
+
+    double TabulatedPotential::getCutoff() const { return std::sqrt(cutoffSquared); }
+
+    double TabulatedPotential::getMinDistance() const { return std::sqrt(minSquared); }
+}
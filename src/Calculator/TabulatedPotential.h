@@ -0,0 +1,148 @@
+//
+// TabulatedPotential.h
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Calculators {
+    /**
+     * @brief A radial pair potential tabulated on the squared distance and truncated and shifted at the cutoff radius.
+     *
+     * The force factor U'(r) / r and the shifted potential U(r) - U(r_c) are sampled at equidistant knots of r^2
+     * between the minimum distance and the cutoff radius and interpolated with cubic Hermite polynomials. A lookup
+     * takes no square root and costs the same for every potential. Both tables are zero beyond the cutoff radius and
+     * keep their value at the minimum distance below it.
+     */
+    class TabulatedPotential {
+    public:
+        /** number of intervals of the tables if none is given */
+        static constexpr size_t defaultTableSize = 2048;
+
+        /**
+         * @brief samples a potential and its derivative
+         * @param potential U(r)
+         * @param derivative dU/dr
+         * @param minDistance smallest tabulated distance
+         * @param cutoff cutoff radius, the potential is shifted by U(cutoff)
+         * @param tableSize number of intervals of the tables
+         * @param description name and parameters of the potential for the log
+         * @throws std::invalid_argument if the distances or the table size are invalid
+         */
+        TabulatedPotential(const std::function<double(double)> &potential,
+                           const std::function<double(double)> &derivative, double minDistance, double cutoff,
+                           size_t tableSize = defaultTableSize, std::string description = "custom");
+
+        /**
+         * @brief Lennard-Jones potential 4 epsilon ((sigma / r)^12 - (sigma / r)^6), tabulated from sigma / 2
+         */
+        static TabulatedPotential lennardJones(double epsilon, double sigma, double cutoff,
+                                               size_t tableSize = defaultTableSize);
+
+        /**
+         * @brief Morse potential D (exp(-2a (r - r0)) - 2 exp(-a (r - r0))), tabulated from r0 / 2
+         * @param depth depth D of the potential well
+         * @param width inverse width a of the potential well
+         * @param equilibriumDistance position r0 of the minimum
+         */
+        static TabulatedPotential morse(double depth, double width, double equilibriumDistance, double cutoff,
+                                        size_t tableSize = defaultTableSize);
+
+        /**
+         * @brief Mie potential C epsilon ((sigma / r)^n - (sigma / r)^m) with C = n / (n - m) (n / m)^(m / (n - m)),
+         * tabulated from sigma / 2. The Lennard-Jones potential is the Mie potential with n = 12 and m = 6.
+         * @param repulsiveExponent n, has to be larger than m
+         * @param attractiveExponent m
+         */
+        static TabulatedPotential mie(double epsilon, double sigma, double repulsiveExponent,
+                                      double attractiveExponent, double cutoff, size_t tableSize = defaultTableSize);
+
+        /**
+         * @brief Reads a potential from a text file with the columns r, U(r) and the force -dU/dr.
+         * Lines starting with # are skipped, r has to increase and the last r must not be smaller than the cutoff
+         * radius. The samples are interpolated with cubic Hermite polynomials in r, the smallest r of the file is the
+         * minimum distance of the table.
+         * @throws std::invalid_argument if the file can not be read or does not cover the cutoff radius
+         */
+        static TabulatedPotential fromFile(const std::string &filename, double cutoff,
+                                           size_t tableSize = defaultTableSize);
+
+        /**
+         * @brief Creates a potential from a specification of the command line or an xml file:
+         * 'LJ' or 'LJ:{epsilon},{sigma}', 'Morse:{D},{a},{r0}', 'Mie:{epsilon},{sigma},{n},{m}' or 'file:{path}'.
+         * 'LJ' alone uses epsilon = 5 and sigma = 1 like the Lennard-Jones calculators.
+         * @throws std::invalid_argument if the specification is invalid
+         */
+        static TabulatedPotential fromSpecification(const std::string &specification, double cutoff,
+                                                    size_t tableSize = defaultTableSize);
+
+        /**
+         * @param normSquared squared distance r^2 of two particles
+         * @return factor f such that f * (xj - xi) is the force acting on particle i
+         */
+        inline double forceFactor(double normSquared) const {
+            if (normSquared >= cutoffSquared) {
+                return 0;
+            }
+            double t;
+            const std::array<double, 4> &c = forceTable[locate(normSquared, t)];
+            return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        }
+
+        /**
+         * @param normSquared squared distance r^2 of two particles
+         * @return the truncated and shifted potential U(r) - U(r_c) of the pair
+         */
+        inline double energy(double normSquared) const {
+            if (normSquared >= cutoffSquared) {
+                return 0;
+            }
+            double t;
+            const std::array<double, 4> &c = energyTable[locate(normSquared, t)];
+            return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        }
+
+        double getCutoff() const;
+
+        double getMinDistance() const;
+
+        /**
+         * @return number of intervals of the tables
+         */
+        size_t getTableSize() const { return forceTable.size(); }
+
+        /**
+         * @return name and parameters of the potential
+         */
+        const std::string &getDescription() const { return description; }
+
+    private:
+        /** coefficients of the cubic polynomial of every interval in the position t in [0, 1] within the interval */
+        std::vector<std::array<double, 4> > forceTable;
+        std::vector<std::array<double, 4> > energyTable;
+        double minSquared;
+        double cutoffSquared;
+        /** number of intervals per unit of r^2 */
+        double inverseSpacing;
+        int lastInterval;
+        std::string description;
+
+        /**
+         * @param normSquared squared distance below the cutoff radius
+         * @param t set to the position within the interval
+         * @return index of the interval that contains normSquared
+         */
+        inline size_t locate(double normSquared, double &t) const {
+            const double x = std::max(normSquared - minSquared, 0.0) * inverseSpacing;
+            // the conversion to int is a single instruction, unlike the one to size_t
+            const int interval = std::min(static_cast<int>(x), lastInterval);
+            t = x - interval;
+            return static_cast<size_t>(interval);
+        }
+    };
+}
@@ -0,0 +1,252 @@
+//
+// Checkpoint.cpp
+//
+
+#include "Checkpoint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "spdlog/spdlog.h"
+
+namespace {
+    const char checkpointMagic[8] = {'M', 'O', 'L', 'S', 'I', 'M', 'C', 'P'};
+    const uint32_t byteOrderMark = 0x01020304;
+
+    enum ContainerType : uint32_t {
+        DIRECT_SUM = 0,
+        LINKED_CELL = 1,
+        BARNES_HUT = 2
+    };
+
+    /**
+     * @brief layout of the start of a checkpoint, followed by numTypes pairs of epsilon and sigma and by the particle
+     * arrays x, y, z, vx, vy, vz, fx, fy, fz, oldFx, oldFy, oldFz, m (double), type (int32) and id (int64)
+     */
+    struct CheckpointHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t containerType;
+        int32_t rebuildFrequency;
+        double domainSize[3];
+        double cutoff;
+        double skin;
+        double cellSizeFactor;
+        double theta;
+        uint8_t hasBoundaryHandler;
+        uint8_t boundaryConditions[6];
+        uint8_t padding;
+        int64_t iteration;
+        double time;
+        double deltaT;
+        char calculator[16];
+        uint64_t numTypes;
+        uint64_t numParticles;
+    };
+    static_assert(std::is_trivially_copyable<CheckpointHeader>::value, "the header is written as raw bytes");
+
+    std::vector<double> ParticleStorage::*const doubleArrays[] = {
+            &ParticleStorage::x, &ParticleStorage::y, &ParticleStorage::z,
+            &ParticleStorage::vx, &ParticleStorage::vy, &ParticleStorage::vz,
+            &ParticleStorage::fx, &ParticleStorage::fy, &ParticleStorage::fz,
+            &ParticleStorage::oldFx, &ParticleStorage::oldFy, &ParticleStorage::oldFz, &ParticleStorage::m
+    };
+
+    static_assert(sizeof(int) == sizeof(int32_t), "types are stored as int32");
+    static_assert(sizeof(ParticleId) == sizeof(int64_t), "ids are stored as int64");
+
+    template<typename T>
+    void writeArray(std::ofstream &file, const std::vector<T> &array) {
+        file.write(reinterpret_cast<const char *>(array.data()), static_cast<std::streamsize>(array.size() * sizeof(T)));
+    }
+
+    /**
+     * @brief copies the next bytes of the checkpoint to destination
+     */
+    void readBytes(const std::vector<char> &buffer, size_t &position, void *destination, size_t numBytes) {
+        if (buffer.size() - position < numBytes) {
+            throw std::runtime_error("Checkpoint is truncated");
+        }
+        std::memcpy(destination, buffer.data() + position, numBytes);
+        position += numBytes;
+    }
+}
+
+void Checkpoint::write(const std::string &filename, ParticleContainers::ParticleContainer &particleContainer,
+                       const BoundaryHandler *boundaryHandler, Calculators::Calculator &calculator,
+                       const SimulationState &state) {
+    CheckpointHeader header{};
+    std::memcpy(header.magic, checkpointMagic, sizeof(checkpointMagic));
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    if (auto lcCont = dynamic_cast<ParticleContainers::LinkedCellContainer *>(&particleContainer)) {
+        header.containerType = LINKED_CELL;
+        const std::array<double, 3> domainSize = lcCont->getDomainSize();
+        std::copy(domainSize.begin(), domainSize.end(), header.domainSize);
+        header.cutoff = lcCont->getCutoff();
+        header.skin = lcCont->getSkin();
+        header.cellSizeFactor = lcCont->getCellSizeFactor();
+        header.rebuildFrequency = lcCont->getRebuildFrequency();
+    } else if (auto bhCont = dynamic_cast<ParticleContainers::BarnesHutContainer *>(&particleContainer)) {
+        header.containerType = BARNES_HUT;
+        header.theta = bhCont->getTheta();
+    } else {
+        header.containerType = DIRECT_SUM;
+    }
+    if (boundaryHandler != nullptr) {
+        header.hasBoundaryHandler = 1;
+        const std::array<BoundaryCondition, 6> &conditions = boundaryHandler->getBoundaryConditions();
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            header.boundaryConditions[i] = static_cast<uint8_t>(conditions[i]);
+        }
+    }
+    header.iteration = state.iteration;
+    header.time = state.time;
+    header.deltaT = state.deltaT;
+    std::strncpy(header.calculator, calculator.toString().c_str(), sizeof(header.calculator) - 1);
+
+    std::vector<double> typeParameters;
+    if (const Calculators::LennardJonesMixingTable *mixingTable = calculator.getLennardJonesParameters()) {
+        for (int type = 0; type < mixingTable->getNumTypes(); ++type) {
+            typeParameters.push_back(mixingTable->getEpsilon(type));
+            typeParameters.push_back(mixingTable->getSigma(type));
+        }
+    }
+    header.numTypes = typeParameters.size() / 2;
+
+    ParticleStorage &particles = particleContainer.getStorage();
+    header.numParticles = particles.size();
+
+    const std::string temporaryName = filename + ".tmp";
+    {
+        std::ofstream file(temporaryName, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Could not open " + temporaryName + " for writing");
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        writeArray(file, typeParameters);
+        for (auto array: doubleArrays) {
+            writeArray(file, particles.*array);
+        }
+        writeArray(file, particles.type);
+        writeArray(file, particles.id);
+        if (!file.flush()) {
+            throw std::runtime_error("Could not write checkpoint " + temporaryName);
+        }
+    }
+    if (std::rename(temporaryName.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Could not rename " + temporaryName + " to " + filename);
+    }
+    SPDLOG_INFO("Checkpoint of iteration {} written to {}", state.iteration, filename);
+}
+
+SimulationState Checkpoint::read(const std::string &filename,
+                                 std::unique_ptr<ParticleContainers::ParticleContainer> &particleContainer,
+                                 std::unique_ptr<BoundaryHandler> &boundaryHandler, Calculators::Calculator &calculator) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Could not open checkpoint " + filename);
+    }
+    std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+        throw std::runtime_error("Could not read checkpoint " + filename);
+    }
+
+    size_t position = 0;
+    CheckpointHeader header{};
+    readBytes(buffer, position, &header, sizeof(header));
+    if (std::memcmp(header.magic, checkpointMagic, sizeof(checkpointMagic)) != 0) {
+        throw std::runtime_error(filename + " is not a checkpoint");
+    }
+    if (header.byteOrder != byteOrderMark) {
+        throw std::runtime_error("Checkpoint " + filename + " was written on a machine with a different byte order");
+    }
+    if (header.version != version) {
+        throw std::runtime_error("Checkpoint " + filename + " has version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(version));
+    }
+    // the file has room for 64 bit iterations, the simulation loop counts them in an int
+    if (header.iteration < 0 || header.iteration > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Checkpoint " + filename + " is at iteration " + std::to_string(header.iteration) +
+                                 ", which is outside of the supported range 0 to " +
+                                 std::to_string(std::numeric_limits<int>::max()));
+    }
+    header.calculator[sizeof(header.calculator) - 1] = '\0';
+    if (calculator.toString() != header.calculator) {
+        SPDLOG_WARN("Checkpoint was written with the {} calculator, continuing with {}", header.calculator,
+                    calculator.toString());
+    }
+
+    // check the counts against the file size before allocating, divisions keep huge counts from overflowing
+    const size_t bytesPerType = 2 * sizeof(double);
+    const size_t bytesPerParticle = std::size(doubleArrays) * sizeof(double) + sizeof(int32_t) + sizeof(int64_t);
+    const size_t remaining = buffer.size() - position;
+    if (header.numTypes > remaining / bytesPerType ||
+        header.numParticles > (remaining - header.numTypes * bytesPerType) / bytesPerParticle) {
+        throw std::runtime_error("Checkpoint is truncated");
+    }
+
+    std::vector<double> typeParameters(2 * header.numTypes);
+    readBytes(buffer, position, typeParameters.data(), typeParameters.size() * sizeof(double));
+    if (Calculators::LennardJonesMixingTable *mixingTable = calculator.getLennardJonesParameters()) {
+        for (size_t type = 0; type < header.numTypes; ++type) {
+            mixingTable->setTypeParameters(static_cast<int>(type), typeParameters[2 * type], typeParameters[2 * type + 1]);
+        }
+    }
+
+    ParticleStorage particles;
+    particles.resize(header.numParticles);
+    for (auto array: doubleArrays) {
+        readBytes(buffer, position, (particles.*array).data(), header.numParticles * sizeof(double));
+    }
+    readBytes(buffer, position, particles.type.data(), header.numParticles * sizeof(int32_t));
+    readBytes(buffer, position, particles.id.data(), header.numParticles * sizeof(int64_t));
+
+    boundaryHandler.reset();
+    switch (header.containerType) {
+        case DIRECT_SUM:
+            particleContainer = std::make_unique<ParticleContainers::DirectSumContainer>();
+            particleContainer->getStorage() = std::move(particles);
+            break;
+        case LINKED_CELL: {
+            auto lcCont = std::make_unique<ParticleContainers::LinkedCellContainer>(
+                    std::array<double, 3>{header.domainSize[0], header.domainSize[1], header.domainSize[2]},
+                    header.cutoff, header.skin, header.rebuildFrequency, header.cellSizeFactor);
+            lcCont->getStorage() = std::move(particles);
+            // the particles were stored sorted by cell, so the sort keeps their order
+            lcCont->updateParticlesInCell();
+            if (header.hasBoundaryHandler) {
+                std::array<BoundaryCondition, 6> conditions{};
+                for (size_t i = 0; i < conditions.size(); ++i) {
+                    if (header.boundaryConditions[i] > static_cast<uint8_t>(BoundaryCondition::PERIODIC)) {
+                        throw std::runtime_error("Checkpoint " + filename + " has an unknown boundary condition");
+                    }
+                    conditions[i] = static_cast<BoundaryCondition>(header.boundaryConditions[i]);
+                }
+                boundaryHandler = std::make_unique<BoundaryHandler>(1, conditions, *lcCont);
+                if (calculator.getLennardJonesParameters() != nullptr) {
+                    boundaryHandler->setMixingTable(*calculator.getLennardJonesParameters());
+                }
+            }
+            particleContainer = std::move(lcCont);
+            break;
+        }
+        case BARNES_HUT:
+            particleContainer = std::make_unique<ParticleContainers::BarnesHutContainer>(header.theta);
+            particleContainer->getStorage() = std::move(particles);
+            break;
+        default:
+            throw std::runtime_error("Checkpoint " + filename + " has an unknown container type");
+    }
+
+    SPDLOG_INFO("Continuing from iteration {} at time {} with {} particles", header.iteration, header.time,
+                header.numParticles);
+    return {header.time, static_cast<int>(header.iteration), header.deltaT};
+}
@@ -0,0 +1,68 @@
+//
+// Checkpoint.h
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Calculator/Calculator.h"
+#include "Objects/Containers/ParticleContainer.h"
+#include "Objects/Containers/LinkedCell/BoundaryHandler.h"
+
+/**
+ * @brief progress of a simulation, together with the particles everything that is needed to continue it
+ */
+struct SimulationState {
+    /** simulated time */
+    double time = 0.;
+    /** number of finished iterations */
+    int iteration = 0;
+    /** time step */
+    double deltaT = 0.;
+};
+
+/**
+ * @brief Writes and reads the complete state of a simulation in a compact binary format.
+ *
+ * A checkpoint starts with a versioned header that describes the container (type, domain size, cutoff, skin,
+ * cell size factor, theta), the boundary conditions and the simulation state, followed by the Lennard-Jones parameters of every
+ * particle type and the raw particle arrays. All values are stored in the byte order of the writing machine.
+ * Continuing from a checkpoint gives bit-identical results to a run that was not interrupted, except with
+ * Verlet lists, whose pairs may be summed in a different order after the restart.
+ */
+class Checkpoint {
+public:
+    /** format version, increased whenever the layout changes */
+    static constexpr uint32_t version = 3;
+
+    /**
+     * @brief writes a checkpoint. The file is written next to filename and renamed, so an existing checkpoint is
+     * only replaced by a complete one.
+     * @param filename path of the checkpoint
+     * @param particleContainer the particles and the container configuration
+     * @param boundaryHandler boundary conditions of the container, may be nullptr
+     * @param calculator the calculator of the simulation, its Lennard-Jones parameters are stored
+     * @param state progress of the simulation
+     * @throws std::runtime_error if the file could not be written
+     */
+    static void write(const std::string &filename, ParticleContainers::ParticleContainer &particleContainer,
+                      const BoundaryHandler *boundaryHandler, Calculators::Calculator &calculator,
+                      const SimulationState &state);
+
+    /**
+     * @brief reads a checkpoint with a single bulk read and recreates container and boundary handler
+     * @param filename path of the checkpoint
+     * @param particleContainer replaced by a container of the stored type that holds the stored particles
+     * @param boundaryHandler replaced by the stored boundary handler or reset if there was none
+     * @param calculator receives the stored Lennard-Jones parameters if it uses them
+     * @return progress of the simulation when the checkpoint was written
+     * @throws std::runtime_error if the file could not be read, is not a valid checkpoint or its iteration does not
+     * fit into SimulationState::iteration
+     */
+    static SimulationState read(const std::string &filename,
+                                std::unique_ptr<ParticleContainers::ParticleContainer> &particleContainer,
+                                std::unique_ptr<BoundaryHandler> &boundaryHandler, Calculators::Calculator &calculator);
+};
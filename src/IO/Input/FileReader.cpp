@@ -7,14 +7,28 @@
 
 #include "FileReader.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "spdlog/spdlog.h"
 #include "Objects/Cuboid.h"
 #include "Objects/Disc.h"
 #include "Objects/ParticleGenerator.h"
+#include "Objects/ParticleIdInitializer.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 FileReader::FileReader() = default;
 
 FileReader::~FileReader() = default;
@@ -22,6 +36,11 @@ FileReader::~FileReader() = default;
 void FileReader::readFile(ParticleContainers::ParticleContainer &particles, const std::string& filename) {
     SPDLOG_DEBUG("reading file {}", filename);
 
+    if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0) {
+        particles.addParticles(readBinaryParticles(filename));
+        return;
+    }
+
     std::ifstream input_file(filename);
 
     if (input_file.is_open()) {
@@ -39,7 +58,8 @@ void FileReader::readFile(ParticleContainers::ParticleContainer &particles, cons
         // based on object type call respective function
         switch(objectType) {
             case 0:
-                readParticles(particles, input_file);
+                input_file.close();
+                particles.addParticles(readParticlesMapped(filename));
                 break;
             case 1:
                 readCuboids(particles, input_file);
@@ -55,42 +75,6 @@ void FileReader::readFile(ParticleContainers::ParticleContainer &particles, cons
 }
 
 
-void FileReader::readParticles(ParticleContainers::ParticleContainer &particles, std::ifstream &input_file) {
-    SPDLOG_DEBUG("reading particles from file");
-    std::array<double, 3> x;
-    std::array<double, 3> v;
-    double m;
-    int num_particles = 0;
-    std::string tmp_string;
-    getline(input_file, tmp_string);
-    SPDLOG_DEBUG("Read line: {}", tmp_string);
-    std::istringstream numstream(tmp_string);
-    numstream >> num_particles;
-    SPDLOG_DEBUG("Reading {}.", num_particles);
-    getline(input_file, tmp_string);
-    SPDLOG_DEBUG("Read line: {}", tmp_string);
-
-    for (int i = 0; i < num_particles; i++) {
-        std::istringstream datastream(tmp_string);
-
-        for (auto &xj: x) {
-            datastream >> xj;
-        }
-        for (auto &vj: v) {
-            datastream >> vj;
-        }
-        datastream >> m;
-        if (datastream.fail()) {
-            SPDLOG_ERROR("Error reading file: unexpected data format");
-            exit(-1);
-        }
-        particles.addParticle(Particle(x, v, m));
-
-        getline(input_file, tmp_string);
-        SPDLOG_DEBUG("Read line: {}", tmp_string);
-    }
-}
-
 void FileReader::readCuboids(ParticleContainers::ParticleContainer &particles, std::ifstream &input_file) {
     SPDLOG_DEBUG("reading cuboids from file");
     // define all Cuboid parameters
@@ -112,6 +96,8 @@ void FileReader::readCuboids(ParticleContainers::ParticleContainer &particles, s
     // save the number of cuboids
     numstream >> num_cuboids;
     SPDLOG_DEBUG("Reading {}.", num_cuboids);
+    // the particles of all cuboids are added to the container at once
+    ParticleStorage newParticles;
     // get the second line of data, which has the parameters of the first cuboid
     getline(input_file, tmp_string);
     SPDLOG_DEBUG("Read line: {}", tmp_string);
@@ -144,11 +130,12 @@ void FileReader::readCuboids(ParticleContainers::ParticleContainer &particles, s
         Cuboid cuboid(x, N, h, m, v, mv);
         SPDLOG_DEBUG("Cuboid created!: ");
         // generates the particles in the cuboid
-        ParticleGenerator::generateCuboid(particles,cuboid);
+        ParticleGenerator::generateCuboid(newParticles, cuboid, i);
         // read another line (if more cuboids follow)
         getline(input_file, tmp_string);
         SPDLOG_DEBUG("Read line: {}", tmp_string);
     }
+    particles.addParticles(newParticles);
 }
 void FileReader::readDiscs(ParticleContainers::ParticleContainer &particles, std::ifstream &input_file) {
     SPDLOG_DEBUG("reading discs from file");
@@ -170,6 +157,8 @@ void FileReader::readDiscs(ParticleContainers::ParticleContainer &particles, std
     // save the number of cuboids
     numstream >> numDiscs;
     SPDLOG_DEBUG("Reading {}.", numDiscs);
+    // the particles of all discs are added to the container at once
+    ParticleStorage newParticles;
     // get the second line of data, which has the parameters of the first disc
     getline(input_file, tmp_string);
     SPDLOG_DEBUG("Read line: {}", tmp_string);
@@ -198,9 +187,262 @@ void FileReader::readDiscs(ParticleContainers::ParticleContainer &particles, std
        Disc disc(centerCoord, initVel, radius, h, m);
         SPDLOG_DEBUG("Disc created!: ");
         // generates the particles in the disc
-        ParticleGenerator::generateDisc(particles,disc);
+        ParticleGenerator::generateDisc(newParticles,disc);
         // read another line (if more discs follow)
         getline(input_file, tmp_string);
         SPDLOG_DEBUG("Read line: {}", tmp_string);
     }
+    particles.addParticles(newParticles);
+}
+
+namespace {
+    const char binaryParticlesMagic[8] = {'M', 'O', 'L', 'S', 'I', 'M', 'P', 'T'};
+    const uint32_t binaryParticlesVersion = 1;
+    const uint32_t byteOrderMark = 0x01020304;
+
+    /**
+     * @brief read-only memory mapping of a whole file
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string &filename) {
+            const int descriptor = open(filename.c_str(), O_RDONLY);
+            if (descriptor < 0) {
+                throw std::runtime_error("Could not open " + filename);
+            }
+            struct stat status{};
+            if (fstat(descriptor, &status) != 0) {
+                close(descriptor);
+                throw std::runtime_error("Could not read the size of " + filename);
+            }
+            length = static_cast<size_t>(status.st_size);
+            if (length > 0) {
+                void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (mapping == MAP_FAILED) {
+                    close(descriptor);
+                    throw std::runtime_error("Could not map " + filename + " into memory");
+                }
+                madvise(mapping, length, MADV_SEQUENTIAL);
+                data = static_cast<const char *>(mapping);
+            }
+            close(descriptor);
+        }
+
+        ~MappedFile() {
+            if (data != nullptr) {
+                munmap(const_cast<char *>(data), length);
+            }
+        }
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const char *begin() const { return data; }
+
+        const char *end() const { return data + length; }
+
+        size_t size() const { return length; }
+
+    private:
+        const char *data = nullptr;
+        size_t length = 0;
+    };
+
+    /**
+     * @brief moves position behind the next line break
+     * @return the line without the line break
+     */
+    std::string_view nextLine(const char *&position, const char *end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(position, '\n', end - position));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        std::string_view line(position, lineEnd - position);
+        position = lineEnd == end ? end : lineEnd + 1;
+        return line;
+    }
+
+    /**
+     * @brief parses the next number of a line, skipping leading blanks
+     * @return false if there is no number
+     */
+    template<typename T>
+    bool parseNumber(const char *&position, const char *end, T &value) {
+        while (position != end && (*position == ' ' || *position == '\t' || *position == '\r')) {
+            ++position;
+        }
+        const std::from_chars_result result = std::from_chars(position, end, value);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        position = result.ptr;
+        return true;
+    }
+
+    /**
+     * @return number of lines starting in [begin, end), the last line of the file may miss its line break
+     */
+    size_t countLines(const char *begin, const char *end, const char *fileEnd) {
+        size_t lines = std::count(begin, end, '\n');
+        if (end == fileEnd && begin != end && end[-1] != '\n') {
+            ++lines;
+        }
+        return lines;
+    }
+}
+
+ParticleStorage FileReader::readParticlesMapped(const std::string &filename) {
+    MappedFile file(filename);
+    const char *position = file.begin();
+    const char *const end = file.end();
+
+    // header: comments, the object type and the number of particles
+    std::string_view line;
+    do {
+        if (position == end) {
+            SPDLOG_ERROR("Error reading file: {} contains no particles", filename);
+            throw std::invalid_argument("Input file contains no particles.");
+        }
+        line = nextLine(position, end);
+    } while (line.empty() || line[0] == '#');
+    const char *field = line.data();
+    int objectType = -1;
+    size_t numParticles = 0;
+    if (!parseNumber(field, line.data() + line.size(), objectType) || objectType != 0) {
+        SPDLOG_ERROR("Error reading file: {} is not a particle file", filename);
+        throw std::invalid_argument("Input file is not a particle file.");
+    }
+    line = nextLine(position, end);
+    field = line.data();
+    if (!parseNumber(field, line.data() + line.size(), numParticles)) {
+        SPDLOG_ERROR("Error reading file: unexpected data format");
+        throw std::invalid_argument("Number of particles is missing.");
+    }
+    SPDLOG_DEBUG("Reading {} particles.", numParticles);
+
+    // split the remaining lines into chunks that start at a line
+    const char *const body = position;
+    const size_t bodySize = end - body;
+    const size_t minChunkSize = 1 << 16;
+#ifdef _OPENMP
+    const size_t numThreads = omp_get_max_threads();
+#else
+    const size_t numThreads = 1;
+#endif
+    const size_t numChunks = std::max<size_t>(1, std::min(4 * numThreads, bodySize / minChunkSize));
+    std::vector<const char *> chunkBegins(numChunks + 1, end);
+    chunkBegins[0] = body;
+    for (size_t c = 1; c < numChunks; ++c) {
+        const char *split = std::max(body + c * (bodySize / numChunks), chunkBegins[c - 1]);
+        const char *lineBreak = static_cast<const char *>(std::memchr(split, '\n', end - split));
+        chunkBegins[c] = lineBreak == nullptr ? end : lineBreak + 1;
+    }
+
+    // the index of the first particle of every chunk
+    std::vector<size_t> firstLines(numChunks + 1, 0);
+#pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < numChunks; ++c) {
+        firstLines[c + 1] = countLines(chunkBegins[c], chunkBegins[c + 1], end);
+    }
+    for (size_t c = 0; c < numChunks; ++c) {
+        firstLines[c + 1] += firstLines[c];
+    }
+    if (firstLines[numChunks] < numParticles) {
+        SPDLOG_ERROR("Error reading file: expected {} particles, but found {} lines", numParticles, firstLines[numChunks]);
+        throw std::invalid_argument("Input file contains less particles than specified.");
+    }
+
+    ParticleStorage particles;
+    particles.resize(numParticles);
+    double *const values[7] = {particles.x.data(), particles.y.data(), particles.z.data(),
+                               particles.vx.data(), particles.vy.data(), particles.vz.data(), particles.m.data()};
+    size_t firstInvalid = numParticles;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t c = 0; c < numChunks; ++c) {
+        const char *linePosition = chunkBegins[c];
+        for (size_t index = firstLines[c]; index < std::min(firstLines[c + 1], numParticles); ++index) {
+            const std::string_view particleLine = nextLine(linePosition, chunkBegins[c + 1]);
+            const char *number = particleLine.data();
+            const char *const lineEnd = particleLine.data() + particleLine.size();
+            for (double *value: values) {
+                if (!parseNumber(number, lineEnd, value[index])) {
+#pragma omp critical
+                    firstInvalid = std::min(firstInvalid, index);
+                    break;
+                }
+            }
+        }
+    }
+    if (firstInvalid != numParticles) {
+        SPDLOG_ERROR("Error reading file: unexpected data format in particle {}", firstInvalid + 1);
+        throw std::invalid_argument("Unexpected data format.");
+    }
+
+    const ParticleId firstId = ParticleIdInitializer::reserveRange(numParticles);
+    for (size_t i = 0; i < numParticles; ++i) {
+        particles.id[i] = firstId + static_cast<ParticleId>(i);
+    }
+    return particles;
+}
+
+ParticleStorage FileReader::readBinaryParticles(const std::string &filename) {
+    MappedFile file(filename);
+    struct {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t numParticles;
+    } header{};
+    if (file.size() < sizeof(header)) {
+        throw std::invalid_argument(filename + " is not a binary particle file.");
+    }
+    std::memcpy(&header, file.begin(), sizeof(header));
+    if (std::memcmp(header.magic, binaryParticlesMagic, sizeof(binaryParticlesMagic)) != 0 ||
+        header.version != binaryParticlesVersion || header.byteOrder != byteOrderMark) {
+        SPDLOG_ERROR("{} is not a binary particle file of version {} in the byte order of this machine", filename,
+                     binaryParticlesVersion);
+        throw std::invalid_argument(filename + " is not a binary particle file.");
+    }
+    const size_t numParticles = header.numParticles;
+    if ((file.size() - sizeof(header)) / (7 * sizeof(double) + sizeof(int32_t)) < numParticles) {
+        throw std::invalid_argument(filename + " is truncated.");
+    }
+
+    ParticleStorage particles;
+    particles.resize(numParticles);
+    const char *position = file.begin() + sizeof(header);
+    for (std::vector<double> *array: {&particles.x, &particles.y, &particles.z, &particles.vx, &particles.vy,
+                                      &particles.vz, &particles.m}) {
+        std::memcpy(array->data(), position, numParticles * sizeof(double));
+        position += numParticles * sizeof(double);
+    }
+    static_assert(sizeof(int) == sizeof(int32_t), "types are stored as int32");
+    std::memcpy(particles.type.data(), position, numParticles * sizeof(int32_t));
+
+    const ParticleId firstId = ParticleIdInitializer::reserveRange(numParticles);
+    for (size_t i = 0; i < numParticles; ++i) {
+        particles.id[i] = firstId + static_cast<ParticleId>(i);
+    }
+    return particles;
+}
+
+void FileReader::writeBinaryParticles(const ParticleStorage &particles, const std::string &filename) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Could not open " + filename + " for writing");
+    }
+    const uint64_t numParticles = particles.size();
+    file.write(binaryParticlesMagic, sizeof(binaryParticlesMagic));
+    file.write(reinterpret_cast<const char *>(&binaryParticlesVersion), sizeof(binaryParticlesVersion));
+    file.write(reinterpret_cast<const char *>(&byteOrderMark), sizeof(byteOrderMark));
+    file.write(reinterpret_cast<const char *>(&numParticles), sizeof(numParticles));
+    for (const std::vector<double> *array: {&particles.x, &particles.y, &particles.z, &particles.vx, &particles.vy,
+                                            &particles.vz, &particles.m}) {
+        file.write(reinterpret_cast<const char *>(array->data()), static_cast<std::streamsize>(numParticles * sizeof(double)));
+    }
+    file.write(reinterpret_cast<const char *>(particles.type.data()), static_cast<std::streamsize>(numParticles * sizeof(int32_t)));
+    if (!file.flush()) {
+        throw std::runtime_error("Could not write " + filename);
+    }
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Objects/Particle.h"
+#include "Objects/ParticleStorage.h"
 
 #include <list>
 
@@ -19,14 +20,36 @@ public:
   FileReader();
   virtual ~FileReader();
 
+/**Initializes a ParticleContainer with the particles, cuboids or discs of a text file or with the particles of a
+ * binary particle file (ending with .bin)
+ * @param particles: the particle container
+ * @param filename: path to input file
+ */
   static void readFile(ParticleContainers::ParticleContainer &particles, const std::string& filename);
 
-  
-/**Initializes a ParticleContainer with input Particles data from a file
- * @param particles: the empty particle container
+/**Reads a text file of particles (object type 0). The file is mapped into memory and its lines are parsed
+ * in parallel chunks, the particles are returned in the order of the file.
+ * @param filename: path to input file
+ * @returns the particles with new ids
+ */
+  static ParticleStorage readParticlesMapped(const std::string &filename);
+
+/**Reads a binary particle file. The file starts with the magic bytes "MOLSIMPT", the format version (uint32, 1),
+ * the byte order mark 0x01020304 (uint32) and the number of particles (uint64), followed by the arrays
+ * x, y, z, vx, vy, vz, m (double) and type (int32) of all particles, every value in the byte order of the machine.
+ * The arrays are copied into the storage without any parsing.
  * @param filename: path to input file
-*/
-  static void readParticles(ParticleContainers::ParticleContainer &particles, std::ifstream &input_file);
+ * @returns the particles with new ids
+ */
+  static ParticleStorage readBinaryParticles(const std::string &filename);
+
+/**Writes particles in the binary particle format read by readBinaryParticles
+ * @param particles: the particles to be written
+ * @param filename: path to output file
+ */
+  static void writeBinaryParticles(const ParticleStorage &particles, const std::string &filename);
+
+
  /**Initializes a ParticleContainer with input Cuboids data from a file
  * @param particles: the empty particle container
  * @param input_file: stream of file data
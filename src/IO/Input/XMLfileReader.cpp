@@ -9,7 +9,34 @@
 #include "schema.h"
 #include "spdlog/spdlog.h"
 
-
+namespace {
+    /**
+     * Reads the optional type, epsilon and sigma of a shape and registers the parameters of the type
+     * @param shape particle, cuboid or disc from the xml file
+     * @param calculator the calculator of the simulation
+     * @return the type of the particles of the shape
+     */
+    template <class Shape>
+    int readTypeParameters(const Shape &shape, Calculators::Calculator &calculator) {
+        int type = shape.type().present() ? shape.type().get() : 0;
+        if (type < 0) {
+            SPDLOG_ERROR("Invalid type, types should not be negative!, using type 0");
+            type = 0;
+        }
+        if (shape.epsilon().present() || shape.sigma().present()) {
+            Calculators::LennardJonesMixingTable *mixingTable = calculator.getLennardJonesParameters();
+            if (mixingTable == nullptr) {
+                SPDLOG_WARN("epsilon and sigma are only used by the Lennard-Jones calculators");
+                return type;
+            }
+            double epsilon = shape.epsilon().present() ? shape.epsilon().get() : mixingTable->getEpsilon(type);
+            double sigma = shape.sigma().present() ? shape.sigma().get() : mixingTable->getSigma(type);
+            mixingTable->setTypeParameters(type, epsilon, sigma);
+            SPDLOG_DEBUG("type {} has epsilon {} and sigma {}", type, epsilon, sigma);
+        }
+        return type;
+    }
+}
 
 int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, double &endTime, int &freq,
                                      std::unique_ptr<outputWriters::OutputWriter> &outputWriter,
@@ -50,18 +77,69 @@ int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, do
                     domainSizeArray[1] = sim->container().domainSize().get().y();
                     domainSizeArray[2] = sim->container().domainSize().get().z();
                 }
-                particleContainer = std::make_unique<ParticleContainers::LinkedCellContainer>(domainSizeArray, cutoffRadius);
-                if(sim -> container().BoundaryType().present()) {
-                   std::array<bool, 6> condition;
-                    condition[0] = sim ->container().BoundaryType().get().x();
-                    condition[1] = sim ->container().BoundaryType().get().y();
-                    condition[2] = sim ->container().BoundaryType().get().z();
-                    condition[3] = sim ->container().BoundaryType().get().l();
-                    condition[4] = sim ->container().BoundaryType().get().m();
-                    condition[5] = sim ->container().BoundaryType().get().k();
+                double skin = 0.;
+                if(sim-> container().skin().present()) {
+                    skin = sim-> container().skin().get();
+                    if (skin < 0) {
+                        SPDLOG_ERROR("Invalid skin, skin should not be negative!, Verlet list is disabled");
+                        skin = 0.;
+                    }
+                }
+                int rebuildFrequency = 0;
+                if(sim-> container().rebuildFrequency().present()) {
+                    rebuildFrequency = sim-> container().rebuildFrequency().get();
+                    if (rebuildFrequency < 0) {
+                        SPDLOG_ERROR("Invalid rebuild frequency, rebuild frequency should not be negative!, using default value");
+                        rebuildFrequency = 0;
+                    }
+                }
+                double cellSizeFactor = 1.;
+                if(sim-> container().cellSizeFactor().present()) {
+                    cellSizeFactor = sim-> container().cellSizeFactor().get();
+                    if (cellSizeFactor <= 0 || cellSizeFactor > 1) {
+                        SPDLOG_ERROR("Invalid cell size factor, cell size factor should be in (0, 1]!, using default value");
+                        cellSizeFactor = 1.;
+                    }
+                }
+                particleContainer = std::make_unique<ParticleContainers::LinkedCellContainer>(domainSizeArray, cutoffRadius,
+                                                                                              skin, rebuildFrequency,
+                                                                                              cellSizeFactor);
+                if(sim -> container().BoundaryType().present() || sim -> container().periodicBoundaries().present()) {
+                    std::array<BoundaryCondition, 6> condition;
+                    condition.fill(BoundaryCondition::OUTFLOW);
+                    if(sim -> container().BoundaryType().present()) {
+                        const BoolVector &reflecting = sim ->container().BoundaryType().get();
+                        const std::array<bool, 6> isReflecting = {reflecting.x(), reflecting.y(), reflecting.z(),
+                                                                  reflecting.l(), reflecting.m(), reflecting.k()};
+                        for (size_t i = 0; i < condition.size(); i++) {
+                            condition[i] = isReflecting[i] ? BoundaryCondition::REFLECTING : BoundaryCondition::OUTFLOW;
+                        }
+                    }
+                    //periodic boundaries override the condition of BoundaryType
+                    if(sim -> container().periodicBoundaries().present()) {
+                        const BoolVector &periodic = sim ->container().periodicBoundaries().get();
+                        const std::array<bool, 6> isPeriodic = {periodic.x(), periodic.y(), periodic.z(),
+                                                                periodic.l(), periodic.m(), periodic.k()};
+                        for (size_t i = 0; i < condition.size(); i++) {
+                            if (isPeriodic[i]) {
+                                condition[i] = BoundaryCondition::PERIODIC;
+                            }
+                        }
+                    }
                     boundaryHandler = std::make_unique<BoundaryHandler>(1, condition , *(dynamic_cast <ParticleContainers::LinkedCellContainer*>(&(*particleContainer))));
                 }
 
+            } else if(sim-> container().containerType() == "BH") {
+                SPDLOG_DEBUG("BH selected from xml file");
+                double theta = 0.5;
+                if(sim-> container().theta().present()) {
+                    theta = sim-> container().theta().get();
+                    if (theta < 0) {
+                        SPDLOG_ERROR("Invalid theta, theta should not be negative!, using default value");
+                        theta = 0.5;
+                    }
+                }
+                particleContainer = std::make_unique<ParticleContainers::BarnesHutContainer>(theta);
             }
             else {
                 SPDLOG_ERROR("Invalid container type!");
@@ -91,6 +169,16 @@ int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, do
                     SPDLOG_DEBUG("vtk is selected from xml as the output writer");
                     outputWriter = std::make_unique<outputWriters::VTKWriter>();
                 }
+                else if(output == "VTK-RAW")
+                {
+                    SPDLOG_DEBUG("binary vtk is selected from xml as the output writer");
+                    outputWriter = std::make_unique<outputWriters::VTKBinaryWriter>(outputWriters::VTKBinaryWriter::Encoding::RAW);
+                }
+                else if(output == "VTK-BASE64")
+                {
+                    SPDLOG_DEBUG("base64 vtk is selected from xml as the output writer");
+                    outputWriter = std::make_unique<outputWriters::VTKBinaryWriter>(outputWriters::VTKBinaryWriter::Encoding::BASE64);
+                }
                 else if(output == "XYZ")
                 {
                     outputWriter = std::make_unique<outputWriters::XYZWriter>();
@@ -108,15 +196,49 @@ int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, do
                     calculator = std::make_unique<Calculators::LennardJonesCalculator>();
                     SPDLOG_DEBUG("LJC is selected from xml");
                 }
+                else if (calculatorType == "LJC-SIMD")
+                {
+                    calculator = std::make_unique<Calculators::LennardJonesSIMDCalculator>();
+                    SPDLOG_DEBUG("LJC-SIMD is selected from xml");
+                }
                 else if (calculatorType == "Default")
                 {
                     calculator = std::make_unique<Calculators::GravityCalculator>();
                     SPDLOG_DEBUG("Default calculator is selected from xml");
+                }
+                else if (calculatorType == "TAB")
+                {
+                    // the potential is truncated at the cutoff radius of the container, 3 if none is given
+                    double cutoffRadius = sim->container().cutoffRadius().present() ? sim->container().cutoffRadius().get() : 3.0;
+                    std::string potential = sim->calculator().potential().present() ? std::string(sim->calculator().potential().get()) : "LJ";
+                    int tableSize = static_cast<int>(Calculators::TabulatedPotential::defaultTableSize);
+                    if (sim->calculator().tableSize().present()) {
+                        tableSize = sim->calculator().tableSize().get();
+                    }
+                    if (tableSize <= 0) {
+                        SPDLOG_ERROR("The table size of the potential has to be positive");
+                        return 1;
+                    }
+                    try {
+                        calculator = std::make_unique<Calculators::TabulatedCalculator>(
+                            Calculators::TabulatedPotential::fromSpecification(potential, cutoffRadius, tableSize));
+                    } catch (const std::invalid_argument &) {
+                        return 1;
+                    }
+                    SPDLOG_DEBUG("TAB is selected from xml");
                 } else {
                     SPDLOG_ERROR("Erroneous programme call! Invalid calculator specified! Using default value/value from flag");
                     return 1;
                 }
             }
+            if (dynamic_cast<ParticleContainers::BarnesHutContainer *>(particleContainer.get()) != nullptr &&
+                dynamic_cast<Calculators::GravityCalculator *>(calculator.get()) == nullptr) {
+                SPDLOG_ERROR("The Barnes-Hut container can only be used with the Default calculator");
+                return 1;
+            }
+            // all particles, cuboids and discs are collected and added to the container at once
+            ParticleStorage newParticles;
+            newParticles.reserve(sim->shapes().particle().size());
             for (int i=0; i < (int) sim->shapes().particle().size(); i++) {
                 SPDLOG_DEBUG("reading particles from xml file");
                 // define all particle parameters
@@ -129,8 +251,9 @@ int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, do
                 v[1] = sim->shapes().particle().at(i).velocity().y();
                 v[2] = sim->shapes().particle().at(i).velocity().z();
                 double m = sim->shapes().particle().at(i).mass();
-                Particle newParticle(x,v,m,0);
-                (particleContainer) -> addParticle(newParticle);
+                int type = readTypeParameters(sim->shapes().particle().at(i), *calculator);
+                Particle newParticle(x,v,m,type);
+                newParticles.push_back(newParticle);
             }
             for (int i=0; i < (int) sim->shapes().cuboid().size();i++){
                 SPDLOG_DEBUG("reading cuboids from xml file");
@@ -150,8 +273,9 @@ int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, do
                 double h = sim->shapes().cuboid().at(i).distance();
                 double m = sim->shapes().cuboid().at(i).mass();
                 double mv = sim->shapes().cuboid().at(i).meanVelocity();
-                Cuboid cuboid(x,N,h,m,v,mv);
-                ParticleGenerator::generateCuboid(*particleContainer, cuboid);
+                int type = readTypeParameters(sim->shapes().cuboid().at(i), *calculator);
+                Cuboid cuboid(x,N,h,m,v,mv,type);
+                ParticleGenerator::generateCuboid(newParticles, cuboid, i);
             }
             for (int i=0; i < (int) sim->shapes().disc().size();i++){
                 SPDLOG_DEBUG("reading discs from xml file");
@@ -167,9 +291,15 @@ int XMLfileReader::parseXMLFromFile(std::ifstream& fileStream,double &deltaT, do
                 double h = sim->shapes().disc().at(i).distance();
                 double m = sim->shapes().disc().at(i).mass();
                 double radius = sim->shapes().disc().at(i).radius();
+                int type = readTypeParameters(sim->shapes().disc().at(i), *calculator);
 
-                Disc disc(x,v,radius,h,m);
-                ParticleGenerator::generateDisc(*particleContainer, disc);
+                Disc disc(x,v,radius,h,m,type);
+                ParticleGenerator::generateDisc(newParticles, disc);
+            }
+            particleContainer->addParticles(newParticles);
+            // reflecting boundaries repel the particles with the sigma and epsilon of their type
+            if (boundaryHandler != nullptr && calculator->getLennardJonesParameters() != nullptr) {
+                boundaryHandler->setMixingTable(*calculator->getLennardJonesParameters());
             }
 
 
@@ -8,10 +8,13 @@
 #include "Calculator/Calculator.h"
 #include "IO/Output/outputWriter/OutputWriter.h"
 #include "IO/Output/outputWriter/VTKWriter.h"
+#include "IO/Output/outputWriter/VTKBinaryWriter.h"
 #include "IO/Output/outputWriter/XYZWriter.h"
 #include "Calculator/Calculator.h"
 #include "Calculator/LennardJonesCalculator.h"
+#include "Calculator/LennardJonesSIMDCalculator.h"
 #include "Calculator/GravityCalculator.h"
+#include "Calculator/TabulatedCalculator.h"
 #include "Objects/Cuboid.h"
 #include "Objects/ParticleGenerator.h"
 #include <memory>
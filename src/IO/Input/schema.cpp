@@ -137,6 +137,60 @@ calculatorForce (::std::unique_ptr< calculatorForce_type > x)
   this->calculatorForce_.set (std::move (x));
 }
 
+const CalculatorType::potential_optional& CalculatorType::
+potential () const
+{
+  return this->potential_;
+}
+
+CalculatorType::potential_optional& CalculatorType::
+potential ()
+{
+  return this->potential_;
+}
+
+void CalculatorType::
+potential (const potential_type& x)
+{
+  this->potential_.set (x);
+}
+
+void CalculatorType::
+potential (const potential_optional& x)
+{
+  this->potential_ = x;
+}
+
+void CalculatorType::
+potential (::std::unique_ptr< potential_type > x)
+{
+  this->potential_.set (std::move (x));
+}
+
+const CalculatorType::tableSize_optional& CalculatorType::
+tableSize () const
+{
+  return this->tableSize_;
+}
+
+CalculatorType::tableSize_optional& CalculatorType::
+tableSize ()
+{
+  return this->tableSize_;
+}
+
+void CalculatorType::
+tableSize (const tableSize_type& x)
+{
+  this->tableSize_.set (x);
+}
+
+void CalculatorType::
+tableSize (const tableSize_optional& x)
+{
+  this->tableSize_ = x;
+}
+
 
 // ContainerType
 // 
@@ -250,6 +304,132 @@ BoundaryType (::std::unique_ptr< BoundaryType_type > x)
 }
 
 
+const ContainerType::skin_optional& ContainerType::
+skin () const
+{
+  return this->skin_;
+}
+
+ContainerType::skin_optional& ContainerType::
+skin ()
+{
+  return this->skin_;
+}
+
+void ContainerType::
+skin (const skin_type& x)
+{
+  this->skin_.set (x);
+}
+
+void ContainerType::
+skin (const skin_optional& x)
+{
+  this->skin_ = x;
+}
+
+const ContainerType::rebuildFrequency_optional& ContainerType::
+rebuildFrequency () const
+{
+  return this->rebuildFrequency_;
+}
+
+ContainerType::rebuildFrequency_optional& ContainerType::
+rebuildFrequency ()
+{
+  return this->rebuildFrequency_;
+}
+
+void ContainerType::
+rebuildFrequency (const rebuildFrequency_type& x)
+{
+  this->rebuildFrequency_.set (x);
+}
+
+void ContainerType::
+rebuildFrequency (const rebuildFrequency_optional& x)
+{
+  this->rebuildFrequency_ = x;
+}
+
+const ContainerType::theta_optional& ContainerType::
+theta () const
+{
+  return this->theta_;
+}
+
+ContainerType::theta_optional& ContainerType::
+theta ()
+{
+  return this->theta_;
+}
+
+void ContainerType::
+theta (const theta_type& x)
+{
+  this->theta_.set (x);
+}
+
+void ContainerType::
+theta (const theta_optional& x)
+{
+  this->theta_ = x;
+}
+
+const ContainerType::periodicBoundaries_optional& ContainerType::
+periodicBoundaries () const
+{
+  return this->periodicBoundaries_;
+}
+
+ContainerType::periodicBoundaries_optional& ContainerType::
+periodicBoundaries ()
+{
+  return this->periodicBoundaries_;
+}
+
+void ContainerType::
+periodicBoundaries (const periodicBoundaries_type& x)
+{
+  this->periodicBoundaries_.set (x);
+}
+
+void ContainerType::
+periodicBoundaries (const periodicBoundaries_optional& x)
+{
+  this->periodicBoundaries_ = x;
+}
+
+void ContainerType::
+periodicBoundaries (::std::unique_ptr< periodicBoundaries_type > x)
+{
+  this->periodicBoundaries_.set (std::move (x));
+}
+
+const ContainerType::cellSizeFactor_optional& ContainerType::
+cellSizeFactor () const
+{
+  return this->cellSizeFactor_;
+}
+
+ContainerType::cellSizeFactor_optional& ContainerType::
+cellSizeFactor ()
+{
+  return this->cellSizeFactor_;
+}
+
+void ContainerType::
+cellSizeFactor (const cellSizeFactor_type& x)
+{
+  this->cellSizeFactor_.set (x);
+}
+
+void ContainerType::
+cellSizeFactor (const cellSizeFactor_optional& x)
+{
+  this->cellSizeFactor_ = x;
+}
+
 // ParametersType
 // 
 
@@ -490,6 +670,78 @@ mass (const mass_type& x)
 }
 
 
+const CuboidType::type_optional& CuboidType::
+type () const
+{
+  return this->type_;
+}
+
+CuboidType::type_optional& CuboidType::
+type ()
+{
+  return this->type_;
+}
+
+void CuboidType::
+type (const type_type& x)
+{
+  this->type_.set (x);
+}
+
+void CuboidType::
+type (const type_optional& x)
+{
+  this->type_ = x;
+}
+
+const CuboidType::epsilon_optional& CuboidType::
+epsilon () const
+{
+  return this->epsilon_;
+}
+
+CuboidType::epsilon_optional& CuboidType::
+epsilon ()
+{
+  return this->epsilon_;
+}
+
+void CuboidType::
+epsilon (const epsilon_type& x)
+{
+  this->epsilon_.set (x);
+}
+
+void CuboidType::
+epsilon (const epsilon_optional& x)
+{
+  this->epsilon_ = x;
+}
+
+const CuboidType::sigma_optional& CuboidType::
+sigma () const
+{
+  return this->sigma_;
+}
+
+CuboidType::sigma_optional& CuboidType::
+sigma ()
+{
+  return this->sigma_;
+}
+
+void CuboidType::
+sigma (const sigma_type& x)
+{
+  this->sigma_.set (x);
+}
+
+void CuboidType::
+sigma (const sigma_optional& x)
+{
+  this->sigma_ = x;
+}
+
 // DiscType
 // 
 
@@ -596,6 +848,78 @@ mass (const mass_type& x)
 }
 
 
+const DiscType::type_optional& DiscType::
+type () const
+{
+  return this->type_;
+}
+
+DiscType::type_optional& DiscType::
+type ()
+{
+  return this->type_;
+}
+
+void DiscType::
+type (const type_type& x)
+{
+  this->type_.set (x);
+}
+
+void DiscType::
+type (const type_optional& x)
+{
+  this->type_ = x;
+}
+
+const DiscType::epsilon_optional& DiscType::
+epsilon () const
+{
+  return this->epsilon_;
+}
+
+DiscType::epsilon_optional& DiscType::
+epsilon ()
+{
+  return this->epsilon_;
+}
+
+void DiscType::
+epsilon (const epsilon_type& x)
+{
+  this->epsilon_.set (x);
+}
+
+void DiscType::
+epsilon (const epsilon_optional& x)
+{
+  this->epsilon_ = x;
+}
+
+const DiscType::sigma_optional& DiscType::
+sigma () const
+{
+  return this->sigma_;
+}
+
+DiscType::sigma_optional& DiscType::
+sigma ()
+{
+  return this->sigma_;
+}
+
+void DiscType::
+sigma (const sigma_type& x)
+{
+  this->sigma_.set (x);
+}
+
+void DiscType::
+sigma (const sigma_optional& x)
+{
+  this->sigma_ = x;
+}
+
 // ParticleType
 // 
 
@@ -666,6 +990,78 @@ mass (const mass_type& x)
 }
 
 
+const ParticleType::type_optional& ParticleType::
+type () const
+{
+  return this->type_;
+}
+
+ParticleType::type_optional& ParticleType::
+type ()
+{
+  return this->type_;
+}
+
+void ParticleType::
+type (const type_type& x)
+{
+  this->type_.set (x);
+}
+
+void ParticleType::
+type (const type_optional& x)
+{
+  this->type_ = x;
+}
+
+const ParticleType::epsilon_optional& ParticleType::
+epsilon () const
+{
+  return this->epsilon_;
+}
+
+ParticleType::epsilon_optional& ParticleType::
+epsilon ()
+{
+  return this->epsilon_;
+}
+
+void ParticleType::
+epsilon (const epsilon_type& x)
+{
+  this->epsilon_.set (x);
+}
+
+void ParticleType::
+epsilon (const epsilon_optional& x)
+{
+  this->epsilon_ = x;
+}
+
+const ParticleType::sigma_optional& ParticleType::
+sigma () const
+{
+  return this->sigma_;
+}
+
+ParticleType::sigma_optional& ParticleType::
+sigma ()
+{
+  return this->sigma_;
+}
+
+void ParticleType::
+sigma (const sigma_type& x)
+{
+  this->sigma_.set (x);
+}
+
+void ParticleType::
+sigma (const sigma_optional& x)
+{
+  this->sigma_ = x;
+}
+
 // DoubleVectorType
 // 
 
@@ -1126,7 +1522,9 @@ OutputType::
 CalculatorType::
 CalculatorType ()
 : ::xml_schema::type (),
-  calculatorForce_ (this)
+  calculatorForce_ (this),
+  potential_ (this),
+  tableSize_ (this)
 {
 }
 
@@ -1135,7 +1533,9 @@ CalculatorType (const CalculatorType& x,
                 ::xml_schema::flags f,
                 ::xml_schema::container* c)
 : ::xml_schema::type (x, f, c),
-  calculatorForce_ (x.calculatorForce_, f, this)
+  calculatorForce_ (x.calculatorForce_, f, this),
+  potential_ (x.potential_, f, this),
+  tableSize_ (x.tableSize_, f, this)
 {
 }
 
@@ -1144,7 +1544,9 @@ CalculatorType (const ::xercesc::DOMElement& e,
                 ::xml_schema::flags f,
                 ::xml_schema::container* c)
 : ::xml_schema::type (e, f | ::xml_schema::flags::base, c),
-  calculatorForce_ (this)
+  calculatorForce_ (this),
+  potential_ (this),
+  tableSize_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -1177,6 +1579,31 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // potential
+    //
+    if (n.name () == "potential" && n.namespace_ ().empty ())
+    {
+      ::std::unique_ptr< potential_type > r (
+        potential_traits::create (i, f, this));
+
+      if (!this->potential_)
+      {
+        this->potential_.set (::std::move (r));
+        continue;
+      }
+    }
+
+    // tableSize
+    //
+    if (n.name () == "tableSize" && n.namespace_ ().empty ())
+    {
+      if (!this->tableSize_)
+      {
+        this->tableSize_.set (tableSize_traits::create (i, f, this));
+        continue;
+      }
+    }
+
     break;
   }
 }
@@ -1195,6 +1622,8 @@ operator= (const CalculatorType& x)
   {
     static_cast< ::xml_schema::type& > (*this) = x;
     this->calculatorForce_ = x.calculatorForce_;
+    this->potential_ = x.potential_;
+    this->tableSize_ = x.tableSize_;
   }
 
   return *this;
@@ -1214,7 +1643,12 @@ ContainerType (const containerType_type& containerType)
   containerType_ (containerType, this),
   cutoffRadius_ (this),
   domainSize_ (this),
-  BoundaryType_ (this)
+  BoundaryType_ (this),
+  skin_ (this),
+  rebuildFrequency_ (this),
+  theta_ (this),
+  periodicBoundaries_ (this),
+  cellSizeFactor_ (this)
 {
 }
 
@@ -1226,7 +1660,12 @@ ContainerType (const ContainerType& x,
   containerType_ (x.containerType_, f, this),
   cutoffRadius_ (x.cutoffRadius_, f, this),
   domainSize_ (x.domainSize_, f, this),
-  BoundaryType_ (x.BoundaryType_, f, this)
+  BoundaryType_ (x.BoundaryType_, f, this),
+  skin_ (x.skin_, f, this),
+  rebuildFrequency_ (x.rebuildFrequency_, f, this),
+  theta_ (x.theta_, f, this),
+  periodicBoundaries_ (x.periodicBoundaries_, f, this),
+  cellSizeFactor_ (x.cellSizeFactor_, f, this)
 {
 }
 
@@ -1238,7 +1677,12 @@ ContainerType (const ::xercesc::DOMElement& e,
   containerType_ (this),
   cutoffRadius_ (this),
   domainSize_ (this),
-  BoundaryType_ (this)
+  BoundaryType_ (this),
+  skin_ (this),
+  rebuildFrequency_ (this),
+  theta_ (this),
+  periodicBoundaries_ (this),
+  cellSizeFactor_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -1310,6 +1754,64 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // skin
+    //
+    if (n.name () == "skin" && n.namespace_ ().empty ())
+    {
+      if (!this->skin_)
+      {
+        this->skin_.set (skin_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // rebuildFrequency
+    //
+    if (n.name () == "rebuildFrequency" && n.namespace_ ().empty ())
+    {
+      if (!this->rebuildFrequency_)
+      {
+        this->rebuildFrequency_.set (rebuildFrequency_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // theta
+    //
+    if (n.name () == "theta" && n.namespace_ ().empty ())
+    {
+      if (!this->theta_)
+      {
+        this->theta_.set (theta_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // periodicBoundaries
+    //
+    if (n.name () == "periodicBoundaries" && n.namespace_ ().empty ())
+    {
+      ::std::unique_ptr< periodicBoundaries_type > r (
+        periodicBoundaries_traits::create (i, f, this));
+
+      if (!this->periodicBoundaries_)
+      {
+        this->periodicBoundaries_.set (::std::move (r));
+        continue;
+      }
+    }
+
+    // cellSizeFactor
+    //
+    if (n.name () == "cellSizeFactor" && n.namespace_ ().empty ())
+    {
+      if (!this->cellSizeFactor_)
+      {
+        this->cellSizeFactor_.set (cellSizeFactor_traits::create (i, f, this));
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -1338,6 +1840,11 @@ operator= (const ContainerType& x)
     this->cutoffRadius_ = x.cutoffRadius_;
     this->domainSize_ = x.domainSize_;
     this->BoundaryType_ = x.BoundaryType_;
+    this->skin_ = x.skin_;
+    this->rebuildFrequency_ = x.rebuildFrequency_;
+    this->theta_ = x.theta_;
+    this->periodicBoundaries_ = x.periodicBoundaries_;
+    this->cellSizeFactor_ = x.cellSizeFactor_;
   }
 
   return *this;
@@ -1573,7 +2080,10 @@ CuboidType (const position_type& position,
   initialVelocity_ (initialVelocity, this),
   distance_ (distance, this),
   meanVelocity_ (meanVelocity, this),
-  mass_ (mass, this)
+  mass_ (mass, this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
 }
 
@@ -1590,7 +2100,10 @@ CuboidType (::std::unique_ptr< position_type > position,
   initialVelocity_ (std::move (initialVelocity), this),
   distance_ (distance, this),
   meanVelocity_ (meanVelocity, this),
-  mass_ (mass, this)
+  mass_ (mass, this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
 }
 
@@ -1604,7 +2117,10 @@ CuboidType (const CuboidType& x,
   initialVelocity_ (x.initialVelocity_, f, this),
   distance_ (x.distance_, f, this),
   meanVelocity_ (x.meanVelocity_, f, this),
-  mass_ (x.mass_, f, this)
+  mass_ (x.mass_, f, this),
+  type_ (x.type_, f, this),
+  epsilon_ (x.epsilon_, f, this),
+  sigma_ (x.sigma_, f, this)
 {
 }
 
@@ -1618,7 +2134,10 @@ CuboidType (const ::xercesc::DOMElement& e,
   initialVelocity_ (this),
   distance_ (this),
   meanVelocity_ (this),
-  mass_ (this)
+  mass_ (this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -1712,6 +2231,39 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // type
+    //
+    if (n.name () == "type" && n.namespace_ ().empty ())
+    {
+      if (!this->type_)
+      {
+        this->type_.set (type_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // epsilon
+    //
+    if (n.name () == "epsilon" && n.namespace_ ().empty ())
+    {
+      if (!this->epsilon_)
+      {
+        this->epsilon_.set (epsilon_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // sigma
+    //
+    if (n.name () == "sigma" && n.namespace_ ().empty ())
+    {
+      if (!this->sigma_)
+      {
+        this->sigma_.set (sigma_traits::create (i, f, this));
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -1777,6 +2329,9 @@ operator= (const CuboidType& x)
     this->distance_ = x.distance_;
     this->meanVelocity_ = x.meanVelocity_;
     this->mass_ = x.mass_;
+    this->type_ = x.type_;
+    this->epsilon_ = x.epsilon_;
+    this->sigma_ = x.sigma_;
   }
 
   return *this;
@@ -1801,7 +2356,10 @@ DiscType (const center_type& center,
   radius_ (radius, this),
   initialVelocity_ (initialVelocity, this),
   distance_ (distance, this),
-  mass_ (mass, this)
+  mass_ (mass, this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
 }
 
@@ -1816,7 +2374,10 @@ DiscType (::std::unique_ptr< center_type > center,
   radius_ (radius, this),
   initialVelocity_ (std::move (initialVelocity), this),
   distance_ (distance, this),
-  mass_ (mass, this)
+  mass_ (mass, this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
 }
 
@@ -1829,7 +2390,10 @@ DiscType (const DiscType& x,
   radius_ (x.radius_, f, this),
   initialVelocity_ (x.initialVelocity_, f, this),
   distance_ (x.distance_, f, this),
-  mass_ (x.mass_, f, this)
+  mass_ (x.mass_, f, this),
+  type_ (x.type_, f, this),
+  epsilon_ (x.epsilon_, f, this),
+  sigma_ (x.sigma_, f, this)
 {
 }
 
@@ -1842,7 +2406,10 @@ DiscType (const ::xercesc::DOMElement& e,
   radius_ (this),
   initialVelocity_ (this),
   distance_ (this),
-  mass_ (this)
+  mass_ (this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -1922,6 +2489,39 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // type
+    //
+    if (n.name () == "type" && n.namespace_ ().empty ())
+    {
+      if (!this->type_)
+      {
+        this->type_.set (type_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // epsilon
+    //
+    if (n.name () == "epsilon" && n.namespace_ ().empty ())
+    {
+      if (!this->epsilon_)
+      {
+        this->epsilon_.set (epsilon_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // sigma
+    //
+    if (n.name () == "sigma" && n.namespace_ ().empty ())
+    {
+      if (!this->sigma_)
+      {
+        this->sigma_.set (sigma_traits::create (i, f, this));
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -1979,6 +2579,9 @@ operator= (const DiscType& x)
     this->initialVelocity_ = x.initialVelocity_;
     this->distance_ = x.distance_;
     this->mass_ = x.mass_;
+    this->type_ = x.type_;
+    this->epsilon_ = x.epsilon_;
+    this->sigma_ = x.sigma_;
   }
 
   return *this;
@@ -1999,7 +2602,10 @@ ParticleType (const position_type& position,
 : ::xml_schema::type (),
   position_ (position, this),
   velocity_ (velocity, this),
-  mass_ (mass, this)
+  mass_ (mass, this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
 }
 
@@ -2010,7 +2616,10 @@ ParticleType (::std::unique_ptr< position_type > position,
 : ::xml_schema::type (),
   position_ (std::move (position), this),
   velocity_ (std::move (velocity), this),
-  mass_ (mass, this)
+  mass_ (mass, this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
 }
 
@@ -2021,7 +2630,10 @@ ParticleType (const ParticleType& x,
 : ::xml_schema::type (x, f, c),
   position_ (x.position_, f, this),
   velocity_ (x.velocity_, f, this),
-  mass_ (x.mass_, f, this)
+  mass_ (x.mass_, f, this),
+  type_ (x.type_, f, this),
+  epsilon_ (x.epsilon_, f, this),
+  sigma_ (x.sigma_, f, this)
 {
 }
 
@@ -2032,7 +2644,10 @@ ParticleType (const ::xercesc::DOMElement& e,
 : ::xml_schema::type (e, f | ::xml_schema::flags::base, c),
   position_ (this),
   velocity_ (this),
-  mass_ (this)
+  mass_ (this),
+  type_ (this),
+  epsilon_ (this),
+  sigma_ (this)
 {
   if ((f & ::xml_schema::flags::base) == 0)
   {
@@ -2090,6 +2705,39 @@ parse (::xsd::cxx::xml::dom::parser< char >& p,
       }
     }
 
+    // type
+    //
+    if (n.name () == "type" && n.namespace_ ().empty ())
+    {
+      if (!this->type_)
+      {
+        this->type_.set (type_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // epsilon
+    //
+    if (n.name () == "epsilon" && n.namespace_ ().empty ())
+    {
+      if (!this->epsilon_)
+      {
+        this->epsilon_.set (epsilon_traits::create (i, f, this));
+        continue;
+      }
+    }
+
+    // sigma
+    //
+    if (n.name () == "sigma" && n.namespace_ ().empty ())
+    {
+      if (!this->sigma_)
+      {
+        this->sigma_.set (sigma_traits::create (i, f, this));
+        continue;
+      }
+    }
+
     break;
   }
 
@@ -2131,6 +2779,9 @@ operator= (const ParticleType& x)
     this->position_ = x.position_;
     this->velocity_ = x.velocity_;
     this->mass_ = x.mass_;
+    this->type_ = x.type_;
+    this->epsilon_ = x.epsilon_;
+    this->sigma_ = x.sigma_;
   }
 
   return *this;
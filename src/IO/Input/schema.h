@@ -918,6 +918,147 @@ class CalculatorType: public ::xml_schema::type
 
   //@}
 
+  /**
+   * @name potential
+   *
+   * @brief Accessor and modifier functions for the %potential
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::string potential_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< potential_type > potential_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< potential_type, char > potential_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const potential_optional&
+  potential () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  potential_optional&
+  potential ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  potential (const potential_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  potential (const potential_optional& x);
+
+  /**
+   * @brief Set the element value without copying.
+   *
+   * @param p A new value to use.
+   *
+   * This function will try to use the passed value directly instead
+   * of making a copy.
+   */
+  void
+  potential (::std::unique_ptr< potential_type > p);
+
+  //@}
+
+  /**
+   * @name tableSize
+   *
+   * @brief Accessor and modifier functions for the %tableSize
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::int_ tableSize_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< tableSize_type > tableSize_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< tableSize_type, char > tableSize_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const tableSize_optional&
+  tableSize () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  tableSize_optional&
+  tableSize ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  tableSize (const tableSize_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  tableSize (const tableSize_optional& x);
+
+  //@}
+
   /**
    * @name Constructors
    */
@@ -1000,6 +1141,8 @@ class CalculatorType: public ::xml_schema::type
 
   protected:
   calculatorForce_optional calculatorForce_;
+  potential_optional potential_;
+  tableSize_optional tableSize_;
 
   //@endcond
 };
@@ -1288,106 +1431,74 @@ class ContainerType: public ::xml_schema::type
   //@}
 
   /**
-   * @name Constructors
+   * @name skin
+   *
+   * @brief Accessor and modifier functions for the %skin
+   * optional element.
    */
   //@{
 
   /**
-   * @brief Create an instance from the ultimate base and
-   * initializers for required elements and attributes.
+   * @brief Element type.
    */
-  ContainerType (const containerType_type&);
+  typedef ::xml_schema::double_ skin_type;
 
   /**
-   * @brief Create an instance from a DOM element.
-   *
-   * @param e A DOM element to extract the data from.
-   * @param f Flags to create the new instance with.
-   * @param c A pointer to the object that will contain the new
-   * instance.
+   * @brief Element optional container type.
    */
-  ContainerType (const ::xercesc::DOMElement& e,
-                 ::xml_schema::flags f = 0,
-                 ::xml_schema::container* c = 0);
+  typedef ::xsd::cxx::tree::optional< skin_type > skin_optional;
 
   /**
-   * @brief Copy constructor.
-   *
-   * @param x An instance to make a copy of.
-   * @param f Flags to create the copy with.
-   * @param c A pointer to the object that will contain the copy.
-   *
-   * For polymorphic object models use the @c _clone function instead.
+   * @brief Element traits type.
    */
-  ContainerType (const ContainerType& x,
-                 ::xml_schema::flags f = 0,
-                 ::xml_schema::container* c = 0);
+  typedef ::xsd::cxx::tree::traits< skin_type, char, ::xsd::cxx::tree::schema_type::double_ > skin_traits;
 
   /**
-   * @brief Copy the instance polymorphically.
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @param f Flags to create the copy with.
-   * @param c A pointer to the object that will contain the copy.
-   * @return A pointer to the dynamically allocated copy.
+   * @return A constant reference to the optional container.
+   */
+  const skin_optional&
+  skin () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
    *
-   * This function ensures that the dynamic type of the instance is
-   * used for copying and should be used for polymorphic object
-   * models instead of the copy constructor.
+   * @return A reference to the optional container.
    */
-  virtual ContainerType*
-  _clone (::xml_schema::flags f = 0,
-          ::xml_schema::container* c = 0) const;
+  skin_optional&
+  skin ();
 
   /**
-   * @brief Copy assignment operator.
+   * @brief Set the element value.
    *
-   * @param x An instance to make a copy of.
-   * @return A reference to itself.
+   * @param x A new value to set.
    *
-   * For polymorphic object models use the @c _clone function instead.
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
    */
-  ContainerType&
-  operator= (const ContainerType& x);
-
-  //@}
+  void
+  skin (const skin_type& x);
 
   /**
-   * @brief Destructor.
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
    */
-  virtual 
-  ~ContainerType ();
-
-  // Implementation.
-  //
-
-  //@cond
-
-  protected:
   void
-  parse (::xsd::cxx::xml::dom::parser< char >&,
-         ::xml_schema::flags);
-
-  protected:
-  ::xsd::cxx::tree::one< containerType_type > containerType_;
-  cutoffRadius_optional cutoffRadius_;
-  domainSize_optional domainSize_;
-  BoundaryType_optional BoundaryType_;
+  skin (const skin_optional& x);
 
-  //@endcond
-};
+  //@}
 
-/**
- * @brief Class corresponding to the %ParametersType schema type.
- *
- * @nosubgrouping
- */
-class ParametersType: public ::xml_schema::type
-{
-  public:
   /**
-   * @name tEnd
+   * @name rebuildFrequency
    *
-   * @brief Accessor and modifier functions for the %tEnd
+   * @brief Accessor and modifier functions for the %rebuildFrequency
    * optional element.
    */
   //@{
@@ -1395,17 +1506,17 @@ class ParametersType: public ::xml_schema::type
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ tEnd_type;
+  typedef ::xml_schema::int_ rebuildFrequency_type;
 
   /**
    * @brief Element optional container type.
    */
-  typedef ::xsd::cxx::tree::optional< tEnd_type > tEnd_optional;
+  typedef ::xsd::cxx::tree::optional< rebuildFrequency_type > rebuildFrequency_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< tEnd_type, char, ::xsd::cxx::tree::schema_type::double_ > tEnd_traits;
+  typedef ::xsd::cxx::tree::traits< rebuildFrequency_type, char > rebuildFrequency_traits;
 
   /**
    * @brief Return a read-only (constant) reference to the element
@@ -1413,16 +1524,16 @@ class ParametersType: public ::xml_schema::type
    *
    * @return A constant reference to the optional container.
    */
-  const tEnd_optional&
-  tEnd () const;
+  const rebuildFrequency_optional&
+  rebuildFrequency () const;
 
   /**
    * @brief Return a read-write reference to the element container.
    *
    * @return A reference to the optional container.
    */
-  tEnd_optional&
-  tEnd ();
+  rebuildFrequency_optional&
+  rebuildFrequency ();
 
   /**
    * @brief Set the element value.
@@ -1433,7 +1544,7 @@ class ParametersType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  tEnd (const tEnd_type& x);
+  rebuildFrequency (const rebuildFrequency_type& x);
 
   /**
    * @brief Set the element value.
@@ -1445,14 +1556,14 @@ class ParametersType: public ::xml_schema::type
    * Otherwise the element container is set the 'not present' state.
    */
   void
-  tEnd (const tEnd_optional& x);
+  rebuildFrequency (const rebuildFrequency_optional& x);
 
   //@}
 
   /**
-   * @name deltaT
+   * @name theta
    *
-   * @brief Accessor and modifier functions for the %deltaT
+   * @brief Accessor and modifier functions for the %theta
    * optional element.
    */
   //@{
@@ -1460,17 +1571,17 @@ class ParametersType: public ::xml_schema::type
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ deltaT_type;
+  typedef ::xml_schema::double_ theta_type;
 
   /**
    * @brief Element optional container type.
    */
-  typedef ::xsd::cxx::tree::optional< deltaT_type > deltaT_optional;
+  typedef ::xsd::cxx::tree::optional< theta_type > theta_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< deltaT_type, char, ::xsd::cxx::tree::schema_type::double_ > deltaT_traits;
+  typedef ::xsd::cxx::tree::traits< theta_type, char, ::xsd::cxx::tree::schema_type::double_ > theta_traits;
 
   /**
    * @brief Return a read-only (constant) reference to the element
@@ -1478,16 +1589,16 @@ class ParametersType: public ::xml_schema::type
    *
    * @return A constant reference to the optional container.
    */
-  const deltaT_optional&
-  deltaT () const;
+  const theta_optional&
+  theta () const;
 
   /**
    * @brief Return a read-write reference to the element container.
    *
    * @return A reference to the optional container.
    */
-  deltaT_optional&
-  deltaT ();
+  theta_optional&
+  theta ();
 
   /**
    * @brief Set the element value.
@@ -1498,7 +1609,7 @@ class ParametersType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  deltaT (const deltaT_type& x);
+  theta (const theta_type& x);
 
   /**
    * @brief Set the element value.
@@ -1510,38 +1621,411 @@ class ParametersType: public ::xml_schema::type
    * Otherwise the element container is set the 'not present' state.
    */
   void
-  deltaT (const deltaT_optional& x);
+  theta (const theta_optional& x);
 
   //@}
 
   /**
-   * @name Constructors
+   * @name periodicBoundaries
+   *
+   * @brief Accessor and modifier functions for the %periodicBoundaries
+   * optional element.
    */
   //@{
 
   /**
-   * @brief Create an instance from the ultimate base and
-   * initializers for required elements and attributes.
+   * @brief Element type.
    */
-  ParametersType ();
+  typedef ::BoolVector periodicBoundaries_type;
 
   /**
-   * @brief Create an instance from a DOM element.
-   *
-   * @param e A DOM element to extract the data from.
-   * @param f Flags to create the new instance with.
-   * @param c A pointer to the object that will contain the new
-   * instance.
+   * @brief Element optional container type.
    */
-  ParametersType (const ::xercesc::DOMElement& e,
-                  ::xml_schema::flags f = 0,
-                  ::xml_schema::container* c = 0);
+  typedef ::xsd::cxx::tree::optional< periodicBoundaries_type > periodicBoundaries_optional;
 
   /**
-   * @brief Copy constructor.
-   *
-   * @param x An instance to make a copy of.
-   * @param f Flags to create the copy with.
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< periodicBoundaries_type, char > periodicBoundaries_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const periodicBoundaries_optional&
+  periodicBoundaries () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  periodicBoundaries_optional&
+  periodicBoundaries ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  periodicBoundaries (const periodicBoundaries_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  periodicBoundaries (const periodicBoundaries_optional& x);
+
+  /**
+   * @brief Set the element value without copying.
+   *
+   * @param p A new value to use.
+   *
+   * This function will try to use the passed value directly instead
+   * of making a copy.
+   */
+  void
+  periodicBoundaries (::std::unique_ptr< periodicBoundaries_type > p);
+
+  //@}
+
+  /**
+   * @name cellSizeFactor
+   *
+   * @brief Accessor and modifier functions for the %cellSizeFactor
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ cellSizeFactor_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< cellSizeFactor_type > cellSizeFactor_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< cellSizeFactor_type, char, ::xsd::cxx::tree::schema_type::double_ > cellSizeFactor_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const cellSizeFactor_optional&
+  cellSizeFactor () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  cellSizeFactor_optional&
+  cellSizeFactor ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  cellSizeFactor (const cellSizeFactor_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  cellSizeFactor (const cellSizeFactor_optional& x);
+
+  //@}
+
+  /**
+   * @name Constructors
+   */
+  //@{
+
+  /**
+   * @brief Create an instance from the ultimate base and
+   * initializers for required elements and attributes.
+   */
+  ContainerType (const containerType_type&);
+
+  /**
+   * @brief Create an instance from a DOM element.
+   *
+   * @param e A DOM element to extract the data from.
+   * @param f Flags to create the new instance with.
+   * @param c A pointer to the object that will contain the new
+   * instance.
+   */
+  ContainerType (const ::xercesc::DOMElement& e,
+                 ::xml_schema::flags f = 0,
+                 ::xml_schema::container* c = 0);
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param x An instance to make a copy of.
+   * @param f Flags to create the copy with.
+   * @param c A pointer to the object that will contain the copy.
+   *
+   * For polymorphic object models use the @c _clone function instead.
+   */
+  ContainerType (const ContainerType& x,
+                 ::xml_schema::flags f = 0,
+                 ::xml_schema::container* c = 0);
+
+  /**
+   * @brief Copy the instance polymorphically.
+   *
+   * @param f Flags to create the copy with.
+   * @param c A pointer to the object that will contain the copy.
+   * @return A pointer to the dynamically allocated copy.
+   *
+   * This function ensures that the dynamic type of the instance is
+   * used for copying and should be used for polymorphic object
+   * models instead of the copy constructor.
+   */
+  virtual ContainerType*
+  _clone (::xml_schema::flags f = 0,
+          ::xml_schema::container* c = 0) const;
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param x An instance to make a copy of.
+   * @return A reference to itself.
+   *
+   * For polymorphic object models use the @c _clone function instead.
+   */
+  ContainerType&
+  operator= (const ContainerType& x);
+
+  //@}
+
+  /**
+   * @brief Destructor.
+   */
+  virtual 
+  ~ContainerType ();
+
+  // Implementation.
+  //
+
+  //@cond
+
+  protected:
+  void
+  parse (::xsd::cxx::xml::dom::parser< char >&,
+         ::xml_schema::flags);
+
+  protected:
+  ::xsd::cxx::tree::one< containerType_type > containerType_;
+  cutoffRadius_optional cutoffRadius_;
+  domainSize_optional domainSize_;
+  BoundaryType_optional BoundaryType_;
+  skin_optional skin_;
+  rebuildFrequency_optional rebuildFrequency_;
+  theta_optional theta_;
+  periodicBoundaries_optional periodicBoundaries_;
+  cellSizeFactor_optional cellSizeFactor_;
+
+  //@endcond
+};
+
+/**
+ * @brief Class corresponding to the %ParametersType schema type.
+ *
+ * @nosubgrouping
+ */
+class ParametersType: public ::xml_schema::type
+{
+  public:
+  /**
+   * @name tEnd
+   *
+   * @brief Accessor and modifier functions for the %tEnd
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ tEnd_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< tEnd_type > tEnd_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< tEnd_type, char, ::xsd::cxx::tree::schema_type::double_ > tEnd_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const tEnd_optional&
+  tEnd () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  tEnd_optional&
+  tEnd ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  tEnd (const tEnd_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  tEnd (const tEnd_optional& x);
+
+  //@}
+
+  /**
+   * @name deltaT
+   *
+   * @brief Accessor and modifier functions for the %deltaT
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ deltaT_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< deltaT_type > deltaT_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< deltaT_type, char, ::xsd::cxx::tree::schema_type::double_ > deltaT_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const deltaT_optional&
+  deltaT () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  deltaT_optional&
+  deltaT ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  deltaT (const deltaT_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  deltaT (const deltaT_optional& x);
+
+  //@}
+
+  /**
+   * @name Constructors
+   */
+  //@{
+
+  /**
+   * @brief Create an instance from the ultimate base and
+   * initializers for required elements and attributes.
+   */
+  ParametersType ();
+
+  /**
+   * @brief Create an instance from a DOM element.
+   *
+   * @param e A DOM element to extract the data from.
+   * @param f Flags to create the new instance with.
+   * @param c A pointer to the object that will contain the new
+   * instance.
+   */
+  ParametersType (const ::xercesc::DOMElement& e,
+                  ::xml_schema::flags f = 0,
+                  ::xml_schema::container* c = 0);
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param x An instance to make a copy of.
+   * @param f Flags to create the copy with.
    * @param c A pointer to the object that will contain the copy.
    *
    * For polymorphic object models use the @c _clone function instead.
@@ -2074,36 +2558,183 @@ class CuboidType: public ::xml_schema::type
   /**
    * @name distance
    *
-   * @brief Accessor and modifier functions for the %distance
-   * required element.
+   * @brief Accessor and modifier functions for the %distance
+   * required element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ distance_type;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< distance_type, char, ::xsd::cxx::tree::schema_type::double_ > distance_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element.
+   *
+   * @return A constant reference to the element.
+   */
+  const distance_type&
+  distance () const;
+
+  /**
+   * @brief Return a read-write reference to the element.
+   *
+   * @return A reference to the element.
+   */
+  distance_type&
+  distance ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  distance (const distance_type& x);
+
+  //@}
+
+  /**
+   * @name meanVelocity
+   *
+   * @brief Accessor and modifier functions for the %meanVelocity
+   * required element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ meanVelocity_type;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< meanVelocity_type, char, ::xsd::cxx::tree::schema_type::double_ > meanVelocity_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element.
+   *
+   * @return A constant reference to the element.
+   */
+  const meanVelocity_type&
+  meanVelocity () const;
+
+  /**
+   * @brief Return a read-write reference to the element.
+   *
+   * @return A reference to the element.
+   */
+  meanVelocity_type&
+  meanVelocity ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  meanVelocity (const meanVelocity_type& x);
+
+  //@}
+
+  /**
+   * @name mass
+   *
+   * @brief Accessor and modifier functions for the %mass
+   * required element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ mass_type;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< mass_type, char, ::xsd::cxx::tree::schema_type::double_ > mass_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element.
+   *
+   * @return A constant reference to the element.
+   */
+  const mass_type&
+  mass () const;
+
+  /**
+   * @brief Return a read-write reference to the element.
+   *
+   * @return A reference to the element.
+   */
+  mass_type&
+  mass ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  mass (const mass_type& x);
+
+  //@}
+
+  /**
+   * @name type
+   *
+   * @brief Accessor and modifier functions for the %type
+   * optional element.
    */
   //@{
 
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ distance_type;
+  typedef ::xml_schema::int_ type_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< type_type > type_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< distance_type, char, ::xsd::cxx::tree::schema_type::double_ > distance_traits;
+  typedef ::xsd::cxx::tree::traits< type_type, char > type_traits;
 
   /**
-   * @brief Return a read-only (constant) reference to the element.
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @return A constant reference to the element.
+   * @return A constant reference to the optional container.
    */
-  const distance_type&
-  distance () const;
+  const type_optional&
+  type () const;
 
   /**
-   * @brief Return a read-write reference to the element.
+   * @brief Return a read-write reference to the element container.
    *
-   * @return A reference to the element.
+   * @return A reference to the optional container.
    */
-  distance_type&
-  distance ();
+  type_optional&
+  type ();
 
   /**
    * @brief Set the element value.
@@ -2114,43 +2745,61 @@ class CuboidType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  distance (const distance_type& x);
+  type (const type_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  type (const type_optional& x);
 
   //@}
 
   /**
-   * @name meanVelocity
+   * @name epsilon
    *
-   * @brief Accessor and modifier functions for the %meanVelocity
-   * required element.
+   * @brief Accessor and modifier functions for the %epsilon
+   * optional element.
    */
   //@{
 
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ meanVelocity_type;
+  typedef ::xml_schema::double_ epsilon_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< epsilon_type > epsilon_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< meanVelocity_type, char, ::xsd::cxx::tree::schema_type::double_ > meanVelocity_traits;
+  typedef ::xsd::cxx::tree::traits< epsilon_type, char, ::xsd::cxx::tree::schema_type::double_ > epsilon_traits;
 
   /**
-   * @brief Return a read-only (constant) reference to the element.
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @return A constant reference to the element.
+   * @return A constant reference to the optional container.
    */
-  const meanVelocity_type&
-  meanVelocity () const;
+  const epsilon_optional&
+  epsilon () const;
 
   /**
-   * @brief Return a read-write reference to the element.
+   * @brief Return a read-write reference to the element container.
    *
-   * @return A reference to the element.
+   * @return A reference to the optional container.
    */
-  meanVelocity_type&
-  meanVelocity ();
+  epsilon_optional&
+  epsilon ();
 
   /**
    * @brief Set the element value.
@@ -2161,43 +2810,61 @@ class CuboidType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  meanVelocity (const meanVelocity_type& x);
+  epsilon (const epsilon_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  epsilon (const epsilon_optional& x);
 
   //@}
 
   /**
-   * @name mass
+   * @name sigma
    *
-   * @brief Accessor and modifier functions for the %mass
-   * required element.
+   * @brief Accessor and modifier functions for the %sigma
+   * optional element.
    */
   //@{
 
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ mass_type;
+  typedef ::xml_schema::double_ sigma_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< sigma_type > sigma_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< mass_type, char, ::xsd::cxx::tree::schema_type::double_ > mass_traits;
+  typedef ::xsd::cxx::tree::traits< sigma_type, char, ::xsd::cxx::tree::schema_type::double_ > sigma_traits;
 
   /**
-   * @brief Return a read-only (constant) reference to the element.
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @return A constant reference to the element.
+   * @return A constant reference to the optional container.
    */
-  const mass_type&
-  mass () const;
+  const sigma_optional&
+  sigma () const;
 
   /**
-   * @brief Return a read-write reference to the element.
+   * @brief Return a read-write reference to the element container.
    *
-   * @return A reference to the element.
+   * @return A reference to the optional container.
    */
-  mass_type&
-  mass ();
+  sigma_optional&
+  sigma ();
 
   /**
    * @brief Set the element value.
@@ -2208,7 +2875,19 @@ class CuboidType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  mass (const mass_type& x);
+  sigma (const sigma_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  sigma (const sigma_optional& x);
 
   //@}
 
@@ -2319,6 +2998,9 @@ class CuboidType: public ::xml_schema::type
   ::xsd::cxx::tree::one< distance_type > distance_;
   ::xsd::cxx::tree::one< meanVelocity_type > meanVelocity_;
   ::xsd::cxx::tree::one< mass_type > mass_;
+  type_optional type_;
+  epsilon_optional epsilon_;
+  sigma_optional sigma_;
 
   //@endcond
 };
@@ -2455,20 +3137,178 @@ class DiscType: public ::xml_schema::type
   typedef ::xsd::cxx::tree::traits< initialVelocity_type, char > initialVelocity_traits;
 
   /**
-   * @brief Return a read-only (constant) reference to the element.
+   * @brief Return a read-only (constant) reference to the element.
+   *
+   * @return A constant reference to the element.
+   */
+  const initialVelocity_type&
+  initialVelocity () const;
+
+  /**
+   * @brief Return a read-write reference to the element.
+   *
+   * @return A reference to the element.
+   */
+  initialVelocity_type&
+  initialVelocity ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  initialVelocity (const initialVelocity_type& x);
+
+  /**
+   * @brief Set the element value without copying.
+   *
+   * @param p A new value to use.
+   *
+   * This function will try to use the passed value directly
+   * instead of making a copy.
+   */
+  void
+  initialVelocity (::std::unique_ptr< initialVelocity_type > p);
+
+  //@}
+
+  /**
+   * @name distance
+   *
+   * @brief Accessor and modifier functions for the %distance
+   * required element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ distance_type;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< distance_type, char, ::xsd::cxx::tree::schema_type::double_ > distance_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element.
+   *
+   * @return A constant reference to the element.
+   */
+  const distance_type&
+  distance () const;
+
+  /**
+   * @brief Return a read-write reference to the element.
+   *
+   * @return A reference to the element.
+   */
+  distance_type&
+  distance ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  distance (const distance_type& x);
+
+  //@}
+
+  /**
+   * @name mass
+   *
+   * @brief Accessor and modifier functions for the %mass
+   * required element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ mass_type;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< mass_type, char, ::xsd::cxx::tree::schema_type::double_ > mass_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element.
+   *
+   * @return A constant reference to the element.
+   */
+  const mass_type&
+  mass () const;
+
+  /**
+   * @brief Return a read-write reference to the element.
+   *
+   * @return A reference to the element.
+   */
+  mass_type&
+  mass ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  mass (const mass_type& x);
+
+  //@}
+
+  /**
+   * @name type
+   *
+   * @brief Accessor and modifier functions for the %type
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::int_ type_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< type_type > type_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< type_type, char > type_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @return A constant reference to the element.
+   * @return A constant reference to the optional container.
    */
-  const initialVelocity_type&
-  initialVelocity () const;
+  const type_optional&
+  type () const;
 
   /**
-   * @brief Return a read-write reference to the element.
+   * @brief Return a read-write reference to the element container.
    *
-   * @return A reference to the element.
+   * @return A reference to the optional container.
    */
-  initialVelocity_type&
-  initialVelocity ();
+  type_optional&
+  type ();
 
   /**
    * @brief Set the element value.
@@ -2479,54 +3319,61 @@ class DiscType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  initialVelocity (const initialVelocity_type& x);
+  type (const type_type& x);
 
   /**
-   * @brief Set the element value without copying.
+   * @brief Set the element value.
    *
-   * @param p A new value to use.
+   * @param x An optional container with the new value to set.
    *
-   * This function will try to use the passed value directly
-   * instead of making a copy.
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
    */
   void
-  initialVelocity (::std::unique_ptr< initialVelocity_type > p);
+  type (const type_optional& x);
 
   //@}
 
   /**
-   * @name distance
+   * @name epsilon
    *
-   * @brief Accessor and modifier functions for the %distance
-   * required element.
+   * @brief Accessor and modifier functions for the %epsilon
+   * optional element.
    */
   //@{
 
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ distance_type;
+  typedef ::xml_schema::double_ epsilon_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< epsilon_type > epsilon_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< distance_type, char, ::xsd::cxx::tree::schema_type::double_ > distance_traits;
+  typedef ::xsd::cxx::tree::traits< epsilon_type, char, ::xsd::cxx::tree::schema_type::double_ > epsilon_traits;
 
   /**
-   * @brief Return a read-only (constant) reference to the element.
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @return A constant reference to the element.
+   * @return A constant reference to the optional container.
    */
-  const distance_type&
-  distance () const;
+  const epsilon_optional&
+  epsilon () const;
 
   /**
-   * @brief Return a read-write reference to the element.
+   * @brief Return a read-write reference to the element container.
    *
-   * @return A reference to the element.
+   * @return A reference to the optional container.
    */
-  distance_type&
-  distance ();
+  epsilon_optional&
+  epsilon ();
 
   /**
    * @brief Set the element value.
@@ -2537,43 +3384,61 @@ class DiscType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  distance (const distance_type& x);
+  epsilon (const epsilon_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  epsilon (const epsilon_optional& x);
 
   //@}
 
   /**
-   * @name mass
+   * @name sigma
    *
-   * @brief Accessor and modifier functions for the %mass
-   * required element.
+   * @brief Accessor and modifier functions for the %sigma
+   * optional element.
    */
   //@{
 
   /**
    * @brief Element type.
    */
-  typedef ::xml_schema::double_ mass_type;
+  typedef ::xml_schema::double_ sigma_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< sigma_type > sigma_optional;
 
   /**
    * @brief Element traits type.
    */
-  typedef ::xsd::cxx::tree::traits< mass_type, char, ::xsd::cxx::tree::schema_type::double_ > mass_traits;
+  typedef ::xsd::cxx::tree::traits< sigma_type, char, ::xsd::cxx::tree::schema_type::double_ > sigma_traits;
 
   /**
-   * @brief Return a read-only (constant) reference to the element.
+   * @brief Return a read-only (constant) reference to the element
+   * container.
    *
-   * @return A constant reference to the element.
+   * @return A constant reference to the optional container.
    */
-  const mass_type&
-  mass () const;
+  const sigma_optional&
+  sigma () const;
 
   /**
-   * @brief Return a read-write reference to the element.
+   * @brief Return a read-write reference to the element container.
    *
-   * @return A reference to the element.
+   * @return A reference to the optional container.
    */
-  mass_type&
-  mass ();
+  sigma_optional&
+  sigma ();
 
   /**
    * @brief Set the element value.
@@ -2584,7 +3449,19 @@ class DiscType: public ::xml_schema::type
    * the new value of the element.
    */
   void
-  mass (const mass_type& x);
+  sigma (const sigma_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  sigma (const sigma_optional& x);
 
   //@}
 
@@ -2692,6 +3569,9 @@ class DiscType: public ::xml_schema::type
   ::xsd::cxx::tree::one< initialVelocity_type > initialVelocity_;
   ::xsd::cxx::tree::one< distance_type > distance_;
   ::xsd::cxx::tree::one< mass_type > mass_;
+  type_optional type_;
+  epsilon_optional epsilon_;
+  sigma_optional sigma_;
 
   //@endcond
 };
@@ -2867,6 +3747,201 @@ class ParticleType: public ::xml_schema::type
 
   //@}
 
+  /**
+   * @name type
+   *
+   * @brief Accessor and modifier functions for the %type
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::int_ type_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< type_type > type_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< type_type, char > type_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const type_optional&
+  type () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  type_optional&
+  type ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  type (const type_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  type (const type_optional& x);
+
+  //@}
+
+  /**
+   * @name epsilon
+   *
+   * @brief Accessor and modifier functions for the %epsilon
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ epsilon_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< epsilon_type > epsilon_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< epsilon_type, char, ::xsd::cxx::tree::schema_type::double_ > epsilon_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const epsilon_optional&
+  epsilon () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  epsilon_optional&
+  epsilon ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  epsilon (const epsilon_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  epsilon (const epsilon_optional& x);
+
+  //@}
+
+  /**
+   * @name sigma
+   *
+   * @brief Accessor and modifier functions for the %sigma
+   * optional element.
+   */
+  //@{
+
+  /**
+   * @brief Element type.
+   */
+  typedef ::xml_schema::double_ sigma_type;
+
+  /**
+   * @brief Element optional container type.
+   */
+  typedef ::xsd::cxx::tree::optional< sigma_type > sigma_optional;
+
+  /**
+   * @brief Element traits type.
+   */
+  typedef ::xsd::cxx::tree::traits< sigma_type, char, ::xsd::cxx::tree::schema_type::double_ > sigma_traits;
+
+  /**
+   * @brief Return a read-only (constant) reference to the element
+   * container.
+   *
+   * @return A constant reference to the optional container.
+   */
+  const sigma_optional&
+  sigma () const;
+
+  /**
+   * @brief Return a read-write reference to the element container.
+   *
+   * @return A reference to the optional container.
+   */
+  sigma_optional&
+  sigma ();
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x A new value to set.
+   *
+   * This function makes a copy of its argument and sets it as
+   * the new value of the element.
+   */
+  void
+  sigma (const sigma_type& x);
+
+  /**
+   * @brief Set the element value.
+   *
+   * @param x An optional container with the new value to set.
+   *
+   * If the value is present in @a x then this function makes a copy 
+   * of this value and sets it as the new value of the element.
+   * Otherwise the element container is set the 'not present' state.
+   */
+  void
+  sigma (const sigma_optional& x);
+
+  //@}
+
   /**
    * @name Constructors
    */
@@ -2965,6 +4040,9 @@ class ParticleType: public ::xml_schema::type
   ::xsd::cxx::tree::one< position_type > position_;
   ::xsd::cxx::tree::one< velocity_type > velocity_;
   ::xsd::cxx::tree::one< mass_type > mass_;
+  type_optional type_;
+  epsilon_optional epsilon_;
+  sigma_optional sigma_;
 
   //@endcond
 };
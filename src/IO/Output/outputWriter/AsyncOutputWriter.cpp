@@ -0,0 +1,107 @@
+//
+// AsyncOutputWriter.cpp
+//
+
+#include "AsyncOutputWriter.h"
+
+#include <stdexcept>
+#include "spdlog/spdlog.h"
+
+namespace outputWriters {
+    AsyncOutputWriter::AsyncOutputWriter(std::unique_ptr<OutputWriter> writer, size_t numBuffers)
+            : writer(std::move(writer)), buffers(numBuffers) {
+        if (this->writer == nullptr) {
+            throw std::invalid_argument("AsyncOutputWriter needs a writer");
+        }
+        if (numBuffers == 0) {
+            throw std::invalid_argument("AsyncOutputWriter needs at least one buffer");
+        }
+        for (size_t b = numBuffers; b > 0; --b) {
+            freeBuffers.push_back(b - 1);
+        }
+        worker = std::thread(&AsyncOutputWriter::writeSnapshots, this);
+    }
+
+    AsyncOutputWriter::~AsyncOutputWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        // the writer thread empties the queue before it returns
+        worker.join();
+        if (error) {
+            SPDLOG_ERROR("Writing the output failed, some output files are missing");
+        }
+    }
+
+    void AsyncOutputWriter::plotParticles(int iteration, ParticleContainers::ParticleContainer &particleContainer, const std::string &filename) {
+        size_t buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !freeBuffers.empty() || error; });
+            rethrowError();
+            buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+
+        // the buffer belongs to this thread until it is queued, copying reuses the memory of earlier snapshots
+        Snapshot &snapshot = buffers[buffer];
+        snapshot.iteration = iteration;
+        snapshot.filename = filename;
+        snapshot.particles.getStorage() = particleContainer.getStorage();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingBuffers.push_back(buffer);
+        }
+        changed.notify_all();
+    }
+
+    void AsyncOutputWriter::flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return pendingBuffers.empty(); });
+        rethrowError();
+    }
+
+    void AsyncOutputWriter::writeSnapshots() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            changed.wait(lock, [this] { return stopping || !pendingBuffers.empty(); });
+            if (pendingBuffers.empty()) {
+                return;
+            }
+            Snapshot &snapshot = buffers[pendingBuffers.front()];
+            lock.unlock();
+            try {
+                writer->plotParticles(snapshot.iteration, snapshot.particles, snapshot.filename);
+            } catch (...) {
+                lock.lock();
+                if (!error) {
+                    error = std::current_exception();
+                }
+                lock.unlock();
+            }
+            lock.lock();
+            freeBuffers.push_back(pendingBuffers.front());
+            pendingBuffers.pop_front();
+            changed.notify_all();
+        }
+    }
+
+    void AsyncOutputWriter::rethrowError() {
+        if (error) {
+            std::exception_ptr thrown = error;
+            error = nullptr;
+            std::rethrow_exception(thrown);
+        }
+    }
+
+    std::string AsyncOutputWriter::toString() {
+        return writer->toString();
+    }
+
+    OutputWriter &AsyncOutputWriter::getWriter() {
+        return *writer;
+    }
+} // namespace outputWriters
@@ -0,0 +1,115 @@
+//
+// AsyncOutputWriter.h
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OutputWriter.h"
+#include "Objects/Containers/DirectSum/DirectSumContainer.h"
+
+namespace outputWriters {
+    /**
+     * @brief Decorator that moves the work of another OutputWriter to a background thread.
+     *
+     * plotParticles only copies the particles into one of a fixed number of reusable snapshot buffers and
+     * returns, the wrapped writer then writes the snapshot while the simulation continues. If all buffers are
+     * still waiting to be written, plotParticles blocks until the writer thread has finished one of them, so
+     * a slow disk throttles the simulation instead of piling up memory. Snapshots are written in the order in
+     * which they were plotted, so the files are the same as with the wrapped writer alone.
+     */
+    class AsyncOutputWriter : public OutputWriter {
+    public:
+        /**
+         * @brief Constructor of the AsyncOutputWriter, starts the writer thread
+         * @param writer the writer that writes the snapshots
+         * @param numBuffers number of snapshots that can be waiting to be written, has to be positive
+         */
+        explicit AsyncOutputWriter(std::unique_ptr<OutputWriter> writer, size_t numBuffers = 2);
+
+        /**
+         * @brief writes all remaining snapshots and stops the writer thread
+         */
+        ~AsyncOutputWriter() override;
+
+        /**
+         * @brief copies the particles into a free snapshot buffer and queues it for writing
+         *
+         * Rethrows the exception if writing a previous snapshot failed.
+         * @param iteration the number of the current iteration
+         * @param particleContainer the particles to be written
+         * @param filename the base name of the file to be written
+         */
+        void plotParticles(int iteration, ParticleContainers::ParticleContainer &particleContainer, const std::string &filename) override;
+
+        /**
+         * @brief blocks until all queued snapshots are written. Rethrows the exception if writing one of them failed.
+         */
+        void flush() override;
+
+        std::string toString() override;
+
+        /**
+         * @return the writer that writes the snapshots
+         */
+        OutputWriter &getWriter();
+
+    private:
+        /**
+         * @brief a copy of the particles together with the arguments of plotParticles
+         */
+        struct Snapshot {
+            int iteration = 0;
+            std::string filename;
+            ParticleContainers::DirectSumContainer particles;
+        };
+
+        std::unique_ptr<OutputWriter> writer;
+
+        std::vector<Snapshot> buffers;
+
+        /**
+         * @brief indices of the buffers that can be filled
+         */
+        std::vector<size_t> freeBuffers;
+
+        /**
+         * @brief indices of the filled buffers in plotting order, the first one is written at the moment
+         */
+        std::deque<size_t> pendingBuffers;
+
+        std::mutex mutex;
+
+        /**
+         * @brief signalled whenever a buffer is queued or written
+         */
+        std::condition_variable changed;
+
+        bool stopping = false;
+
+        /**
+         * @brief first exception thrown by the wrapped writer, rethrown in the simulation thread
+         */
+        std::exception_ptr error;
+
+        std::thread worker;
+
+        /**
+         * @brief loop of the writer thread
+         */
+        void writeSnapshots();
+
+        /**
+         * @brief rethrows a stored exception of the writer thread once
+         */
+        void rethrowError();
+    };
+} // namespace outputWriters
@@ -15,5 +15,10 @@ namespace outputWriters {
         virtual void plotParticles(int iteration, ParticleContainers::ParticleContainer& particleContainer, const std::string& filename) = 0;
         virtual std::string toString() = 0;
 
+        /**
+         * @brief Blocks until all output passed to plotParticles has been written. Writers that write synchronously have nothing to do.
+         */
+        virtual void flush() {}
+
     };
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+//
+// VTKBinaryWriter.cpp
+//
+
+#include "VTKBinaryWriter.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "spdlog/spdlog.h"
+
+namespace outputWriters {
+    namespace {
+        const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        bool isLittleEndian() {
+            const uint16_t probe = 1;
+            unsigned char firstByte;
+            std::memcpy(&firstByte, &probe, 1);
+            return firstByte == 1;
+        }
+
+        /**
+         * @brief writes the declaration of an appended data array
+         */
+        void writeDataArray(std::ostream &out, const char *type, const char *name, int numComponents, size_t offset) {
+            out << "        <DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\""
+                << numComponents << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+        }
+    }
+
+    void appendBase64(const unsigned char *data, size_t length, std::string &out) {
+        const size_t begin = out.size();
+        out.resize(begin + (length + 2) / 3 * 4);
+        char *encoded = &out[begin];
+        size_t i = 0;
+        for (; i + 2 < length; i += 3) {
+            const uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+            *encoded++ = base64Alphabet[(triple >> 18) & 63];
+            *encoded++ = base64Alphabet[(triple >> 12) & 63];
+            *encoded++ = base64Alphabet[(triple >> 6) & 63];
+            *encoded++ = base64Alphabet[triple & 63];
+        }
+        if (i < length) {
+            const bool two = i + 1 < length;
+            const uint32_t triple = (uint32_t(data[i]) << 16) | (two ? uint32_t(data[i + 1]) << 8 : 0);
+            *encoded++ = base64Alphabet[(triple >> 18) & 63];
+            *encoded++ = base64Alphabet[(triple >> 12) & 63];
+            *encoded++ = two ? base64Alphabet[(triple >> 6) & 63] : '=';
+            *encoded = '=';
+        }
+    }
+
+    VTKBinaryWriter::VTKBinaryWriter(Encoding encoding, Precision precision) : encoding(encoding), precision(precision) {}
+
+    template<typename T, typename S>
+    size_t VTKBinaryWriter::appendArray(std::initializer_list<const S *> components, size_t numTuples) {
+        const size_t offset = appended.size();
+        const size_t numComponents = components.size();
+        scratch.resize(sizeof(uint64_t) + numTuples * numComponents * sizeof(T));
+        unsigned char *out = scratch.data() + sizeof(uint64_t);
+        size_t c = 0;
+        for (const S *component: components) {
+            for (size_t i = 0; i < numTuples; ++i) {
+                const T value = static_cast<T>(component[i]);
+                std::memcpy(out + (i * numComponents + c) * sizeof(T), &value, sizeof(T));
+            }
+            ++c;
+        }
+        appendBlock();
+        return offset;
+    }
+
+    size_t VTKBinaryWriter::appendFloatArray(std::initializer_list<const double *> components, size_t numTuples) {
+        if (precision == Precision::FLOAT64) {
+            return appendArray<double>(components, numTuples);
+        }
+        return appendArray<float>(components, numTuples);
+    }
+
+    void VTKBinaryWriter::appendBlock() {
+        const uint64_t numBytes = scratch.size() - sizeof(uint64_t);
+        std::memcpy(scratch.data(), &numBytes, sizeof(numBytes));
+        if (encoding == Encoding::RAW) {
+            appended.append(reinterpret_cast<const char *>(scratch.data()), scratch.size());
+        } else {
+            // uncompressed blocks are encoded together with their header, as done by VTK itself
+            appendBase64(scratch.data(), scratch.size(), appended);
+        }
+    }
+
+    void VTKBinaryWriter::plotParticles(int iteration, ParticleContainers::ParticleContainer &particleContainer, const std::string &filename) {
+        ParticleStorage &particles = particleContainer.getStorage();
+        const size_t numParticles = particles.size();
+        const char *floatType = precision == Precision::FLOAT64 ? "Float64" : "Float32";
+
+        appended.clear();
+        const size_t massOffset = appendFloatArray({particles.m.data()}, numParticles);
+        const size_t velocityOffset = appendFloatArray({particles.vx.data(), particles.vy.data(), particles.vz.data()}, numParticles);
+        const size_t forceOffset = appendFloatArray({particles.oldFx.data(), particles.oldFy.data(), particles.oldFz.data()}, numParticles);
+        const size_t typeOffset = appendArray<int32_t>({particles.type.data()}, numParticles);
+        const size_t pointsOffset = appendFloatArray({particles.x.data(), particles.y.data(), particles.z.data()}, numParticles);
+        // there are no cells, but ParaView expects the cell arrays to be present
+        const size_t connectivityOffset = appendArray<int32_t, int>({}, 0);
+        const size_t offsetsOffset = appendArray<int32_t, int>({}, 0);
+        const size_t typesOffset = appendArray<uint8_t, int>({}, 0);
+
+        std::stringstream header;
+        header << "<?xml version=\"1.0\"?>\n"
+               << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+               << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\">\n"
+               << "  <UnstructuredGrid>\n"
+               << "    <Piece NumberOfPoints=\"" << numParticles << "\" NumberOfCells=\"0\">\n"
+               << "      <PointData>\n";
+        writeDataArray(header, floatType, "mass", 1, massOffset);
+        writeDataArray(header, floatType, "velocity", 3, velocityOffset);
+        writeDataArray(header, floatType, "force", 3, forceOffset);
+        writeDataArray(header, "Int32", "type", 1, typeOffset);
+        header << "      </PointData>\n"
+               << "      <CellData/>\n"
+               << "      <Points>\n";
+        writeDataArray(header, floatType, "points", 3, pointsOffset);
+        header << "      </Points>\n"
+               << "      <Cells>\n";
+        writeDataArray(header, "Int32", "connectivity", 1, connectivityOffset);
+        writeDataArray(header, "Int32", "offsets", 1, offsetsOffset);
+        writeDataArray(header, "UInt8", "types", 1, typesOffset);
+        header << "      </Cells>\n"
+               << "    </Piece>\n"
+               << "  </UnstructuredGrid>\n"
+               << "  <AppendedData encoding=\"" << (encoding == Encoding::RAW ? "raw" : "base64") << "\">\n"
+               << "   _";
+
+        std::stringstream strstr;
+        strstr << filename << "_" << std::setfill('0') << std::setw(4) << iteration << ".vtu";
+        std::ofstream file(strstr.str(), std::ios::binary);
+        if (!file) {
+            SPDLOG_ERROR("Could not open {} for writing", strstr.str());
+            return;
+        }
+        const std::string headerString = header.str();
+        file.write(headerString.data(), static_cast<std::streamsize>(headerString.size()));
+        file.write(appended.data(), static_cast<std::streamsize>(appended.size()));
+        file << "\n  </AppendedData>\n</VTKFile>\n";
+    }
+
+    std::string VTKBinaryWriter::toString() {
+        return encoding == Encoding::RAW ? "VTKBinaryWriter(raw)" : "VTKBinaryWriter(base64)";
+    }
+
+    VTKBinaryWriter::Encoding VTKBinaryWriter::getEncoding() const {
+        return encoding;
+    }
+
+    VTKBinaryWriter::Precision VTKBinaryWriter::getPrecision() const {
+        return precision;
+    }
+} // namespace outputWriters
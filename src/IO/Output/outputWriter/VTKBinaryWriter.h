@@ -0,0 +1,113 @@
+//
+// VTKBinaryWriter.h
+//
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "OutputWriter.h"
+
+namespace outputWriters {
+    /**
+     * @brief Writes the same .vtu files as the VTKWriter, but with the data arrays in binary form.
+     *
+     * The arrays are stored in the appended data section of the file (format="appended") and are
+     * converted directly from the particle storage, without building the xsd object tree. Every array
+     * is preceded by a UInt64 header with its size in bytes, as expected by ParaView.
+     */
+    class VTKBinaryWriter : public OutputWriter {
+    public:
+        /**
+         * @brief encoding of the appended data section
+         */
+        enum class Encoding {
+            /** plain bytes in host byte order, smallest files and fastest to write */
+            RAW,
+            /** base64 encoded bytes, the file stays valid XML */
+            BASE64
+        };
+
+        /**
+         * @brief type of the floating point arrays
+         */
+        enum class Precision {
+            FLOAT32,
+            FLOAT64
+        };
+
+        /**
+         * @brief Constructor of the VTKBinaryWriter
+         * @param encoding encoding of the appended data section
+         * @param precision type of the mass, velocity, force and position arrays
+         */
+        explicit VTKBinaryWriter(Encoding encoding = Encoding::RAW, Precision precision = Precision::FLOAT32);
+
+        ~VTKBinaryWriter() override = default;
+
+        /**
+         * @brief writes mass, velocity, force, type and position of every particle to filename_iteration.vtu
+         * @param iteration the number of the current iteration, which is used to generate an unique filename
+         * @param particleContainer the particles to be written
+         * @param filename the base name of the file to be written
+         */
+        void plotParticles(int iteration, ParticleContainers::ParticleContainer &particleContainer, const std::string &filename) override;
+
+        std::string toString() override;
+
+        /**
+         * @return encoding of the appended data section
+         */
+        Encoding getEncoding() const;
+
+        /**
+         * @return type of the floating point arrays
+         */
+        Precision getPrecision() const;
+
+    private:
+        Encoding encoding;
+        Precision precision;
+
+        /**
+         * @brief content of the appended data section, kept between calls to reuse the memory
+         */
+        std::string appended;
+
+        /**
+         * @brief size header and binary data of the array that is currently converted
+         */
+        std::vector<unsigned char> scratch;
+
+        /**
+         * @brief converts the interleaved components of an array to T and adds it to the appended data section
+         * @param components one array per component, all of length numTuples
+         * @param numTuples number of values per component
+         * @return offset of the array inside the appended data section
+         */
+        template<typename T, typename S>
+        size_t appendArray(std::initializer_list<const S *> components, size_t numTuples);
+
+        /**
+         * @brief adds the floating point array with the configured precision
+         * @return offset of the array inside the appended data section
+         */
+        size_t appendFloatArray(std::initializer_list<const double *> components, size_t numTuples);
+
+        /**
+         * @brief fills in the size header of scratch and adds it to the appended data section
+         */
+        void appendBlock();
+    };
+
+    /**
+     * @brief base64 encodes length bytes and appends them to out
+     * @param data bytes to encode
+     * @param length number of bytes
+     * @param out string the encoded characters are appended to
+     */
+    void appendBase64(const unsigned char *data, size_t length, std::string &out);
+} // namespace outputWriters
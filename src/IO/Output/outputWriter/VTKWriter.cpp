@@ -56,7 +56,7 @@ namespace outputWriters {
         delete vtkFile;
     }
 
-    void VTKWriter::plotParticle(Particle &p) {
+    void VTKWriter::plotParticle(const ParticleRef &p) {
         if (vtkFile->UnstructuredGrid().present()) {
             //std::cout << "UnstructuredGrid is present" << std::endl;
         } else {
@@ -35,7 +35,7 @@ namespace outputWriters {
          *
          * @note: initializeOutput() must have been called before.
          */
-        void plotParticle(Particle &p);
+        void plotParticle(const ParticleRef &p);
 
         /**
          * writes the final output file.
@@ -24,8 +24,7 @@ namespace outputWriters {
                 << std::endl;
         SPDLOG_TRACE("XYZ Writer plotParticlesFromContainer: plotting particles in iteration {}", iteration);
         for (auto it = particleContainer.begin(); it != particleContainer.end(); ++it) {
-            const Particle &p = *it;
-            std::array<double, 3> x = p.getX();
+            std::array<double, 3> x = it->getX();
             file << "Ar ";
             file.setf(std::ios_base::showpoint);
 
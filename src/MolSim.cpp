@@ -18,9 +18,14 @@
  * - deltaT value (-d <double value>)
  * - endTime (-e <double value>)
  * - vtk output (-o VTK)
+ * - binary vtk output (-o VTK-RAW or -o VTK-BASE64)
  * - xyz output (-o XYZ)
  * - logLevel (-l {logLevel})
  * - calculator (-c {calculator})
+ * - number of buffered output snapshots (--outputBuffers {buffers})
+ * - checkpoints (--checkpointFrequency {iterations}, --checkpointFile {path}, --restart {path})
+ * - times of the phases (--timingFrequency {iterations}, --timingFile {path})
+ * - automatic container configuration (-p AUTO, --tuningFrequency {iterations}, --tuningSteps {steps})
  *
  * Returns 1 if there is no input file or wrong parameters are used.
  *
@@ -38,13 +43,28 @@ int main(int argc, char *argsv[]) {
     std::unique_ptr<Calculators::Calculator> calculator;
     std::unique_ptr<ParticleContainers::ParticleContainer> particleContainer;
     std::unique_ptr<BoundaryHandler> boundaryHandler;
+    int outputBuffers;
+    MolSim::CheckpointOptions checkpointOptions;
+    MolSim::TimingOptions timingOptions;
+    MolSim::TuningOptions tuningOptions;
+    SimulationState state;
     //parses and sets arguments from the command line
-    if (!MolSim::parseArguments(argc, argsv, inputFile, deltaT, endTime, outputWriter, calculator, particleContainer, boundaryHandler)) {
+    if (!MolSim::parseArguments(argc, argsv, inputFile, deltaT, endTime, outputWriter, calculator, particleContainer, boundaryHandler, outputBuffers, checkpointOptions, timingOptions, tuningOptions)) {
         return 1;
        }
 
+    //continue a checkpoint or read the particles from the input file
+    if (!checkpointOptions.restartFile.empty()) {
+        try {
+            state = Checkpoint::read(checkpointOptions.restartFile, particleContainer, boundaryHandler, *calculator);
+        } catch (const std::exception &e) {
+            SPDLOG_ERROR("Failed to restart: {}", e.what());
+            return 1;
+        }
+        deltaT = state.deltaT;
+    }
     //if the specified input file is xml, overwrite and set new arguments
-    if (inputFile.compare(inputFile.length() - 4, 4, ".xml") == 0) {
+    else if (inputFile.compare(inputFile.length() - 4, 4, ".xml") == 0) {
         std::ifstream file(inputFile);
         if (XMLfileReader::parseXMLFromFile(file,deltaT,endTime, freq, outputWriter,calculator, particleContainer, boundaryHandler))
             return 1;
@@ -54,11 +74,17 @@ int main(int argc, char *argsv[]) {
         fileReader.readFile(*particleContainer, inputFile);
     }
 
+    //overlap writing the output with the simulation
+    if (outputBuffers > 0) {
+        outputWriter = std::make_unique<outputWriters::AsyncOutputWriter>(std::move(outputWriter), outputBuffers);
+    }
+
 
     SPDLOG_INFO("Hello from MolSim for PSE!");
     SPDLOG_INFO("Simulation starting! deltaT = {}, endTime = {}", deltaT, endTime);
 
-    MolSim::runSim(*particleContainer, deltaT, endTime, freq, outputWriter, calculator, boundaryHandler);
+    MolSim::runSim(*particleContainer, deltaT, endTime, freq, outputWriter, calculator, boundaryHandler, checkpointOptions,
+                   state.time, state.iteration, timingOptions, tuningOptions);
 
     SPDLOG_DEBUG("Simulation finished!");
   
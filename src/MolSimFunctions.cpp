@@ -7,13 +7,26 @@
 #include <memory>
 #include <stdexcept>
 #include <exception>
+#include <csignal>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+    /** set by the SIGTERM handler, the simulation writes a checkpoint and stops after the current iteration */
+    volatile std::sig_atomic_t terminationRequested = 0;
+
+    extern "C" void requestTermination(int /*signal*/) {
+        terminationRequested = 1;
+    }
+}
 
 void MolSim::printHelp() {
     std::cout << R"(
 Welcome to MolSim helper!
 If you want to execute the simulation, the program call has to follow this format:
 
-    './MolSim -i .{INPUT_PATH} -c {CALCULATOR} -p {PARTICLE_CONTAINER} -d {DELTA_T} -e {END_TIME} -o {OUTPUT_WRITER} -l {LOG_LEVEL} -s {DOMAIN_SIZE} -r {CUTOFF_RADIUS} -b {BOUNDARY_CONDITION}
+    './MolSim -i .{INPUT_PATH} -c {CALCULATOR} -p {PARTICLE_CONTAINER} -d {DELTA_T} -e {END_TIME} -o {OUTPUT_WRITER} -l {LOG_LEVEL} -s {DOMAIN_SIZE} -r {CUTOFF_RADIUS} -b {BOUNDARY_CONDITION} --skin {SKIN} --rebuildFrequency {REBUILD_FREQUENCY} --cellSizeFactor {CELL_SIZE_FACTOR} --theta {THETA} -t {THREADS} --outputBuffers {OUTPUT_BUFFERS} --checkpointFrequency {CHECKPOINT_FREQUENCY} --checkpointFile {CHECKPOINT_FILE} --timingFrequency {TIMING_FREQUENCY} --timingFile {TIMING_FILE} --tuningFrequency {TUNING_FREQUENCY} --tuningSteps {TUNING_STEPS} --potential {POTENTIAL} --tableSize {TABLE_SIZE}
 or
 
     './MolSim --input=.{INPUT_PATH} --calculator={CALCULATOR} --particleContainer={PARTICLE_CONTAINER} --deltaT={DELTA_T} -endTime={END_TIME} --output={OUTPUT_WRITER} --logLevel={LOG_LEVEL}' --domainSize={DOMAIN_SIZE} --cutoffRadius={CUTOFF_RADIUS} --boundaryCondition={BOUNDARY_CONDITION}
@@ -27,6 +40,12 @@ Example calls:
     './MolSim --input=../input/eingabe-sonne.txt --calculator=Default --deltaT=0.014 --endTime=1000 --output=XYZ --logLevel=info --particleContainer=DSC'
     './MolSim -i ../input/cuboid-example.txt -c LJC -o VTK -d 0.0002 -e 5 -p DSC'
     './MolSim -i ../input/disc-example.txt -c LJC -o VTK -d 0.00005 -e 10 -p LCC -r 3.0 -s 120,50,1 -b 0,0,0,1,0,0'
+    './MolSim -i ../input/eingabe-sonne.txt -c Default -p BH --theta 0.5'
+    './MolSim -i ../input/disc-example.txt -c LJC -d 0.00005 -e 10 -p LCC -s 120,50,1 --checkpointFrequency 10000'
+    './MolSim --restart MD.checkpoint -c LJC -e 20'
+    './MolSim -i ../input/disc-example.txt -c LJC -d 0.00005 -e 10 -p LCC -s 120,50,1 --timingFrequency 1000 --timingFile timing.csv'
+    './MolSim -i ../input/disc-example.txt -c LJC -d 0.00005 -e 10 -p AUTO -s 120,50,1 --tuningFrequency 20000'
+    './MolSim -i ../input/cuboid-example.txt -c TAB --potential Morse:5,1.5,1.1225 -d 0.0002 -e 5 -p LCC -r 3.0'
 
 The output should be in the build directory.
 
@@ -36,15 +55,36 @@ Compulsory arguments:
 
     '{INPUT_PATH}': Path to the input file. For example, '-i ../input/eingabe-sonne.txt' or '--input=../input/cuboid-example.txt' or '--input=../input/schema.xml'.
 
-    '{OUTPUT_WRITER}': Specifies which output writer will be used. Either VTK or XYZ has to be chosen. Examples: "-o VTK" or "--output=XYZ"
+    Particles can also be read from a binary '.bin' file, which is loaded without any parsing. It starts with the 8 bytes "MOLSIMPT", the version 1 and the byte order mark 0x01020304 (uint32 each) and the number of particles (uint64), followed by the arrays x, y, z, vx, vy, vz, m (double) and type (int32) in the byte order of the machine.
+
+    '{OUTPUT_WRITER}': Specifies which output writer will be used. Either VTK, VTK-RAW, VTK-BASE64 or XYZ has to be chosen. Examples: "-o VTK" or "--output=XYZ"
+    VTK-RAW and VTK-BASE64 write the .vtu arrays as appended binary data, which is smaller and much faster to write than the ASCII output of VTK.
 
-    '{PARTICLE_CONTAINER}': Specifies what kind of particle container to use. Either LCC (LinkedCellContainer) or DSC (DirectSumContainer) has to be chosen. Examples: "-p LCC" or "--particleContainer=DSC".
+    '{PARTICLE_CONTAINER}': Specifies what kind of particle container to use. Either LCC (LinkedCellContainer), DSC (DirectSumContainer), BH (BarnesHutContainer, only with the 'Default' gravity calculator) or AUTO has to be chosen. AUTO is a LinkedCellContainer that times a few steps with cells of 1, 1/2 and 1/3 of the cutoff radius and with Verlet lists of different skins at the start and continues with the fastest configuration, the forces do not depend on the choice. Examples: "-p LCC" or "--particleContainer=DSC".
 
 Optional arguments:
         '{CALCULATOR}': Specifies which calculator will be used druing the program execution. If no calculator is specified
         the default calculator will be used. The argument has to be passed with a valid calculator type with the following format:
         '-c {calculator type}' or '--calculator={calculator type}'
-        The implemented calculators right now are 'Default' and 'LJC'
+        The implemented calculators right now are 'Default', 'LJC', 'LJC-SIMD' and 'TAB'.
+        'LJC-SIMD' computes the Lennard-Jones forces of the LinkedCellContainer with AVX-512 or AVX2 depending on the CPU
+        and falls back to the scalar kernel if neither is available
+        The Lennard-Jones calculators use epsilon = 5 and sigma = 1 for every particle type. In xml input files every particle,
+        cuboid and disc can set the optional `type`, `epsilon` and `sigma` elements, different types are mixed with the
+        Lorentz-Berthelot rules
+        'TAB' looks the forces up in tables of a pair potential, see {POTENTIAL}. Every pair costs the same for every potential.
+
+        '{POTENTIAL}': Pair potential of the 'TAB' calculator, truncated at the cutoff radius and shifted to 0 there. Either 'LJ'
+        (epsilon = 5, sigma = 1), 'LJ:{epsilon},{sigma}', 'Morse:{D},{a},{r0}' for D (exp(-2a (r - r0)) - 2 exp(-a (r - r0))),
+        'Mie:{epsilon},{sigma},{n},{m}' or 'file:{path}' for a text file with the columns r, U(r) and -dU/dr that covers the cutoff radius.
+        The force and the potential are tabulated on r^2 from sigma / 2 (r0 / 2, the first r of the file) to the cutoff radius
+        and interpolated with cubic polynomials. The same potential is used for all particle types. The argument has to be passed
+        following the format: '--potential {potential}'. If no value is specified, 'LJ' is used. In xml input files the potential
+        is set with the optional `potential` element of `calculator`.
+
+        '{TABLE_SIZE}': Number of intervals of the tables of the 'TAB' calculator. The argument has to be passed with a positive
+        number following the format: '--tableSize {size}'. If no value is specified, 2048 is used. In xml input files the size is set
+        with the optional `tableSize` element of `calculator`.
 
         '{DELTA_T}': Time step which will be used for the simulation. The argument has to be passed with a positive number
         following the format: '-d {positive number}' or '--deltaT {positive number}'
@@ -62,7 +102,7 @@ Optional arguments:
 
         '{DOMAIN_SIZE'}: The size of the domain used. This is only effective when using LCC as particle container. 
         The domain size must consist of three positive values seperated by commas. If no domain size is specified and LCC is chosen, 
-        a default size of 180,90,1 will be used. 
+        a default size of 180,90,1 will be used. If the last dimension is larger than the cutoff radius (plus skin), the LinkedCellContainer uses a three dimensional cell grid with six boundaries, otherwise a single layer of cells. 
         The argument has to be passed with the following format: '-s {domainSize} or '--domainSize {domainSize}', 
         where domain has the format {x},{y},{z}.
 
@@ -70,11 +110,71 @@ Optional arguments:
         following the format: '-r {radius}' or '--cutoffRadius {radius}'. If no radius is specified, a default radius of 3 will be used.
 
         '{BOUNDARY_CONDITION}': The boundary condition that will be used by the LinkedCellContainer. Setting this when LCC is not selected will cause an error. 
-        The boundary condition consists of six values seperated by commas, each of them determines one boundary and possible values are 0 for ourflow and 1 for reflecting. 
+        The boundary condition consists of six values seperated by commas, each of them determines one boundary and possible values are 0 for ourflow, 1 for reflecting and 2 for periodic. 
+        Periodic boundaries have to be set on both sides of an axis and need a domain of at least two cutoff radii along it. Particles leaving the domain enter it at the opposite side and interact with the particles there. The Verlet list is disabled for periodic boundaries.
         The argument has to be passed with the following format: '-b {boundaryCondition}' or '--boundaryCondition {boundaryCondition}', 
         where boundaryCondition has the following format: {left},{right},{top},{bottom},{front},{back}. 
         If no value is specified, outflow will be used for all boundaries.
 
+        '{SKIN}': Enables Verlet lists for the LinkedCellContainer. Pairs within cutoff radius + skin are stored and reused
+        until a particle moved further than skin / 2. The argument has to be passed with a non-negative number
+        following the format: '--skin {skin}'. If no skin is specified, 0 is used and the Verlet list is disabled.
+
+        '{REBUILD_FREQUENCY}': Number of iterations after which the Verlet list is rebuilt even if no particle moved
+        further than skin / 2. The argument has to be passed with a non-negative number following the format:
+        '--rebuildFrequency {frequency}'. If no value or 0 is specified, the list is only rebuilt on displacement.
+
+        '{CELL_SIZE_FACTOR}': Edge length of the cells of the LinkedCellContainer relative to the cutoff radius (plus skin), in (0, 1].
+        With 0.5 or 1/3 the cells are half or a third of the cutoff radius wide and the stencil reaches 2 or 3 cells in every direction,
+        cells that are entirely further away than the cutoff radius are skipped. This checks fewer pairs beyond the cutoff radius
+        but visits more cells, which pays off if a cell of the cutoff radius holds many particles, e.g. for large cutoff radii. The argument has to be passed following the format: '--cellSizeFactor {factor}'.
+        If no value is specified, 1 is used. In xml input files the factor is set with the optional `cellSizeFactor` element of `container`.
+
+        '{THETA}': Opening angle of the BarnesHutContainer. A node of the tree with edge length s at distance d acts as a single
+        particle with the total mass of the node if s / d < theta. Larger values are faster and less accurate, 0 computes all pairs exactly.
+        The argument has to be passed with a non-negative number following the format: '--theta {theta}'. If no value is specified, 0.5 is used.
+        In xml input files theta is set with the optional `theta` element of `container`.
+
+        '{THREADS}': Number of OpenMP threads used for the force calculation of the LinkedCellContainer. The argument has to be
+        passed with a positive number following the format: '-t {threads}' or '--threads {threads}'.
+        If no value is specified, OpenMP decides (usually one thread per core, see OMP_NUM_THREADS).
+        The forces and the trajectory do not depend on the number of threads.
+
+        '{OUTPUT_BUFFERS}': Number of snapshots of the particles that can wait for the output writer. With a positive number the
+        files are written by a background thread while the simulation continues, if all snapshots are still waiting the simulation
+        waits for the writer. 0 writes the files synchronously. The argument has to be passed with a non-negative number following
+        the format: '--outputBuffers {buffers}'. If no value is specified, 2 is used. The files do not depend on this value.
+
+        '{CHECKPOINT_FREQUENCY}': Number of iterations after which the complete state of the simulation is written to the checkpoint
+        file. The argument has to be passed with a non-negative number following the format: '--checkpointFrequency {frequency}'.
+        If no value or 0 is specified, a checkpoint is only written when the program receives SIGTERM, it then stops after the
+        current iteration.
+
+        '{CHECKPOINT_FILE}': Path of the checkpoint file, the format is '--checkpointFile {path}'. If no path is specified, MD.checkpoint is used.
+
+        '--restart {CHECKPOINT_FILE}': Continues the simulation stored in a checkpoint instead of reading an input file. Particles,
+        container, domain size, cutoff radius, boundary conditions, the Lennard-Jones parameters, deltaT, time and iteration
+        are taken from the checkpoint, the calculator, the end time and the output are set as usual. The continued simulation
+        gives the same results as an uninterrupted one.
+
+        '{TIMING_FREQUENCY}': Number of iterations after which the time spent in every phase of the loop (position update, force
+        calculation, boundaries, output, checkpoints, tuning) since the last line and the molecule updates per second are appended to the
+        timing file. The argument has to be passed with a non-negative number following the format: '--timingFrequency {frequency}'.
+        If no value or 0 is specified, no timing file is written. Independent of this argument a summary with total, mean, median,
+        90th and 99th percentile and maximum of every phase is logged at the end of the simulation. Both require the phase timers
+        (cmake option PHASE_TIMERS, enabled by default).
+
+        '{TIMING_FILE}': Path of the timing file, the format is '--timingFile {path}'. The file is a CSV file, or has one JSON object
+        per line if the path ends with .json. If no path is specified, MD_timing.csv is used.
+
+        '{TUNING_FREQUENCY}': Number of iterations after which the configuration of the container is selected again, e.g. because
+        the density changed. Only effective with '-p AUTO'. The argument has to be passed with a non-negative number following the
+        format: '--tuningFrequency {frequency}'. If no value or 0 is specified, the configuration is only selected at the start.
+
+        '{TUNING_STEPS}': Number of steps every configuration is timed for by '-p AUTO'. The steps run on a copy of the particles
+        and do not advance the simulation. The argument has to be passed with a positive number following the format:
+        '--tuningSteps {steps}'. If no value is specified, 10 is used.
+
     )" << std::endl;
 }
 
@@ -83,7 +183,9 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
                             std::unique_ptr<outputWriters::OutputWriter> &outputWriter,
                             std::unique_ptr<Calculators::Calculator> &calculator,
                             std::unique_ptr<ParticleContainers::ParticleContainer> &particleContainer,
-                            std::unique_ptr<BoundaryHandler> &boundaryHandler) {
+                            std::unique_ptr<BoundaryHandler> &boundaryHandler, int &outputBuffers,
+                            CheckpointOptions &checkpointOptions, TimingOptions &timingOptions,
+                            TuningOptions &tuningOptions) {
     cxxopts::Options options("MolSim", "Molecular Simulation Of Group G WS24");
 
     options.add_options()
@@ -91,13 +193,28 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
             ("i,input", "input file path", cxxopts::value<std::string>())
             ("d,deltaT", "Set deltaT", cxxopts::value<double>()->default_value("0.014"))
             ("e,endTime", "Set endTime", cxxopts::value<double>()->default_value("1000"))
-            ("o,output", "Set Outputwriter (VTK or XYZ)", cxxopts::value<std::string>())
+            ("o,output", "Set Outputwriter (VTK, VTK-RAW, VTK-BASE64 or XYZ)", cxxopts::value<std::string>())
             ("c,calculator", "Set Calculator", cxxopts::value<std::string>())
+            ("potential", "Set potential of the tabulated calculator", cxxopts::value<std::string>()->default_value("LJ"))
+            ("tableSize", "Set number of intervals of the potential table", cxxopts::value<int>()->default_value("2048"))
             ("l,logLevel", "Set log level", cxxopts::value<std::string>())
             ("p, particleContainer", "Set particle container", cxxopts::value<std::string>())
             ("s, domainSize" , "Set domain size", cxxopts::value<std::vector<double>>()->default_value("180,90,1"))
             ("r, cutoffRadius", "Set cutoff radius", cxxopts::value<double>()->default_value("3."))
-            ("b, boundaryCondition", "Set boundary condition", cxxopts::value<std::vector<bool>>())
+            ("b, boundaryCondition", "Set boundary condition", cxxopts::value<std::vector<int>>())
+            ("skin", "Set Verlet list skin", cxxopts::value<double>()->default_value("0"))
+            ("rebuildFrequency", "Set Verlet list rebuild frequency", cxxopts::value<int>()->default_value("0"))
+            ("cellSizeFactor", "Set edge length of the cells relative to the cutoff radius", cxxopts::value<double>()->default_value("1"))
+            ("theta", "Set Barnes-Hut opening angle", cxxopts::value<double>()->default_value("0.5"))
+            ("t, threads", "Set number of threads", cxxopts::value<int>())
+            ("outputBuffers", "Set number of snapshots buffered for the output thread", cxxopts::value<int>()->default_value("2"))
+            ("checkpointFrequency", "Set number of iterations between checkpoints", cxxopts::value<int>()->default_value("0"))
+            ("checkpointFile", "Set checkpoint file", cxxopts::value<std::string>()->default_value("MD.checkpoint"))
+            ("restart", "Continue from checkpoint file", cxxopts::value<std::string>())
+            ("timingFrequency", "Set number of iterations between lines of the timing file", cxxopts::value<int>()->default_value("0"))
+            ("timingFile", "Set timing file", cxxopts::value<std::string>()->default_value("MD_timing.csv"))
+            ("tuningFrequency", "Set number of iterations between two tunings of the container", cxxopts::value<int>()->default_value("0"))
+            ("tuningSteps", "Set number of steps every configuration of the container is timed for", cxxopts::value<int>()->default_value("10"))
 
     ;
 
@@ -137,34 +254,96 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
     }
 
 
-    //set the input file
-    if (parseResult.count("input")) {
-        inputFile = parseResult["input"].as<std::string>();
-        SPDLOG_DEBUG("Input file is: {}", inputFile);
+    if (parseResult.count("threads")) {
+        int threads = parseResult["threads"].as<int>();
+        if (threads <= 0) {
+            SPDLOG_ERROR("Number of threads must be greater than zero");
+            printHelp();
+            return false;
+        }
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+        SPDLOG_DEBUG("Number of threads was set to {}", threads);
+#else
+        if (threads > 1) {
+            SPDLOG_WARN("MolSim was built without OpenMP, running with one thread");
+        }
+#endif
     }
 
-    //check if the input file ends with ".txt"
-    if (inputFile.length() < 5 || (inputFile.compare(inputFile.length() - 4, 4, ".txt") != 0 && inputFile.compare(inputFile.length() - 4, 4, ".xml") != 0)) {
-        SPDLOG_ERROR("Invalid input path! Input file must be a '.txt' file");
+    outputBuffers = parseResult["outputBuffers"].as<int>();
+    if (outputBuffers < 0) {
+        SPDLOG_ERROR("Number of output buffers must not be negative");
         printHelp();
         return false;
     }
 
-    //check if the input file exists
-    std::ifstream file(inputFile);
-    if (!file) {
-        SPDLOG_ERROR("Failed to open input file {}, check if the spelling is correct!", inputFile);
+    checkpointOptions.frequency = parseResult["checkpointFrequency"].as<int>();
+    checkpointOptions.file = parseResult["checkpointFile"].as<std::string>();
+    if (checkpointOptions.frequency < 0) {
+        SPDLOG_ERROR("Checkpoint frequency must not be negative");
         printHelp();
         return false;
     }
-
-    file.seekg(0, std::ios::end);
-    if (file.tellg() == 0) {
-        SPDLOG_ERROR("Failed to read input file {}! Input file is empty", inputFile);
+    timingOptions.frequency = parseResult["timingFrequency"].as<int>();
+    timingOptions.file = parseResult["timingFile"].as<std::string>();
+    if (timingOptions.frequency < 0) {
+        SPDLOG_ERROR("Timing frequency must not be negative");
         printHelp();
         return false;
     }
-    file.close();
+    if (timingOptions.frequency > 0 && !PhaseTimers::enabled) {
+        SPDLOG_WARN("The phase timers are disabled in this build, no timing file is written");
+    }
+    tuningOptions.frequency = parseResult["tuningFrequency"].as<int>();
+    tuningOptions.trialSteps = parseResult["tuningSteps"].as<int>();
+    if (tuningOptions.frequency < 0 || tuningOptions.trialSteps <= 0) {
+        SPDLOG_ERROR("Tuning frequency must not be negative and the number of tuning steps has to be positive");
+        printHelp();
+        return false;
+    }
+    if (parseResult.count("restart")) {
+        checkpointOptions.restartFile = parseResult["restart"].as<std::string>();
+        if (parseResult.count("input")) {
+            SPDLOG_ERROR("Either an input file or a checkpoint to restart from can be specified");
+            printHelp();
+            return false;
+        }
+        SPDLOG_DEBUG("Restarting from checkpoint {}", checkpointOptions.restartFile);
+    }
+
+    //set the input file
+    if (parseResult.count("input")) {
+        inputFile = parseResult["input"].as<std::string>();
+        SPDLOG_DEBUG("Input file is: {}", inputFile);
+    }
+
+    //the particles of a restart are read from the checkpoint
+    if (checkpointOptions.restartFile.empty()) {
+        //check if the input file ends with ".txt", ".xml" or ".bin"
+        if (inputFile.length() < 5 || (inputFile.compare(inputFile.length() - 4, 4, ".txt") != 0 && inputFile.compare(inputFile.length() - 4, 4, ".xml") != 0
+                                       && inputFile.compare(inputFile.length() - 4, 4, ".bin") != 0)) {
+            SPDLOG_ERROR("Invalid input path! Input file must be a '.txt', '.xml' or '.bin' file");
+            printHelp();
+            return false;
+        }
+
+        //check if the input file exists
+        std::ifstream file(inputFile);
+        if (!file) {
+            SPDLOG_ERROR("Failed to open input file {}, check if the spelling is correct!", inputFile);
+            printHelp();
+            return false;
+        }
+
+        file.seekg(0, std::ios::end);
+        if (file.tellg() == 0) {
+            SPDLOG_ERROR("Failed to read input file {}! Input file is empty", inputFile);
+            printHelp();
+            return false;
+        }
+        file.close();
+    }
 
     auto domainSize = parseResult["domainSize"].as<std::vector<double>>();
     if (domainSize.size() != 3) {
@@ -183,17 +362,45 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
 
     double cutoffRadius = parseResult["cutoffRadius"].as<double>();
     SPDLOG_DEBUG("Cutoff radius is: {}", cutoffRadius);
+
+    if (parseResult["skin"].as<double>() < 0 || parseResult["rebuildFrequency"].as<int>() < 0) {
+        SPDLOG_ERROR("Skin and rebuild frequency must not be negative");
+        printHelp();
+        return false;
+    }
+
+    double skin = parseResult["skin"].as<double>();
+    int rebuildFrequency = parseResult["rebuildFrequency"].as<int>();
+    SPDLOG_DEBUG("Verlet list skin is: {}, rebuild frequency is: {}", skin, rebuildFrequency);
+    double cellSizeFactor = parseResult["cellSizeFactor"].as<double>();
+    if (!(cellSizeFactor > 0 && cellSizeFactor <= 1)) {
+        SPDLOG_ERROR("Cell size factor has to be in (0, 1]");
+        printHelp();
+        return false;
+    }
+    if (parseResult["theta"].as<double>() < 0) {
+        SPDLOG_ERROR("Theta must not be negative");
+        printHelp();
+        return false;
+    }
+    double theta = parseResult["theta"].as<double>();
     particleContainer = std::make_unique<ParticleContainers::DirectSumContainer>(); //default
     bool LCCset = false;
     if (parseResult.count("particleContainer")) {
         std::string containerType = parseResult["particleContainer"].as<std::string>();
         if (containerType == "DSC") {
             particleContainer = std::make_unique<ParticleContainers::DirectSumContainer>();
-        } else if (containerType == "LCC") {
-            particleContainer = std::make_unique<ParticleContainers::LinkedCellContainer>(domainSizeArray, cutoffRadius);
-            std::array<bool, 6> cond = {0,0,0,0,0,0};
+        } else if (containerType == "LCC" || containerType == "AUTO") {
+            particleContainer = std::make_unique<ParticleContainers::LinkedCellContainer>(domainSizeArray, cutoffRadius, skin,
+                                                                                          rebuildFrequency, cellSizeFactor);
+            std::array<BoundaryCondition, 6> cond;
+            cond.fill(BoundaryCondition::OUTFLOW);
             boundaryHandler = std::make_unique<BoundaryHandler>(1, cond , *(dynamic_cast <ParticleContainers::LinkedCellContainer*>(&(*particleContainer)))); //default
             LCCset = true;
+            tuningOptions.enabled = containerType == "AUTO";
+        } else if (containerType == "BH") {
+            particleContainer = std::make_unique<ParticleContainers::BarnesHutContainer>(theta);
+            SPDLOG_DEBUG("Barnes-Hut opening angle is: {}", theta);
         } else {
             SPDLOG_ERROR("Invalid container type!");
             printHelp();
@@ -209,13 +416,19 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
         }
 
         try{
-        std::vector<bool> condition = parseResult["boundaryCondition"].as<std::vector<bool>>();
+        std::vector<int> condition = parseResult["boundaryCondition"].as<std::vector<int>>();
 
         if (condition.size() != 6) {
             throw std::runtime_error("");
         }
-        
-        std::array<bool, 6> conditionArray = {condition[0], condition[1], condition[2], condition[3], condition[4], condition[5]};
+
+        std::array<BoundaryCondition, 6> conditionArray{};
+        for (size_t i = 0; i < conditionArray.size(); i++) {
+            if (condition[i] < 0 || condition[i] > static_cast<int>(BoundaryCondition::PERIODIC)) {
+                throw std::runtime_error("");
+            }
+            conditionArray[i] = static_cast<BoundaryCondition>(condition[i]);
+        }
         
         boundaryHandler = std::make_unique<BoundaryHandler>(1, conditionArray, *(dynamic_cast <ParticleContainers::LinkedCellContainer*>(&(*particleContainer)))); //sigma is hardcoded for now
 
@@ -255,6 +468,12 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
         if (outputWriterTemp == "VTK") {
             outputWriter = std::make_unique<outputWriters::VTKWriter>();
             SPDLOG_DEBUG("{} is selected as the output writer", outputWriterTemp);
+        } else if (outputWriterTemp == "VTK-RAW") {
+            outputWriter = std::make_unique<outputWriters::VTKBinaryWriter>(outputWriters::VTKBinaryWriter::Encoding::RAW);
+            SPDLOG_DEBUG("{} is selected as the output writer", outputWriterTemp);
+        } else if (outputWriterTemp == "VTK-BASE64") {
+            outputWriter = std::make_unique<outputWriters::VTKBinaryWriter>(outputWriters::VTKBinaryWriter::Encoding::BASE64);
+            SPDLOG_DEBUG("{} is selected as the output writer", outputWriterTemp);
         } else if (outputWriterTemp == "XYZ") {
             outputWriter = std::make_unique<outputWriters::XYZWriter>();
             SPDLOG_DEBUG("{} is selected as the output writer", outputWriterTemp);
@@ -270,9 +489,28 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
         if (calculatorTemp == "LJC") {
             calculator = std::make_unique<Calculators::LennardJonesCalculator>();
             SPDLOG_DEBUG("{} is selected as the calculator", calculatorTemp);
+        } else if (calculatorTemp == "LJC-SIMD") {
+            calculator = std::make_unique<Calculators::LennardJonesSIMDCalculator>();
+            SPDLOG_DEBUG("{} is selected as the calculator", calculatorTemp);
         } else if (calculatorTemp == "Default") {
             calculator = std::make_unique<Calculators::GravityCalculator>();
             SPDLOG_DEBUG("{} is selected as the calculator", calculatorTemp);
+        } else if (calculatorTemp == "TAB") {
+            if (parseResult["tableSize"].as<int>() <= 0) {
+                SPDLOG_ERROR("The table size of the potential has to be positive");
+                printHelp();
+                return false;
+            }
+            try {
+                calculator = std::make_unique<Calculators::TabulatedCalculator>(
+                        Calculators::TabulatedPotential::fromSpecification(parseResult["potential"].as<std::string>(),
+                                                                           cutoffRadius,
+                                                                           parseResult["tableSize"].as<int>()));
+            } catch (const std::invalid_argument &) {
+                printHelp();
+                return false;
+            }
+            SPDLOG_DEBUG("{} is selected as the calculator", calculatorTemp);
         } else {
             SPDLOG_ERROR("Erroneous programme call! Invalid calculator specified!");
             printHelp();
@@ -280,6 +518,13 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
         }
     }
 
+    if (dynamic_cast<ParticleContainers::BarnesHutContainer *>(particleContainer.get()) != nullptr &&
+        dynamic_cast<Calculators::GravityCalculator *>(calculator.get()) == nullptr) {
+        SPDLOG_ERROR("The Barnes-Hut container can only be used with the Default calculator");
+        printHelp();
+        return false;
+    }
+
 
 
     
@@ -290,29 +535,84 @@ bool MolSim::parseArguments(int argc, char *argv[], std::string &inputFile, doub
 void MolSim::runSim(ParticleContainers::ParticleContainer &particleContainer, double &deltaT, double &endTime, int &freq,
                     std::unique_ptr<outputWriters::OutputWriter> &outputWriter,
                     std::unique_ptr<Calculators::Calculator> &calculator,
-                    std::unique_ptr<BoundaryHandler> &boundaryHandler) {            
+                    std::unique_ptr<BoundaryHandler> &boundaryHandler,
+                    const CheckpointOptions &checkpointOptions, double startTime, int startIteration,
+                    const TimingOptions &timingOptions, const TuningOptions &tuningOptions) {
 
 
     const std::string outName = "MD";
 
-    double currentTime = 0.0;
-    int iteration = 0;
+    double currentTime = startTime;
+    int iteration = startIteration;
+
+    PhaseTimers timers;
+    if (PhaseTimers::enabled) {
+        timers.setDump(timingOptions.file, timingOptions.frequency);
+    }
+
+    auto lcCont = dynamic_cast<ParticleContainers::LinkedCellContainer *>(&particleContainer);
+    if (tuningOptions.enabled && lcCont == nullptr) {
+        SPDLOG_WARN("Only the LinkedCellContainer can be tuned, continuing without tuning");
+    }
+    const bool tuning = tuningOptions.enabled && lcCont != nullptr;
+    const ParticleContainers::ContainerTuner tuner(tuningOptions.trialSteps, tuningOptions.frequency);
+    if (tuning) {
+        TIME_PHASE(timers, Phase::TUNING);
+        tuner.tune(*lcCont, *calculator, deltaT);
+    }
+
+    terminationRequested = 0;
+    auto previousHandler = std::signal(SIGTERM, requestTermination);
 
     while (currentTime < endTime) {
-        calculator->calculateXFV(particleContainer, deltaT);
+        // the particles that are updated in this iteration, outflow removes some of them afterwards
+        const size_t numParticles = particleContainer.sizeParticles();
+        {
+            TIME_PHASE(timers, Phase::POSITION);
+            calculator->calculateXAndSort(particleContainer, deltaT);
+        }
+        {
+            TIME_PHASE(timers, Phase::FORCE);
+            calculator->calculateFV(particleContainer, deltaT);
+        }
         if (boundaryHandler != nullptr){
             SPDLOG_DEBUG("handling boundaries");
+            TIME_PHASE(timers, Phase::BOUNDARY);
             boundaryHandler->handleBoundaries();
         }
 
         iteration++;
 
         if (iteration % freq == 0) {
+            TIME_PHASE(timers, Phase::OUTPUT);
             outputWriter->plotParticles(iteration, particleContainer, outName);
         }
 
        SPDLOG_DEBUG("Iteration {} finished.", iteration);
         currentTime += deltaT;
+
+        const bool terminate = terminationRequested != 0;
+        if (terminate || (checkpointOptions.frequency > 0 && iteration % checkpointOptions.frequency == 0)) {
+            TIME_PHASE(timers, Phase::CHECKPOINT);
+            Checkpoint::write(checkpointOptions.file, particleContainer, boundaryHandler.get(), *calculator,
+                              {currentTime, iteration, deltaT});
+        }
+        if (tuning && tuner.isDue(iteration)) {
+            TIME_PHASE(timers, Phase::TUNING);
+            tuner.tune(*lcCont, *calculator, deltaT);
+        }
+        if (PhaseTimers::enabled) {
+            timers.endIteration(iteration, numParticles);
+        }
+        if (terminate) {
+            SPDLOG_WARN("Received SIGTERM, stopping after iteration {}", iteration);
+            break;
+        }
+    }
+    std::signal(SIGTERM, previousHandler);
+    outputWriter->flush();
+    if (PhaseTimers::enabled) {
+        SPDLOG_INFO("Time per phase:\n{}", timers.summary());
     }
     SPDLOG_INFO("Output written. Terminating...");
 }
@@ -7,20 +7,56 @@
 
 #include "Calculator/Calculator.h"
 #include "Calculator/LennardJonesCalculator.h"
+#include "Calculator/LennardJonesSIMDCalculator.h"
 #include "IO/Input/FileReader.h"
 #include "Objects/Containers/DirectSum/DirectSumContainer.h"
 #include "IO/Output/outputWriter/OutputWriter.h"
+#include "IO/Output/outputWriter/AsyncOutputWriter.h"
 #include "IO/Output/outputWriter/VTKWriter.h"
+#include "IO/Output/outputWriter/VTKBinaryWriter.h"
 #include "IO/Output/outputWriter/XYZWriter.h"
 #include "spdlog/spdlog.h"
 #include "cxxopts.hpp"
 #include "Calculator/GravityCalculator.h"
+#include "Calculator/TabulatedCalculator.h"
 #include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+#include "Objects/Containers/BarnesHut/BarnesHutContainer.h"
 #include "Objects/Containers/LinkedCell/BoundaryHandler.h"
+#include "IO/Checkpoint/Checkpoint.h"
+#include "Objects/Containers/ContainerTuner.h"
+#include "utils/PhaseTimers.h"
 
 /**Provides utility functions for running the simulation */
 namespace MolSim {
 
+/**Options for writing checkpoints and continuing from them */
+struct CheckpointOptions {
+    /** checkpoint the simulation continues from, empty to start from the input file */
+    std::string restartFile;
+    /** path of the checkpoints written during the simulation */
+    std::string file = "MD.checkpoint";
+    /** number of iterations between two checkpoints, 0 only writes a checkpoint on SIGTERM */
+    int frequency = 0;
+};
+
+/**Options for the timing file of the phase timers */
+struct TimingOptions {
+    /** path of the timing file, a CSV file or one JSON object per line if it ends with .json */
+    std::string file = "MD_timing.csv";
+    /** number of iterations between two lines of the timing file, 0 disables the file */
+    int frequency = 0;
+};
+
+/**Options for the automatic selection of the container configuration (-p AUTO) */
+struct TuningOptions {
+    /** true if the LinkedCellContainer is tuned */
+    bool enabled = false;
+    /** number of steps every configuration is timed for */
+    int trialSteps = 10;
+    /** number of iterations between two tunings, 0 only tunes at the start */
+    int frequency = 0;
+};
+
 /**Prints the help message to std::out */
 void printHelp();
 
@@ -33,12 +69,18 @@ void printHelp();
  * @param outputWriter that will be used to write the output
  * @param calculator that will be used during the simulation
  * @particleContainer empty ParticleContainer
+ * @param outputBuffers number of snapshots buffered for the output thread, 0 for synchronous output
+ * @param checkpointOptions when to write checkpoints and which checkpoint to continue from
+ * @param timingOptions when and where to write the times of the phases of the simulation loop
+ * @param tuningOptions whether and how often the container is tuned
  */
 bool parseArguments(int argc, char *argv[], std::string &inputFile, double &deltaT, double &endTime,
                             std::unique_ptr<outputWriters::OutputWriter> &outputWriter,
                             std::unique_ptr<Calculators::Calculator> &calculator,
                             std::unique_ptr<ParticleContainers::ParticleContainer> &particleContainer,
-                            std::unique_ptr<BoundaryHandler> &boundaryHandler);
+                            std::unique_ptr<BoundaryHandler> &boundaryHandler, int &outputBuffers,
+                            CheckpointOptions &checkpointOptions, TimingOptions &timingOptions,
+                            TuningOptions &tuningOptions);
 
 /**Runs the simulation using the specified parameters 
  * @particleContainer initialized ParticleContainer
@@ -46,9 +88,20 @@ bool parseArguments(int argc, char *argv[], std::string &inputFile, double &delt
  * @param endTime
  * @param outputWriter that will be used to write the output
  * @param calculator that will be used during the simulation
+ * @param checkpointOptions when and where to write checkpoints
+ * @param startTime simulated time the simulation continues from
+ * @param startIteration number of iterations already done
+ * @param timingOptions when and where to write the times of the phases of the simulation loop
+ * @param tuningOptions whether and how often the configuration of the LinkedCellContainer is selected by timing
+ *
+ * If the phase timers are enabled, a summary of the time per phase and the molecule updates per second is logged at
+ * the end.
+ * On SIGTERM the simulation writes a checkpoint after the current iteration and returns.
 */
 void runSim(ParticleContainers::ParticleContainer &particleContainer, double &deltaT, double &endTime, int &freq,
                     std::unique_ptr<outputWriters::OutputWriter> &outputWriter,
                     std::unique_ptr<Calculators::Calculator> &calculator,
-                    std::unique_ptr<BoundaryHandler> &boundaryHandler);                            
+                    std::unique_ptr<BoundaryHandler> &boundaryHandler,
+                    const CheckpointOptions &checkpointOptions = {}, double startTime = 0.0, int startIteration = 0,
+                    const TimingOptions &timingOptions = {}, const TuningOptions &tuningOptions = {});
 }
\ No newline at end of file
@@ -7,12 +7,12 @@
 #include "spdlog/spdlog.h"
 Cell::Cell(CType cellType) : cellType(cellType) {}
 
-std::vector<Particle*>::iterator Cell::beginParticle() {
-    return particlesInCell.begin();
+Cell::IndexRange::iterator Cell::beginParticle() const {
+    return IndexRange::iterator(particlesBegin);
 }
 
-std::vector<Particle*>::iterator Cell::endParticle() {
-    return particlesInCell.end();
+Cell::IndexRange::iterator Cell::endParticle() const {
+    return IndexRange::iterator(particlesEnd);
 }
 
 std::vector<Cell*>::iterator Cell::beginNeighbourCell() {
@@ -23,16 +23,9 @@ std::vector<Cell*>::iterator Cell::endNeighbourCell() {
     return neighbourCells.end();
 }
 
-std::unordered_set<Cell*>::iterator Cell::beginInfluencedBy() {
-    return influencedBy.begin();
-}
-
-std::unordered_set<Cell*>::iterator Cell::endInfluencedBy() {
-    return influencedBy.end();
-}
-
-void Cell::addParticleToCell(Particle* particle) {
-    particlesInCell.push_back(particle);
+void Cell::setParticleRange(size_t begin, size_t end) {
+    particlesBegin = begin;
+    particlesEnd = end;
 }
 
 
@@ -40,28 +33,20 @@ void Cell::addNeighbourCell(Cell* cell) {
     neighbourCells.push_back(cell);
 }
 
-void Cell::addInfluencedByCell(Cell* cell) {
+void Cell::addForwardNeighbourCell(Cell* cell) {
     if (cell == nullptr) {
-        SPDLOG_DEBUG("Cell::addInfluencedByCell(): cell is null");
+        SPDLOG_DEBUG("Cell::addForwardNeighbourCell(): cell is null");
         return;
     }
-    influencedBy.insert(cell);
+    forwardNeighbourCells.push_back(cell);
 }
 
-std::vector<Particle*> Cell::getParticlesInCell(){return particlesInCell;}
+const std::vector<Cell*> &Cell::getNeighbourCells() const {return neighbourCells;}
 
-std::vector<Cell*> Cell::getNeighbourCells(){return neighbourCells;}
+const std::vector<Cell*> &Cell::getForwardNeighbourCells() const {return forwardNeighbourCells;}
 
 Cell::CType Cell::getCellType(){ return cellType;}
 
-std::unordered_set<Cell *> Cell::getInfluencedByCells() {
-    return influencedBy;
-}
-
-void Cell::clearParticlesInCell() {
-    particlesInCell.clear();
-}
-
 
 
 
@@ -3,7 +3,8 @@
 //
 
 #pragma once
-#include <unordered_set>
+#include <cstddef>
+#include <iterator>
 #include <vector>
 
 #include "Particle.h"
@@ -11,6 +12,64 @@
 /**Class for indicidual Cell in a LinkedCellContainer*/
 class Cell {
 public:
+    /**
+     * @brief A range [begin, end) of consecutive particle storage indices.
+     * Iterating over the range yields the indices themselves.
+     */
+    class IndexRange {
+    public:
+        /**
+         * @brief Iterator over the indices of an IndexRange
+         */
+        class iterator {
+        private:
+            size_t index;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = size_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const size_t *;
+            using reference = size_t;
+
+            explicit iterator(size_t index) : index(index) {}
+
+            size_t operator*() const { return index; }
+
+            iterator &operator++() {
+                ++index;
+                return *this;
+            }
+
+            iterator operator+(difference_type n) const { return iterator(index + n); }
+
+            difference_type operator-(const iterator &other) const {
+                return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+            }
+
+            bool operator==(const iterator &other) const { return index == other.index; }
+
+            bool operator!=(const iterator &other) const { return index != other.index; }
+        };
+
+        IndexRange(size_t beginIndex, size_t endIndex) : beginIndex(beginIndex), endIndex(endIndex) {}
+
+        iterator begin() const { return iterator(beginIndex); }
+
+        iterator end() const { return iterator(endIndex); }
+
+        /**
+         * @return the number of indices in the range
+         */
+        size_t size() const { return endIndex - beginIndex; }
+
+        bool empty() const { return beginIndex == endIndex; }
+
+    private:
+        size_t beginIndex;
+        size_t endIndex;
+    };
+
     /**
      * Enum to define the different cell types
      */
@@ -27,9 +86,15 @@ private:
     CType cellType;
 
     /**
-     * @brief A vector containing references to particles that are withing the cell
+     * @brief Storage index of the first particle within the cell.
+     * The LinkedCellContainer keeps its particles sorted by cell, so the particles of a cell are contiguous.
+     */
+    size_t particlesBegin = 0;
+
+    /**
+     * @brief Storage index past the last particle within the cell.
      */
-    std::vector<Particle*> particlesInCell;
+    size_t particlesEnd = 0;
 
     /**
      * @brief A vector containing references to the current cell's neighbouring cells
@@ -37,9 +102,10 @@ private:
     std::vector<Cell*> neighbourCells;
 
     /**
-     * @brief A set of Cell object references. The cells in this set have influenced the current cell.
+     * @brief The neighbouring cells that come after the current cell in the LinkedCellContainer (half-shell stencil).
+     * Every pair of neighbouring cells appears in exactly one of the two forward neighbour vectors.
      */
-    std::unordered_set<Cell*> influencedBy;
+    std::vector<Cell*> forwardNeighbourCells;
 
 public:
     /**
@@ -50,15 +116,15 @@ public:
 
     /**
      *
-     * @return an iterator to the beginning of the vector containing raw pointers to particles in the cell
+     * @return an iterator to the storage index of the first particle in the cell
      */
-    std::vector<Particle*>::iterator beginParticle();
+    IndexRange::iterator beginParticle() const;
 
     /**
      *
-     * @return an iterator to the end of the vector containing raw pointers to particles in the cell
+     * @return an iterator past the storage index of the last particle in the cell
      */
-    std::vector<Particle*>::iterator endParticle();
+    IndexRange::iterator endParticle() const;
 
    /**
     *
@@ -73,22 +139,11 @@ public:
     std::vector<Cell*>::iterator endNeighbourCell();
 
     /**
-    *
-    * @return an iterator to the beginning of the set containing the cells that have already affected the current cell
-    */
-    std::unordered_set<Cell*>::iterator beginInfluencedBy();
-
-   /**
-    *
-    * @return an iterator to the end of the set containing the cells that have already affected the current cell
-    */
-    std::unordered_set<Cell*>::iterator endInfluencedBy();
-
-    /**
-     * Add a particle reference to the cell.
-     * @param particle is the particle to be added
+     * Set the range of storage indices of the particles within the cell.
+     * @param begin storage index of the first particle in the cell
+     * @param end storage index past the last particle in the cell
      */
-    void addParticleToCell(Particle* particle);
+    void setParticleRange(size_t begin, size_t end);
 
 
     /**
@@ -98,21 +153,22 @@ public:
     void addNeighbourCell(Cell* cell);
 
     /**
-     * Add the passed cell as a reference to the influencedBy vector.
-     * @param cell is the cell to be added as an influencer
+     * Add the passed cell as a reference to the forwardNeighbourCells vector.
+     * @param cell is the cell to be added as a forward neighbour
      */
-    void addInfluencedByCell(Cell* cell);
+    void addForwardNeighbourCell(Cell* cell);
 
     /**
-     * @brief clear the particlesInCell vector for the current cell.
+     * @return the range of storage indices of the particles within the cell
      */
-    void clearParticlesInCell();
-
-    std::vector<Particle*> getParticlesInCell();
+    IndexRange getParticlesInCell() const { return {particlesBegin, particlesEnd}; }
 
-    std::vector<Cell*> getNeighbourCells();
+    const std::vector<Cell*> &getNeighbourCells() const;
 
-    std::unordered_set<Cell*> getInfluencedByCells();
+    /**
+     * @return the neighbouring cells whose pairs with this cell are computed by this cell
+     */
+    const std::vector<Cell*> &getForwardNeighbourCells() const;
 
     CType getCellType();
 };
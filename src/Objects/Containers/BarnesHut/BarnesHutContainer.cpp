@@ -0,0 +1,186 @@
+//
+// BarnesHutContainer.cpp
+//
+
+#include "BarnesHutContainer.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "spdlog/spdlog.h"
+
+namespace ParticleContainers {
+    BarnesHutContainer::BarnesHutContainer(double theta) : theta(theta) {
+        if (theta < 0) {
+            throw std::invalid_argument("The opening angle theta must not be negative");
+        }
+    }
+
+    ParticleIterator BarnesHutContainer::begin() {
+        return particles.begin();
+    }
+
+    ParticleIterator BarnesHutContainer::end() {
+        return particles.end();
+    }
+
+    void BarnesHutContainer::addParticle(const Particle &particle) {
+        SPDLOG_TRACE("adding particle to container");
+        particles.push_back(particle);
+    }
+
+    void BarnesHutContainer::addParticles(const ParticleStorage &newParticles) {
+        SPDLOG_TRACE("adding {} particles to container", newParticles.size());
+        particles.append(newParticles);
+    }
+
+    size_t BarnesHutContainer::sizeParticles() const {
+        return particles.size();
+    }
+
+    std::vector<Particle> BarnesHutContainer::getParticles() const {
+        std::vector<Particle> result;
+        result.reserve(particles.size());
+        for (size_t i = 0; i < particles.size(); ++i) {
+            result.push_back(particles.get(i));
+        }
+        return result;
+    }
+
+    ParticleStorage &BarnesHutContainer::getStorage() {
+        return particles;
+    }
+
+    void BarnesHutContainer::buildTree() {
+        const size_t numParticles = particles.size();
+        nodes.clear();
+        treeOrder.resize(numParticles);
+        std::iota(treeOrder.begin(), treeOrder.end(), 0);
+        partitionBuffer.resize(numParticles);
+        if (numParticles == 0) {
+            return;
+        }
+
+        // the root is the bounding cube of all particles
+        std::array<double, 3> min = {particles.x[0], particles.y[0], particles.z[0]};
+        std::array<double, 3> max = min;
+        for (size_t i = 1; i < numParticles; ++i) {
+            min[0] = std::min(min[0], particles.x[i]);
+            min[1] = std::min(min[1], particles.y[i]);
+            min[2] = std::min(min[2], particles.z[i]);
+            max[0] = std::max(max[0], particles.x[i]);
+            max[1] = std::max(max[1], particles.y[i]);
+            max[2] = std::max(max[2], particles.z[i]);
+        }
+        twoDimensional = min[2] == max[2];
+        double halfSize = 0;
+        std::array<double, 3> center{};
+        for (int d = 0; d < 3; ++d) {
+            center[d] = 0.5 * (min[d] + max[d]);
+            halfSize = std::max(halfSize, 0.5 * (max[d] - min[d]));
+        }
+        if (halfSize == 0) {
+            halfSize = 1;
+        }
+
+        // a balanced tree has about 2 * N / leafCapacity nodes, more if the particles are clustered
+        nodes.reserve(4 * numParticles / leafCapacity + 1);
+        nodes.push_back(Node{center, halfSize, 0, {0, 0, 0}, 0, 0, 0, numParticles});
+        buildNode(0, 0);
+        SPDLOG_TRACE("built Barnes-Hut tree with {} nodes", nodes.size());
+    }
+
+    void BarnesHutContainer::buildNode(size_t nodeIndex, int depth) {
+        const size_t begin = nodes[nodeIndex].particlesBegin;
+        const size_t end = nodes[nodeIndex].particlesEnd;
+
+        if (end - begin <= leafCapacity || depth == maxDepth) {
+            double mass = 0;
+            std::array<double, 3> weighted = {0, 0, 0};
+            for (size_t k = begin; k < end; ++k) {
+                const size_t p = treeOrder[k];
+                mass += particles.m[p];
+                weighted[0] += particles.m[p] * particles.x[p];
+                weighted[1] += particles.m[p] * particles.y[p];
+                weighted[2] += particles.m[p] * particles.z[p];
+            }
+            Node &leaf = nodes[nodeIndex];
+            leaf.mass = mass;
+            leaf.centerOfMass = mass > 0 ? std::array<double, 3>{weighted[0] / mass, weighted[1] / mass, weighted[2] / mass}
+                                         : leaf.center;
+            return;
+        }
+
+        // partition the particles of the node by child with a counting sort, bit d of the child index is set if
+        // the particle lies in the upper half of dimension d
+        const std::array<double, 3> center = nodes[nodeIndex].center;
+        const double childHalfSize = 0.5 * nodes[nodeIndex].halfSize;
+        const int numChildSlots = twoDimensional ? 4 : 8;
+        auto childOf = [this, &center](size_t p) {
+            return (particles.x[p] >= center[0] ? 1 : 0) | (particles.y[p] >= center[1] ? 2 : 0) |
+                   (!twoDimensional && particles.z[p] >= center[2] ? 4 : 0);
+        };
+        std::array<size_t, 9> childStarts{};
+        for (size_t k = begin; k < end; ++k) {
+            childStarts[childOf(treeOrder[k]) + 1]++;
+        }
+        for (int c = 0; c < numChildSlots; ++c) {
+            childStarts[c + 1] += childStarts[c];
+        }
+        std::array<size_t, 8> next{};
+        std::copy(childStarts.begin(), childStarts.begin() + 8, next.begin());
+        for (size_t k = begin; k < end; ++k) {
+            const size_t p = treeOrder[k];
+            partitionBuffer[begin + next[childOf(p)]++] = p;
+        }
+        std::copy(partitionBuffer.begin() + begin, partitionBuffer.begin() + end, treeOrder.begin() + begin);
+
+        // the non-empty children are appended contiguously before any of them is split further
+        const size_t firstChild = nodes.size();
+        for (int c = 0; c < numChildSlots; ++c) {
+            if (childStarts[c] == childStarts[c + 1]) {
+                continue;
+            }
+            const std::array<double, 3> childCenter = {
+                center[0] + (c & 1 ? childHalfSize : -childHalfSize),
+                center[1] + (c & 2 ? childHalfSize : -childHalfSize),
+                twoDimensional ? center[2] : center[2] + (c & 4 ? childHalfSize : -childHalfSize)
+            };
+            nodes.push_back(Node{childCenter, childHalfSize, 0, {0, 0, 0}, 0, 0,
+                                 begin + childStarts[c], begin + childStarts[c + 1]});
+        }
+        const size_t numChildren = nodes.size() - firstChild;
+        nodes[nodeIndex].firstChild = firstChild;
+        nodes[nodeIndex].numChildren = numChildren;
+
+        double mass = 0;
+        std::array<double, 3> weighted = {0, 0, 0};
+        for (size_t child = firstChild; child < firstChild + numChildren; ++child) {
+            buildNode(child, depth + 1);
+            mass += nodes[child].mass;
+            for (int d = 0; d < 3; ++d) {
+                weighted[d] += nodes[child].mass * nodes[child].centerOfMass[d];
+            }
+        }
+        Node &node = nodes[nodeIndex];
+        node.mass = mass;
+        node.centerOfMass = mass > 0 ? std::array<double, 3>{weighted[0] / mass, weighted[1] / mass, weighted[2] / mass}
+                                     : node.center;
+    }
+
+    const std::vector<BarnesHutContainer::Node> &BarnesHutContainer::getNodes() const {
+        return nodes;
+    }
+
+    const std::vector<size_t> &BarnesHutContainer::getTreeOrder() const {
+        return treeOrder;
+    }
+
+    double BarnesHutContainer::getTheta() const {
+        return theta;
+    }
+
+    bool BarnesHutContainer::isTwoDimensional() const {
+        return twoDimensional;
+    }
+}
@@ -0,0 +1,156 @@
+//
+// BarnesHutContainer.h
+//
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Objects/Containers/ParticleContainer.h"
+
+namespace ParticleContainers {
+ /**
+  * @brief Container for the Barnes-Hut algorithm. Extends ParticleContainer
+  *
+  * The particles are organized in an octree (a quadtree if all particles lie in one z plane) that is rebuilt
+  * from the current positions before every force calculation. Every node knows the total mass and the center of
+  * mass of its particles, so a calculator can replace a node that is far away compared to its size by a single
+  * pseudo particle. How far is controlled by the opening angle theta: a node of edge length s at distance d is
+  * used as a whole if s / d < theta. theta = 0 yields the exact direct sum.
+  */
+ class BarnesHutContainer : public ParticleContainer {
+ public:
+  /**
+   * @brief Node of the tree, a cube (square in 2D) of the domain
+   */
+  struct Node {
+   /** geometric center of the node */
+   std::array<double, 3> center;
+   /** half of the edge length */
+   double halfSize;
+   /** total mass of the particles inside the node */
+   double mass;
+   /** center of mass of the particles inside the node */
+   std::array<double, 3> centerOfMass;
+   /** index of the first child in the node vector, the children are stored contiguously */
+   size_t firstChild;
+   /** number of non-empty children, 0 for leaves */
+   size_t numChildren;
+   /** range of the particles of the node in the tree order */
+   size_t particlesBegin, particlesEnd;
+  };
+
+ private:
+  /**
+   * @brief Structure-of-arrays storage for the particles
+   */
+  ParticleStorage particles;
+
+  /**
+   * @brief opening angle of the force calculation
+   */
+  double theta;
+
+  /**
+   * @brief nodes of the tree, the root is the first node
+   */
+  std::vector<Node> nodes;
+
+  /**
+   * @brief storage indices of the particles, ordered such that every node owns a contiguous range
+   */
+  std::vector<size_t> treeOrder;
+
+  /**
+   * @brief buffer for partitioning treeOrder, reused between builds
+   */
+  std::vector<size_t> partitionBuffer;
+
+  /**
+   * @brief true if the tree was built as a quadtree
+   */
+  bool twoDimensional = false;
+
+  /**
+   * @brief maximal number of particles in a leaf
+   */
+  static constexpr size_t leafCapacity = 8;
+
+  /**
+   * @brief splits the node recursively until its children hold at most leafCapacity particles and computes the
+   * mass and center of mass of the node
+   * @param nodeIndex index of the node
+   * @param depth depth of the node, 0 for the root
+   */
+  void buildNode(size_t nodeIndex, int depth);
+
+ public:
+  /**
+   * @brief maximal depth of the tree, deeper nodes become leaves regardless of their size (e.g. for particles
+   * at the same position)
+   */
+  static constexpr int maxDepth = 48;
+
+  /**
+   * @brief Constructor
+   * @param theta opening angle, has to be non-negative
+   */
+  explicit BarnesHutContainer(double theta = 0.5);
+
+  /**
+  * @return an iterator to the first particle.
+  */
+  ParticleIterator begin() override;
+
+  /**
+  * @return an iterator past the last particle.
+  */
+  ParticleIterator end() override;
+
+  /**
+  * This method adds the passed particle into the container.
+  * @param particle is the particle to be added.
+  */
+  void addParticle(const Particle& particle) override;
+
+  /**
+  * This method appends all particles of the passed storage to the container.
+  * @param newParticles the particles to be added.
+  */
+  void addParticles(const ParticleStorage& newParticles) override;
+
+  /**
+   * @return the number of particles in the container
+   */
+  size_t sizeParticles() const override;
+
+  std::vector<Particle> getParticles() const override;
+
+  ParticleStorage &getStorage() override;
+
+  /**
+   * @brief rebuilds the tree from the current particle positions
+   */
+  void buildTree();
+
+  /**
+   * @return the nodes of the tree built by the last call of buildTree, the root is the first node
+   */
+  const std::vector<Node> &getNodes() const;
+
+  /**
+   * @return storage indices of all particles in tree order, spatially close particles are close in this order
+   */
+  const std::vector<size_t> &getTreeOrder() const;
+
+  /**
+   * @return the opening angle
+   */
+  double getTheta() const;
+
+  /**
+   * @return true if the last tree was a quadtree because all particles lie in one z plane
+   */
+  bool isTwoDimensional() const;
+ };
+}
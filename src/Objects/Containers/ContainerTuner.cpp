@@ -0,0 +1,123 @@
+//
+// ContainerTuner.cpp
+//
+
+#include "ContainerTuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "spdlog/spdlog.h"
+
+namespace ParticleContainers {
+    std::string ContainerTuner::Configuration::toString() const {
+        std::stringstream stream;
+        if (skin > 0) {
+            stream << "Verlet list with skin " << skin << " and rebuild frequency " << rebuildFrequency;
+        } else {
+            stream << "linked cells";
+        }
+        if (cellSizeFactor != 1) {
+            stream << " with cell size factor " << cellSizeFactor;
+        }
+        return stream.str();
+    }
+
+    bool ContainerTuner::Configuration::operator==(const Configuration &other) const {
+        return skin == other.skin && rebuildFrequency == other.rebuildFrequency &&
+               cellSizeFactor == other.cellSizeFactor;
+    }
+
+    ContainerTuner::ContainerTuner(int trialSteps, int frequency) : trialSteps(trialSteps), frequency(frequency) {
+        if (trialSteps <= 0) {
+            throw std::invalid_argument("The number of trial steps of the tuner has to be positive");
+        }
+        if (frequency < 0) {
+            throw std::invalid_argument("The tuning frequency must not be negative");
+        }
+    }
+
+    std::vector<ContainerTuner::Configuration> ContainerTuner::candidates(const LinkedCellContainer &container) {
+        const Configuration current{container.getSkin(), container.getRebuildFrequency(),
+                                    container.getCellSizeFactor()};
+        const double cutoff = container.getCutoff();
+        std::vector<Configuration> result;
+        for (double cellSizeFactor: {1.0, 1.0 / 2, 1.0 / 3}) {
+            // periodic axes need haloDepth cells on both sides, i.e. a domain of at least two cutoff radii
+            const int haloDepth = static_cast<int>(std::ceil(1.0 / cellSizeFactor - 1e-9));
+            bool fits = true;
+            for (int d = 0; d < 3; ++d) {
+                const int numCells = static_cast<int>(std::floor(container.getDomainSize()[d] / (cellSizeFactor * cutoff)));
+                fits = fits && (!container.getPeriodic()[d] || numCells >= 2 * haloDepth);
+            }
+            if (fits) {
+                result.push_back({0, 0, cellSizeFactor});
+            }
+        }
+        if (current.skin == 0 && std::find(result.begin(), result.end(), current) == result.end()) {
+            result.push_back(current);
+        }
+        // the Verlet list does not know about periodic images
+        if (container.hasPeriodicBoundaries()) {
+            return result;
+        }
+        std::vector<double> skins{0.1 * cutoff, 0.2 * cutoff, 0.4 * cutoff};
+        if (current.skin > 0 && std::find(skins.begin(), skins.end(), current.skin) == skins.end()) {
+            skins.push_back(current.skin);
+        }
+        for (double skin: skins) {
+            // the cells are cutoff + skin wide, a thinner domain would be simulated as a single layer of cells
+            const bool threeDimensional = container.getDomainSize()[2] > cutoff + skin;
+            if (threeDimensional == container.isThreeDimensional()) {
+                result.push_back(skin == current.skin ? current : Configuration{skin, 0, 1});
+            }
+        }
+        return result;
+    }
+
+    LinkedCellContainer ContainerTuner::createCandidate(LinkedCellContainer &container,
+                                                        const Configuration &configuration) {
+        LinkedCellContainer candidate(container.getDomainSize(), container.getCutoff(), configuration.skin,
+                                      configuration.rebuildFrequency, configuration.cellSizeFactor);
+        candidate.setPeriodic(container.getPeriodic());
+        candidate.addParticles(container.getStorage());
+        candidate.updateParticlesInCell();
+        return candidate;
+    }
+
+    ContainerTuner::Configuration ContainerTuner::tune(LinkedCellContainer &container,
+                                                       Calculators::Calculator &calculator, double deltaT) const {
+        const Configuration current{container.getSkin(), container.getRebuildFrequency(),
+                                    container.getCellSizeFactor()};
+        const std::vector<Configuration> configurations = candidates(container);
+        if (configurations.size() == 1) {
+            SPDLOG_INFO("Tuning: {} is the only configuration for this domain", configurations[0].toString());
+            return configurations[0];
+        }
+        Configuration best = current;
+        double bestTime = std::numeric_limits<double>::infinity();
+        for (const Configuration &configuration: configurations) {
+            LinkedCellContainer candidate = createCandidate(container, configuration);
+            const auto start = std::chrono::steady_clock::now();
+            for (int step = 0; step < trialSteps; ++step) {
+                calculator.calculateXFV(candidate, deltaT);
+            }
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            SPDLOG_DEBUG("Tuning: {} took {:.3f} ms per step", configuration.toString(), 1e3 * time / trialSteps);
+            if (time < bestTime) {
+                bestTime = time;
+                best = configuration;
+            }
+        }
+
+        SPDLOG_INFO("Tuning selected {} with {:.3f} ms per step", best.toString(), 1e3 * bestTime / trialSteps);
+        if (!(best == current)) {
+            // in place, so the boundary handler keeps operating on the same container object
+            container.reconfigure(best.cellSizeFactor, best.skin, best.rebuildFrequency);
+        }
+        return best;
+    }
+}
@@ -0,0 +1,89 @@
+//
+// ContainerTuner.h
+//
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Calculator/Calculator.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+
+namespace ParticleContainers {
+ /**
+  * @brief Selects the fastest configuration of a LinkedCellContainer by timing a few steps of every candidate.
+  *
+  * The candidates only differ in how the pairs within the cutoff radius are found, i.e. the cells of different sizes
+  * or Verlet lists with different skins, so the choice does not change the simulated forces. The trial steps run on copies of
+  * the particles and leave the simulation untouched.
+  */
+ class ContainerTuner {
+ public:
+  /**
+   * @brief A configuration of the LinkedCellContainer that is tried by the tuner
+   */
+  struct Configuration {
+   /** skin of the Verlet list, 0 for the cells alone */
+   double skin;
+   /** steps after which the Verlet list is rebuilt, 0 to only rebuild on displacement */
+   int rebuildFrequency;
+   /** edge length of the cells relative to cutoff + skin */
+   double cellSizeFactor;
+
+   /**
+    * @return true if both configurations set up the same container
+    */
+   bool operator==(const Configuration &other) const;
+
+   /**
+    * @return human readable description for the log
+    */
+   std::string toString() const;
+  };
+
+  /**
+   * @param trialSteps number of steps every candidate is timed for
+   * @param frequency number of iterations between two tunings during the simulation, 0 only tunes at the start
+   * @throws std::invalid_argument if trialSteps is not positive or frequency is negative
+   */
+  explicit ContainerTuner(int trialSteps = 10, int frequency = 0);
+
+  /**
+   * @brief Lists the configurations worth trying for a container: cells of 1, 1/2 and 1/3 of the cutoff radius
+   * and, without periodic boundaries, Verlet lists with skins of 10%, 20% and 40% of the cutoff radius and the
+   * current skin. Skins that would make a three dimensional grid two dimensional and cells too small for the periodic
+   * boundaries are left out.
+   * @param container the container to be tuned
+   * @return the candidates, the current configuration of the container is always included
+   */
+  static std::vector<Configuration> candidates(const LinkedCellContainer &container);
+
+  /**
+   * @brief Times every candidate on a copy of the particles and reconfigures the container with the fastest one.
+   *
+   * The time of a candidate includes building its cells and Verlet list, so short trials favour configurations
+   * without Verlet list. The container keeps its particles, including their forces, and its periodic boundaries.
+   * Storage indices are invalidated if the configuration changes.
+   * @param container the container to be tuned
+   * @param calculator the calculator of the simulation
+   * @param deltaT time step of the simulation
+   * @return the selected configuration
+   */
+  Configuration tune(LinkedCellContainer &container, Calculators::Calculator &calculator, double deltaT) const;
+
+  /**
+   * @param iteration number of the finished iteration
+   * @return true if the container is tuned again after this iteration
+   */
+  bool isDue(int iteration) const { return frequency > 0 && iteration % frequency == 0; }
+
+ private:
+  int trialSteps;
+  int frequency;
+
+  /**
+   * @return a new container with the configuration, the periodic boundaries and a copy of the particles of container
+   */
+  static LinkedCellContainer createCandidate(LinkedCellContainer &container, const Configuration &configuration);
+ };
+}
@@ -8,10 +8,10 @@
     #include <exception>
 
 namespace ParticleContainers {
-    std::vector<Particle>::iterator DirectSumContainer::begin() {
+    ParticleIterator DirectSumContainer::begin() {
         return particles.begin();
     }
-    std::vector<Particle>::iterator DirectSumContainer::end() {
+    ParticleIterator DirectSumContainer::end() {
         return particles.end();
     }
 
@@ -20,35 +20,36 @@ namespace ParticleContainers {
         particles.push_back(particle);
     }
 
+    void DirectSumContainer::addParticles(const ParticleStorage &newParticles) {
+        SPDLOG_TRACE("adding {} particles to container", newParticles.size());
+        particles.append(newParticles);
+    }
+
     void DirectSumContainer::removeParticle(const Particle &particle) {
         SPDLOG_TRACE("removing particle from container");
 
         // remove the particle itself from `particles`
-        auto it = std::remove_if(
-            particles.begin(),
-            particles.end(),
-            [&particle](const Particle &p) { return p.getID() == particle.getID(); });
+        size_t index = particles.findIndex(particle.getID());
 
-        if (it != particles.end()) {
-            particles.erase(it, particles.end());
+        if (index != particles.size()) {
+            particles.erase(index);
         } else {
             SPDLOG_WARN("Attempted to remove a particle not found in container: ID {}", particle.getID());
         }
     }
 
-    const Particle& DirectSumContainer::getParticle(int id) {
+    Particle DirectSumContainer::getParticle(ParticleId id) {
 
-        for (auto &p:particles) { //linear search
-            if (p.getID() == id){
-                return p;
-            }
+        size_t index = particles.findIndex(id); //linear search
+        if (index != particles.size()) {
+            return particles.get(index);
         }
         
         SPDLOG_WARN("Particle not found");
         throw std::runtime_error("Particle not found");
     }
 
-    const Particle& DirectSumContainer::getParticle(Particle& p) {
+    Particle DirectSumContainer::getParticle(const Particle& p) {
         return DirectSumContainer::getParticle(p.getID());
     }
 
@@ -58,6 +59,15 @@ namespace ParticleContainers {
     }
 
     std::vector<Particle> DirectSumContainer::getParticles() const {
+        std::vector<Particle> result;
+        result.reserve(particles.size());
+        for (size_t i = 0; i < particles.size(); ++i) {
+            result.push_back(particles.get(i));
+        }
+        return result;
+    }
+
+    ParticleStorage &DirectSumContainer::getStorage() {
         return particles;
     }
 }
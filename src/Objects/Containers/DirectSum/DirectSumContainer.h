@@ -18,20 +18,20 @@ namespace ParticleContainers {
 
  private:
   /**
-  * Vector for storing particles
+  * Structure-of-arrays storage for the particles
   */
-  std::vector<Particle> particles;
+  ParticleStorage particles;
 
  public:
   /**
-  * @return an iterator to the beginning of the particles vector.
+  * @return an iterator to the first particle.
   */
-  std::vector<Particle>::iterator begin() override;
+  ParticleIterator begin() override;
 
   /**
-  * @return an iterator to the end of the particles vector.
+  * @return an iterator past the last particle.
   */
-  std::vector<Particle>::iterator end() override;
+  ParticleIterator end() override;
 
 
   /**
@@ -45,6 +45,12 @@ namespace ParticleContainers {
   */
   void addParticle(const Particle& particle) override;
 
+  /**
+  * This method appends all particles of the passed storage to the container.
+  * @param newParticles the particles to be added.
+  */
+  void addParticles(const ParticleStorage& newParticles) override;
+
   /**
   * This method removes the passed particle from the container.
   * @param particle is the particle to be removed.
@@ -52,24 +58,24 @@ namespace ParticleContainers {
   void removeParticle(const Particle& particle);
 
   /**
-   * This method returns the particle with the corresponding id
-   * @param id is a unique int identifier
+   * This method returns a copy of the particle with the corresponding id
+   * @param id is a unique identifier
    * @returns the corresponding particle
    *
    * Throws an error if the container does not contain a particle with this id
    */
 
-  const Particle& getParticle(int id);
+  Particle getParticle(ParticleId id);
 
   /**
-   * This method returns the particle from the container with the corresponding id
+   * This method returns a copy of the particle from the container with the corresponding id
    * @param p a particle p which exists in the container
    * @returns the corresponding particle
    *
    * Throws an error if the container does not contain a particle with this id
    */
 
-  const Particle& getParticle(Particle& p);
+  Particle getParticle(const Particle& p);
 
 
   /**
@@ -80,5 +86,7 @@ namespace ParticleContainers {
 
   std::vector<Particle> getParticles() const override;
 
+  ParticleStorage &getStorage() override;
+
  };
 }
@@ -5,6 +5,7 @@
 #include "BoundaryHandler.h"
 #include <math.h>
 #include <exception>
+#include <stdexcept>
 #include <iostream>
 #include <algorithm>
 #include "spdlog/spdlog.h"
@@ -13,16 +14,44 @@
 #include "../../../Calculator/Calculator.h"
 #include "../../../Calculator/LennardJonesCalculator.h"
 
-Calculators::LennardJonesCalculator calculator = Calculators::LennardJonesCalculator();
+namespace {
+    std::array<BoundaryCondition, 6> toBoundaryConditions(const std::array<bool, 6> &reflecting) {
+        std::array<BoundaryCondition, 6> conditions{};
+        for (size_t i = 0; i < conditions.size(); i++) {
+            conditions[i] = reflecting[i] ? BoundaryCondition::REFLECTING : BoundaryCondition::OUTFLOW;
+        }
+        return conditions;
+    }
+}
 
-BoundaryHandler::BoundaryHandler(double s, std::array<bool, 6> t, ParticleContainers::LinkedCellContainer& container) :
-sigma {s}, type {t}, container {container}, minDist {std::pow(2.0, 1.0/6.0) * sigma}, 
+BoundaryHandler::BoundaryHandler(double s, std::array<BoundaryCondition, 6> t, ParticleContainers::LinkedCellContainer& container) :
+mixingTable {5, s}, type {t}, container {container},
 boundaries {{0, container.getDomainSize()[0], container.getDomainSize()[1], 0, container.getDomainSize()[2], 0}} {
 //initializeBoundaries();
 //SPDLOG_INFO("type set to {} {} {} {}", type[0], type[1], type [2], type [3]);
-
+    std::array<bool, 3> periodic{};
+    for (int axis = 0; axis < 3; axis++) {
+        periodic[axis] = type[2 * axis] == BoundaryCondition::PERIODIC;
+        if (periodic[axis] != (type[2 * axis + 1] == BoundaryCondition::PERIODIC)) {
+            SPDLOG_ERROR("Periodic boundaries have to be set on both sides of an axis");
+            throw std::invalid_argument("Periodic boundaries have to be set on both sides of an axis");
+        }
+    }
+    // the container wraps the particles and fills the halo with images
+    container.setPeriodic(periodic);
 };
 
+BoundaryHandler::BoundaryHandler(double s, std::array<bool, 6> t, ParticleContainers::LinkedCellContainer& container) :
+BoundaryHandler(s, toBoundaryConditions(t), container) {}
+
+
+void BoundaryHandler::setMixingTable(const Calculators::LennardJonesMixingTable &table) {
+    mixingTable = table;
+}
+
+const std::array<BoundaryCondition, 6> &BoundaryHandler::getBoundaryConditions() const {
+    return type;
+}
 
 void BoundaryHandler::handleBoundaries(){
             handleReflecting();
@@ -31,50 +60,70 @@ void BoundaryHandler::handleBoundaries(){
 
 void BoundaryHandler::handleOutflow(){
     //SPDLOG_INFO("handle outflow");
+    ParticleStorage &particles = container.getStorage();
+    const int numBoundaries = container.isThreeDimensional() ? 6 : 4;
+    // the position update already moved the particles to their cells, only particles added since need a sort
+    container.sortIfNecessary();
+    bool removed = false;
     for (auto cell : container.getHaloCells()) {
-        for (auto p : cell.get().getParticlesInCell()) {
-            for (int i = 0; i < 4; i++) { //FOR 3D: 6
+        for (size_t p : cell.get().getParticlesInCell()) {
+            for (int i = 0; i < numBoundaries; i++) {
 
-                if (type[i] == 1) {
+                if (type[i] != BoundaryCondition::OUTFLOW) {
                     continue;
                 }
 
-                double dist = calculateDistance(*p, i);
+                double dist = calculateDistance(particles[p].getX(), i);
 
-                if (dist <= container.getCellSizePerDimension()[i/2]) { //this is a cell at the border that we are looking at
-                    container.removeParticle(*p);
+                //the halo is haloDepth cells thick, this is a cell at the border that we are looking at
+                if (dist <= container.getHaloDepth() * container.getCellSizePerDimension()[i/2]) {
+                    container.markForRemoval(p);
+                    removed = true;
                     break;
                 }
             }
         }
+    }
+    // all outflowing particles are dropped by a single compacting sort
+    if (removed) {
         container.updateParticlesInCell();
-    } 
-  
+    }
+
 };
 
 void BoundaryHandler::handleReflecting(){
 
     //SPDLOG_INFO("handle reflecting");
-   
+    ParticleStorage &particles = container.getStorage();
+    const int numBoundaries = container.isThreeDimensional() ? 6 : 4;
+    const double sixthRootOfTwo = std::pow(2.0, 1.0/6.0);
+
     for (auto cell : container.getBoundaryCells()){
         
-        for (Particle * p : cell.get().getParticlesInCell()) {
+        for (size_t index : cell.get().getParticlesInCell()) {
+            ParticleRef p = particles[index];
+            //minimal distance between the particle and its ghost to be repulsing each other
+            const double minDist = sixthRootOfTwo * mixingTable.getSigma(p.getType());
   
-            for (int i = 0; i < 4; i++) {//0 -> left, 1 -> right, 2 -> top, 3 -> bottom, 2 dimensions only for now
+            for (int i = 0; i < numBoundaries; i++) {//0 -> left, 1 -> right, 2 -> top, 3 -> bottom, 4 -> front, 5 -> back
 
-               if (type [i] == 0) {
+               if (type [i] != BoundaryCondition::REFLECTING) {
                     continue;
                 }
 
                 //calculate distance from boundary
-                double dist = calculateDistance(*p, i);
+                double dist = calculateDistance(p.getX(), i);
                 //SPDLOG_INFO("{}", dist);
                 if (dist < minDist/2) { //must be closer
-                    std::array<double, 3> sub = operator-(ghostParticleLocation(*p, i, dist), p->getX());
+                    std::array<double, 3> sub = operator-(ghostParticleLocation(p.getX(), i, dist), p.getX());
                     double norm = ArrayUtils::L2Norm(sub);
                     //SPDLOG_INFO("F {} {} {}", p->getF()[0], p->getF()[1], p->getF()[2]);
-                    std::array <double, 3UL> force = calculator.calculateFIJ(sub, 0, 0, norm);
-                    p->setF(operator+(p -> getF(), force));
+                    //the ghost particle has the same type as the particle
+                    const double epsilon = mixingTable.getEpsilon(p.getType());
+                    const double sigma6 = std::pow(mixingTable.getSigma(p.getType()), 6);
+                    const double factor = Calculators::LennardJonesCalculator::lennardJonesFactor(norm * norm, {24 * epsilon, sigma6});
+                    std::array <double, 3UL> force = operator*(factor, sub);
+                    p.setF(operator+(p.getF(), force));
                     //SPDLOG_INFO("F {} {} {}", p->getF()[0], p->getF()[1], p->getF()[2]);
                     //SPDLOG_INFO("X {} {} {}", p->getX()[0], p->getX()[1], p->getX()[2]);
                     //SPDLOG_INFO("Ghost {} {} {} {} {}", ghostParticleLocation(*p, i, dist)[0], ghostParticleLocation(*p, i, dist)[1], ghostParticleLocation(*p, i, dist)[2], i, dist);
@@ -86,20 +135,20 @@ void BoundaryHandler::handleReflecting(){
      
 }
 
-double BoundaryHandler::calculateDistance(Particle p, int i) { //passing by value on purpose
+double BoundaryHandler::calculateDistance(const std::array<double, 3> &x, int i) {
      switch (i) {
-        case 0: return std::abs(p.getX()[0] - boundaries[0]); //left
-        case 1: return std::abs(p.getX()[0] - boundaries[1]); //right
-        case 2: return std::abs(p.getX()[1] - boundaries[2]); //top
-        case 3: return std::abs(p.getX()[1] - boundaries[3]); //bottom
-        case 4: return std::abs(p.getX()[2] - boundaries[4]); //front
-        case 5: return std::abs(p.getX()[2] - boundaries[5]); //back
+        case 0: return std::abs(x[0] - boundaries[0]); //left
+        case 1: return std::abs(x[0] - boundaries[1]); //right
+        case 2: return std::abs(x[1] - boundaries[2]); //top
+        case 3: return std::abs(x[1] - boundaries[3]); //bottom
+        case 4: return std::abs(x[2] - boundaries[4]); //front
+        case 5: return std::abs(x[2] - boundaries[5]); //back
         default: throw std::runtime_error("Error calculating distance");
      }
 }
 
-std::array<double, 3L> BoundaryHandler::ghostParticleLocation(Particle p, int i, double dist){//pass by value
-    std::array<double,3> mirrorX = p.getX();
+std::array<double, 3L> BoundaryHandler::ghostParticleLocation(const std::array<double, 3> &x, int i, double dist){
+    std::array<double,3> mirrorX = x;
 
     switch (i) {
         case 0: { //mirror along left border
@@ -4,27 +4,36 @@
 #pragma once
 
 #include "LinkedCellContainer.h"
+#include "../../../Calculator/LennardJonesMixingTable.h"
+#include <cstdint>
 #include <memory>
 
+/** condition at one boundary of the simulation */
+enum class BoundaryCondition : uint8_t {
+    /** particles leaving the domain are deleted */
+    OUTFLOW = 0,
+    /** particles are repelled by ghost particles */
+    REFLECTING = 1,
+    /** particles leaving the domain enter it at the opposite side, both sides of an axis have to be periodic */
+    PERIODIC = 2
+};
 
 class BoundaryHandler{
 
     private:
-    /** the sigma value used for calculating the Lennard-Jones Potential */
-    double sigma;
+    /** the Lennard-Jones parameters of every particle type, used for the repulsion of the ghost particles */
+    Calculators::LennardJonesMixingTable mixingTable;
     /** determines what condition is used on what border
      * boundaries of the simulation: left, right, top, bottom(, front, back)
      *  type 0: Outflow
      *  type 1: Reflecting
+     *  type 2: Periodic, handled by the container
      */
-    const std::array<bool, 6> type; 
+    const std::array<BoundaryCondition, 6> type;
 
     /** ParticleContainer that the BoundaryHandler operates on */
     ParticleContainers::LinkedCellContainer & container;
 
-    /**minimal distance between two particles to be repulsing each other*/
-    const double minDist;
-
     /**boundaries of the simulation: left, right, top, bottom(, front, back) */
     const std::array<double, 6> boundaries;
 
@@ -38,27 +47,49 @@ class BoundaryHandler{
 
     public:
 
+    /**
+     * @param s sigma of all particle types until setMixingTable is called
+     * @param t condition of every boundary
+     * @param pc container the handler operates on
+     */
+    BoundaryHandler(double s, std::array<BoundaryCondition, 6> t, ParticleContainers::LinkedCellContainer& pc);
+
+    /**
+     * @param s sigma of all particle types until setMixingTable is called
+     * @param t condition of every boundary, true for reflecting and false for outflow
+     * @param pc container the handler operates on
+     */
     BoundaryHandler(double s, std::array<bool, 6> t, ParticleContainers::LinkedCellContainer& pc);
     ~BoundaryHandler() = default;
 
+    /**Sets the Lennard-Jones parameters of the particle types, e.g. those of the calculator
+     * @param table the parameters of every particle type
+     */
+    void setMixingTable(const Calculators::LennardJonesMixingTable &table);
+
+    /**
+     * @return condition of every boundary: left, right, top, bottom, front, back
+     */
+    const std::array<BoundaryCondition, 6> &getBoundaryConditions() const;
+
     /**Handles particles that have left/are about to leave the boundaries of the simulation
      * This method should be called in every iteration after updating the positions of all particles
      */
     void handleBoundaries();
 
     /**Calculates the absolute value of a particle to a boundary
-     * @param p the Particle whose distance is to be calculated
+     * @param x position of the particle whose distance is to be calculated
      * @param i int that signifies the currently observed boundary: 1 -> left, 2 -> right, 3 -> top, 4 -> bottom, 5 -> front, 6 -> back
      * @returns double absolute distance of particle to boundary
      */
-    double calculateDistance(Particle p, int i);
+    double calculateDistance(const std::array<double, 3> &x, int i);
 
     /**Calculates the location of the ghost particle belonging to the current particle
-     * @param particle
+     * @param x position of the particle
      * @param i int that signifies the currently observed boundary: 1 -> left, 2 -> right, 3 -> top, 4 -> bottom, 5 -> front, 6 -> back
      * @returns position array of ghost particle
      */
 
-    std::array<double, 3UL> ghostParticleLocation(Particle p, int i, double dist);
+    std::array<double, 3UL> ghostParticleLocation(const std::array<double, 3> &x, int i, double dist);
     //void initializeBoundaries();
 };
\ No newline at end of file
@@ -4,20 +4,73 @@
 
 #include "LinkedCellContainer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
 #include "spdlog/spdlog.h"
 
 namespace ParticleContainers {
-    LinkedCellContainer::LinkedCellContainer(const std::array<double, 3> &domainSize, const double cutoff)
-        : domainSize(domainSize), cutoff(cutoff) {
+    LinkedCellContainer::LinkedCellContainer(const std::array<double, 3> &domainSize, const double cutoff,
+                                             const double skin, const int rebuildFrequency,
+                                             const double cellSizeFactor)
+        : domainSize(domainSize), cutoff(cutoff), skin(skin), rebuildFrequency(rebuildFrequency),
+          cellSizeFactor(cellSizeFactor) {
 
         SPDLOG_DEBUG("DOMAIN SIZE: {} {} {}", domainSize[0], domainSize[1], domainSize[2]);
         SPDLOG_DEBUG("CUTOFF: {}", cutoff);
+        SPDLOG_DEBUG("SKIN: {}, REBUILD FREQUENCY: {}", skin, rebuildFrequency);
+        SPDLOG_DEBUG("CELL SIZE FACTOR: {}", cellSizeFactor);
+
+        if (!(cellSizeFactor > 0 && cellSizeFactor <= 1)) {
+            SPDLOG_ERROR("The cell size factor has to be in (0, 1]");
+            throw std::invalid_argument("The cell size factor has to be in (0, 1]");
+        }
+        initializeGrid();
+    }
+
+    void LinkedCellContainer::reconfigure(double newCellSizeFactor, double newSkin, int newRebuildFrequency) {
+        SPDLOG_DEBUG("Reconfiguring with cell size factor {}, skin {} and rebuild frequency {}", newCellSizeFactor,
+                     newSkin, newRebuildFrequency);
+        if (!(newCellSizeFactor > 0 && newCellSizeFactor <= 1)) {
+            SPDLOG_ERROR("The cell size factor has to be in (0, 1]");
+            throw std::invalid_argument("The cell size factor has to be in (0, 1]");
+        }
+        cellSizeFactor = newCellSizeFactor;
+        skin = newSkin;
+        rebuildFrequency = newRebuildFrequency;
+
+        cells.clear();
+        innerCells.clear();
+        boundaryCells.clear();
+        haloCells.clear();
+        initializeGrid();
+
+        verletPairs.clear();
+        verletListValid = false;
+        stepsSinceRebuild = 0;
+        // the image cells depend on the grid, and the new cells have to fit the periodic axes
+        setPeriodic(periodic);
+        updateParticlesInCell();
+    }
+
+    void LinkedCellContainer::initializeGrid() {
+        //the cells have to contain all partners within cutoff + skin for the Verlet list
+        const double interactionLength = cutoff + skin;
+
+        //domains that are not thicker than one cell are simulated in 2d: a single layer of cells without z halo
+        threeDimensional = domainSize[2] > interactionLength;
+
+        //the cells are at least cellSizeFactor * interactionLength wide, so haloDepth of them cover interactionLength
+        const double minCellSize = cellSizeFactor * interactionLength;
+        haloDepth = static_cast<int>(std::ceil(1.0 / cellSizeFactor - 1e-9));
 
         //calculate how many cells in each dimension
         cellNumPerDimension = {
-            std::max(static_cast<int>(std::floor(domainSize[0] / cutoff)), 1),
-            std::max(static_cast<int>(std::floor(domainSize[1] / cutoff)), 1),
-            1 // for now 2d
+            std::max(static_cast<int>(std::floor(domainSize[0] / minCellSize)), 1),
+            std::max(static_cast<int>(std::floor(domainSize[1] / minCellSize)), 1),
+            threeDimensional ? std::max(static_cast<int>(std::floor(domainSize[2] / minCellSize)), 1) : 1
         };
 
         SPDLOG_DEBUG("Cell Number Per Dimension: {} {} {}", cellNumPerDimension[0], cellNumPerDimension[1], cellNumPerDimension[2]);
@@ -28,7 +81,9 @@ namespace ParticleContainers {
             domainSize[2] / cellNumPerDimension[2]
         };
 
-        cells.reserve((cellNumPerDimension[0] + 2) * (cellNumPerDimension[1] + 2)); //
+        //the cell vector must not reallocate, neighbours and the cell type vectors point into it
+        cells.reserve((cellNumPerDimension[0] + 2 * haloDepth) * (cellNumPerDimension[1] + 2 * haloDepth) *
+                      (threeDimensional ? cellNumPerDimension[2] + 2 * haloDepth : 1));
         SPDLOG_DEBUG("Cell Size Per Dim {} {} {}", cellSizePerDimension[0], cellSizePerDimension[1], cellSizePerDimension[2]);
 
 
@@ -38,6 +93,9 @@ namespace ParticleContainers {
         //initialize the neighbours vectors for the cells
         initializeNeighbours();
 
+        //group the cells for the parallel force calculation
+        initializeColours();
+
         SPDLOG_DEBUG("LinkedCellContainer initialized with the domain [{},{},{}] and cutoff-radius", domainSize[0],
                      domainSize[1], domainSize[2], cutoff);
         SPDLOG_DEBUG("Number of cells per dimension: x: {}, y: {}, z: {}", cellNumPerDimension[0], cellNumPerDimension[1],
@@ -52,27 +110,42 @@ namespace ParticleContainers {
         //SPDLOG_INFO(particle.toString());
         Cell *cellOfParticle = mapParticleToCell(particle);
         if (cellOfParticle != nullptr) {
-
-            size_t cap = particles.capacity();
+            // the particle is appended and moved to its cell by the next sort
             particles.push_back(particle);
-
-            if (cap != particles.capacity()) {
-                updateParticlesInCell();
-            } else {
-                cellOfParticle->addParticleToCell(&particles.back());
-            }
+            sorted = false;
+            verletListValid = false;
         } else {
             SPDLOG_WARN("Cell does not exist, particle is out of bounds!");
             return;
         }
     }
 
+    void LinkedCellContainer::addParticles(const ParticleStorage &newParticles) {
+        size_t outOfBounds = 0;
+        for (size_t i = 0; i < newParticles.size(); ++i) {
+            if (cellIndexOfPosition(newParticles.x[i], newParticles.y[i], newParticles.z[i]) < 0) {
+                ++outOfBounds;
+            }
+        }
+        if (outOfBounds > 0) {
+            SPDLOG_WARN("{} particles are out of bounds and are not added!", outOfBounds);
+        }
+        // the particles outside of the grid are dropped by the next sort
+        particles.append(newParticles);
+        sorted = false;
+        verletListValid = false;
+    }
+
     void LinkedCellContainer::removeParticle(const Particle &particle) {
         SPDLOG_DEBUG("removing {}", particle.toString());
         Cell *cellOfParticle = mapParticleToCell(particle);
         if (cellOfParticle != nullptr) {
 
-            particles.erase(std::find(particles.begin(), particles.end(), particle));
+            size_t index = particles.findIndex(particle.getID());
+            if (index != particles.size()) {
+                markForRemoval(index);
+                updateParticlesInCell();
+            }
 
         } else {
             SPDLOG_ERROR("Cell does not exist, particle to be removed is out of bounds!");
@@ -80,36 +153,175 @@ namespace ParticleContainers {
         }
     }
 
+    void LinkedCellContainer::markForRemoval(size_t index) {
+        if (removalMarks.empty()) {
+            removalMarks.resize(particles.size(), false);
+        }
+        removalMarks[index] = true;
+        sorted = false;
+    }
+
     void LinkedCellContainer::reserve(size_t numParticles) {
-        size_t oldCap = particles.capacity();
         particles.reserve(numParticles);
+    }
 
-        if (oldCap != particles.capacity()) {
-            updateParticlesInCell();
+    void LinkedCellContainer::updateParticlesInCell() {
+        updateParticlesInCell([](size_t) {});
+    }
+
+    void LinkedCellContainer::sortIntoCells(bool ordered) {
+        const size_t numParticles = particles.size();
+
+        for (size_t cell = 0; cell < cells.size(); ++cell) {
+            cellStarts[cell + 1] += cellStarts[cell];
+        }
+
+        // counting sort, only necessary if a particle changed its cell since the last sort
+        if (!ordered) {
+            sortOrder.resize(cellStarts.back());
+            std::vector<size_t> nextSlot(cellStarts.begin(), cellStarts.end() - 1);
+            for (size_t i = 0; i < numParticles; ++i) {
+                int cell = particleCellIndices[i];
+                if (cell >= 0) {
+                    sortOrder[nextSlot[cell]++] = i;
+                }
+            }
+            if (sortOrder.size() != numParticles) {
+                SPDLOG_DEBUG("removed {} particles", numParticles - sortOrder.size());
+            }
+            sortBuffer.gather(particles, sortOrder);
+            std::swap(particles, sortBuffer);
+
+            if (usesVerletList()) {
+                std::vector<size_t> newIndices(numParticles, SIZE_MAX);
+                for (size_t newIndex = 0; newIndex < sortOrder.size(); ++newIndex) {
+                    newIndices[sortOrder[newIndex]] = newIndex;
+                }
+                remapVerletList(newIndices);
+            }
         }
+
+        for (size_t cell = 0; cell < cells.size(); ++cell) {
+            cells[cell].setParticleRange(cellStarts[cell], cellStarts[cell + 1]);
+        }
+        removalMarks.clear();
+        sorted = true;
     }
 
-    void LinkedCellContainer::updateParticlesInCell() {
-        for (Cell& cell : cells) {
-            cell.clearParticlesInCell();
-        }
-
-        for (auto particle = begin(); particle!= end(); ++particle) {
-            Cell* cell = mapParticleToCell(*particle);
-            if (cell != nullptr) {
-                cell->addParticleToCell(&(*particle));
-            } else {
-                auto it = std::find(particles.begin(), particles.end(), *particle);
-                if (it != particles.end()) {
-                    particles.erase(it);
-                    //to prevent address sanitizer from failing, since we are modifying vector while iterating
-                    particle = particle - 1;
-                    SPDLOG_DEBUG("Particle erased successfully.");
-                } else {
-                    SPDLOG_WARN("Particle not found in container.");
+    void LinkedCellContainer::wrapPeriodicPosition(size_t index) {
+        std::vector<double> *positions[] = {&particles.x, &particles.y, &particles.z};
+        for (int d = 0; d < 3; ++d) {
+            double &position = (*positions[d])[index];
+            if (periodic[d] && (position < 0 || position >= domainSize[d])) {
+                position -= domainSize[d] * std::floor(position / domainSize[d]);
+                // tiny negative positions are rounded up to the domain size
+                if (position >= domainSize[d]) {
+                    position = 0;
+                }
+            }
+        }
+    }
+
+    void LinkedCellContainer::setPeriodic(const std::array<bool, 3> &periodicAxes) {
+        // the single layer of cells in 2d has no z halo
+        const std::array<bool, 3> axes{periodicAxes[0], periodicAxes[1], threeDimensional && periodicAxes[2]};
+        for (int d = 0; d < 3; ++d) {
+            if (axes[d] && cellNumPerDimension[d] < 2 * haloDepth) {
+                SPDLOG_ERROR("Periodic boundaries need a domain of at least two cutoff radii in every periodic dimension");
+                throw std::invalid_argument("Periodic boundaries need a domain of at least two cutoff radii in every "
+                                            "periodic dimension");
+            }
+        }
+        periodic = axes;
+        if (hasPeriodicBoundaries() && usesVerletList()) {
+            SPDLOG_WARN("The Verlet list is disabled for periodic boundaries");
+            skin = 0;
+            verletPairs.clear();
+            verletListValid = false;
+        }
+
+        periodicImageCells.clear();
+        const int zBegin = threeDimensional ? -haloDepth : 0;
+        const int zEnd = threeDimensional ? cellNumPerDimension[2] + haloDepth : 1;
+        for (int x = -haloDepth; x < cellNumPerDimension[0] + haloDepth; ++x) {
+            for (int y = -haloDepth; y < cellNumPerDimension[1] + haloDepth; ++y) {
+                for (int z = zBegin; z < zEnd; ++z) {
+                    std::array<int, 3> source{x, y, z};
+                    std::array<double, 3> shift{0, 0, 0};
+                    bool image = false;
+                    for (int d = 0; d < 3; ++d) {
+                        if (!periodic[d]) {
+                            continue;
+                        }
+                        // the halo before the domain mirrors the last cells and vice versa
+                        if (source[d] < 0) {
+                            source[d] += cellNumPerDimension[d];
+                            shift[d] = -domainSize[d];
+                            image = true;
+                        } else if (source[d] >= cellNumPerDimension[d]) {
+                            source[d] -= cellNumPerDimension[d];
+                            shift[d] = domainSize[d];
+                            image = true;
+                        }
+                    }
+                    if (image) {
+                        periodicImageCells.push_back({static_cast<size_t>(cellIndex(x, y, z)),
+                                                      static_cast<size_t>(cellIndex(source[0], source[1], source[2])),
+                                                      shift});
+                    }
                 }
-            SPDLOG_DEBUG("removed particle out of bounds");
-           }
+            }
+        }
+        SPDLOG_DEBUG("Periodic boundaries: x: {}, y: {}, z: {}, {} image cells", periodic[0], periodic[1], periodic[2],
+                     periodicImageCells.size());
+    }
+
+    const std::array<bool, 3> &LinkedCellContainer::getPeriodic() const { return periodic; }
+
+    bool LinkedCellContainer::hasPeriodicBoundaries() const { return periodic[0] || periodic[1] || periodic[2]; }
+
+    void LinkedCellContainer::createPeriodicImages() {
+        if (periodicImageCells.empty()) {
+            return;
+        }
+        sortIfNecessary();
+        numRealParticles = particles.size();
+        size_t numImages = 0;
+        for (const PeriodicImageCell &imageCell: periodicImageCells) {
+            numImages += cells[imageCell.sourceCell].getParticlesInCell().size();
+        }
+        // the new entries are zero initialized, so the images start without force
+        particles.resize(numRealParticles + numImages);
+
+        size_t next = numRealParticles;
+        for (const PeriodicImageCell &imageCell: periodicImageCells) {
+            const size_t begin = next;
+            for (size_t p: cells[imageCell.sourceCell].getParticlesInCell()) {
+                particles.x[next] = particles.x[p] + imageCell.shift[0];
+                particles.y[next] = particles.y[p] + imageCell.shift[1];
+                particles.z[next] = particles.z[p] + imageCell.shift[2];
+                particles.m[next] = particles.m[p];
+                particles.type[next] = particles.type[p];
+                particles.id[next] = particles.id[p];
+                ++next;
+            }
+            cells[imageCell.haloCell].setParticleRange(begin, next);
+        }
+    }
+
+    void LinkedCellContainer::removePeriodicImages() {
+        if (periodicImageCells.empty()) {
+            return;
+        }
+        particles.resize(numRealParticles);
+        for (const PeriodicImageCell &imageCell: periodicImageCells) {
+            cells[imageCell.haloCell].setParticleRange(numRealParticles, numRealParticles);
+        }
+    }
+
+    void LinkedCellContainer::sortIfNecessary() {
+        if (!sorted) {
+            updateParticlesInCell();
         }
     }
 
@@ -117,30 +329,38 @@ namespace ParticleContainers {
 
         const int numCellsInXDim = cellNumPerDimension[0];
         const int numCellsInYDim = cellNumPerDimension[1];
-        const int numCellsInZDim = 1;
-        SPDLOG_DEBUG("x {} y {} z {} {} {} {} {} ", x, y, z, numCellsInXDim, numCellsInYDim, numCellsInZDim, cellSizePerDimension[2]);
+        const int numCellsInZDim = cellNumPerDimension[2];
+
+        const int h = haloDepth;
+
+        if (x < -h || y < -h || x >= numCellsInXDim + h || y >= numCellsInYDim + h) { //flying out too far
+            return -1;
+        }
 
-        if (x < -1 || y < -1 || z < -1 || x > (numCellsInXDim) || y > (numCellsInYDim) || z > (numCellsInZDim)) { //flying out too far
-            //SPDLOG_ERROR("x {} y {} z {} {} {} {} {} ", x, y, z, numCellsInXDim, numCellsInYDim, numCellsInZDim, cellSizePerDimension[2]);
+        if (!threeDimensional) {
+            // single layer of cells, z is ignored
+            return (x + h) * (numCellsInYDim + 2 * h) + (y + h);
+        }
+
+        if (z < -h || z >= numCellsInZDim + h) {
             return -1;
         }
 
-        const int strideYZ = (numCellsInYDim + 2)*1;
-        const int strideZ = 1; // for 2d
-        return (x + 1) * strideYZ + (y + 1) * strideZ; // for 2d
+        const int strideZ = 1;
+        const int strideY = (numCellsInZDim + 2 * h) * strideZ;
+        const int strideX = (numCellsInYDim + 2 * h) * strideY;
+        return (x + h) * strideX + (y + h) * strideY + (z + h) * strideZ;
     }
 
 
     Cell *LinkedCellContainer::mapParticleToCell(const Particle &particle) {
-        std::array<double, 3> particlePosition = particle.getX();
-        std::array<int, 3> cellPosition = {
-            static_cast<int>(std::floor(particlePosition[0] / cellSizePerDimension[0])),
-            static_cast<int>(std::floor(particlePosition[1] / cellSizePerDimension[1])),
-            static_cast<int>(std::floor(particlePosition[2] / cellSizePerDimension[2]))
-        };
+        return mapPositionToCell(particle.getX());
+    }
+
+    Cell *LinkedCellContainer::mapPositionToCell(const std::array<double, 3> &particlePosition) {
         //SPDLOG_INFO("{} {}", particlePosition[0], cellSizePerDimension[0] );
-        int cellInd = cellIndex(cellPosition[0], cellPosition[1], cellPosition[2]);
-        if (cellInd >= (int)cells.size() || cellInd < 0) {
+        int cellInd = cellIndexOfPosition(particlePosition[0], particlePosition[1], particlePosition[2]);
+        if (cellInd < 0) {
             SPDLOG_WARN("The given particle does not belong to any cell!");
             return nullptr;
         }
@@ -148,15 +368,33 @@ namespace ParticleContainers {
         return &cells.at(cellInd);
     }
 
+    int LinkedCellContainer::cellIndexOfPosition(double x, double y, double z) const {
+        int cellInd = cellIndex(static_cast<int>(std::floor(x / cellSizePerDimension[0])),
+                                static_cast<int>(std::floor(y / cellSizePerDimension[1])),
+                                threeDimensional ? static_cast<int>(std::floor(z / cellSizePerDimension[2])) : 0);
+        if (cellInd >= (int)cells.size()) {
+            return -1;
+        }
+        return cellInd;
+    }
+
     void LinkedCellContainer::initializeCells() {
         SPDLOG_DEBUG("Initializing cells...");
-        for (int x = -1; x < cellNumPerDimension[0] + 1; ++x) {
-            for (int y = -1; y < cellNumPerDimension[1] + 1 ; ++y) {
-                    if (x < 0 || y < 0 ||  x >= cellNumPerDimension[0] || y >= cellNumPerDimension[1]) {
+        // haloDepth layers of halo cells surround the domain, the same number of layers inside it are boundary cells
+        const int h = haloDepth;
+        const int zBegin = threeDimensional ? -h : 0;
+        const int zEnd = threeDimensional ? cellNumPerDimension[2] + h : 1;
+        for (int x = -h; x < cellNumPerDimension[0] + h; ++x) {
+            for (int y = -h; y < cellNumPerDimension[1] + h; ++y) {
+                for (int z = zBegin; z < zEnd; ++z) {
+                    bool haloZ = threeDimensional && (z < 0 || z >= cellNumPerDimension[2]);
+                    bool boundaryZ = threeDimensional && (z < h || z >= cellNumPerDimension[2] - h);
+                    if (x < 0 || y < 0 ||  x >= cellNumPerDimension[0] || y >= cellNumPerDimension[1] || haloZ) {
                         Cell nCell(Cell::CType::HALO);
                         cells.push_back(nCell);
                         haloCells.push_back(cells.back());
-                    } else if (x == 0 || y == 0 || x == cellNumPerDimension[0] - 1 || y == cellNumPerDimension[1] - 1) {
+                    } else if (x < h || y < h || x >= cellNumPerDimension[0] - h || y >= cellNumPerDimension[1] - h ||
+                               boundaryZ) {
                         Cell nCell(Cell::CType::BOUNDARY);
                         cells.push_back(nCell);
                         boundaryCells.push_back(cells.back());
@@ -166,68 +404,227 @@ namespace ParticleContainers {
                         cells.push_back(nCell);
                         innerCells.push_back(cells.back());
                     }
-
+                }
             }
         }
     }
 
     void LinkedCellContainer::deleteHaloParticles() {
-        std::unordered_set<Particle *> particlesDelete;
+        sortIfNecessary();
         for (auto &cell: haloCells) {
-            for (Particle *particle: cell.get().getParticlesInCell()) {
-                particlesDelete.insert(particle);
+            for (size_t particle: cell.get().getParticlesInCell()) {
+                markForRemoval(particle);
+            }
+        }
+        updateParticlesInCell();
+    }
+
+    bool LinkedCellContainer::usesVerletList() const { return skin > 0; }
+
+    const std::vector<std::pair<size_t, size_t> > &LinkedCellContainer::getVerletPairs() {
+        sortIfNecessary();
+        bool rebuild = !verletListValid || (rebuildFrequency > 0 && stepsSinceRebuild >= rebuildFrequency);
+        if (!rebuild) {
+            //two particles moving towards each other by skin / 2 each can get into the cutoff radius
+            const double maxDisplacementSquared = 0.25 * skin * skin;
+            for (size_t i = 0; i < particles.size(); ++i) {
+                const double dx = particles.x[i] - verletX[i];
+                const double dy = particles.y[i] - verletY[i];
+                const double dz = particles.z[i] - verletZ[i];
+                if (dx * dx + dy * dy + dz * dz > maxDisplacementSquared) {
+                    rebuild = true;
+                    break;
+                }
             }
         }
+        if (rebuild) {
+            buildVerletList();
+        }
+        ++stepsSinceRebuild;
+        return verletPairs;
+    }
 
-        auto isInDelete = [&](Particle &particle) {
-            return particlesDelete.find(&particle) != particlesDelete.end();
+    void LinkedCellContainer::buildVerletList() {
+        SPDLOG_DEBUG("Rebuilding Verlet list after {} steps", stepsSinceRebuild);
+        const double listRadiusSquared = (cutoff + skin) * (cutoff + skin);
+        auto addIfClose = [this, listRadiusSquared](size_t i, size_t j) {
+            const double dx = particles.x[j] - particles.x[i];
+            const double dy = particles.y[j] - particles.y[i];
+            const double dz = particles.z[j] - particles.z[i];
+            if (dx * dx + dy * dy + dz * dz <= listRadiusSquared) {
+                verletPairs.emplace_back(i, j);
+            }
         };
 
-        particles.erase(std::remove_if(particles.begin(), particles.end(), isInDelete), particles.end());
-        updateParticlesInCell();
+        verletPairs.clear();
+        for (Cell &cell: cells) {
+            for (auto it1 = cell.beginParticle(); it1 != cell.endParticle(); ++it1) {
+                for (auto it2 = it1 + 1; it2 != cell.endParticle(); ++it2) {
+                    addIfClose(*it1, *it2);
+                }
+            }
+            for (Cell *neighbourCell: cell.getForwardNeighbourCells()) {
+                for (size_t i: cell.getParticlesInCell()) {
+                    for (size_t j: neighbourCell->getParticlesInCell()) {
+                        addIfClose(i, j);
+                    }
+                }
+            }
+        }
+
+        verletX = particles.x;
+        verletY = particles.y;
+        verletZ = particles.z;
+        stepsSinceRebuild = 0;
+        verletListValid = true;
+    }
+
+    void LinkedCellContainer::remapVerletList(const std::vector<size_t> &newIndices) {
+        if (!verletListValid) {
+            return;
+        }
+        size_t kept = 0;
+        for (auto &pair: verletPairs) {
+            size_t first = newIndices[pair.first];
+            size_t second = newIndices[pair.second];
+            if (first != SIZE_MAX && second != SIZE_MAX) {
+                verletPairs[kept++] = {first, second};
+            }
+        }
+        verletPairs.resize(kept);
+
+        //the reference positions move with their particles
+        const size_t numParticles = newIndices.size() - std::count(newIndices.begin(), newIndices.end(), SIZE_MAX);
+        for (std::vector<double> *reference: {&verletX, &verletY, &verletZ}) {
+            std::vector<double> remapped(numParticles);
+            for (size_t i = 0; i < newIndices.size(); ++i) {
+                if (newIndices[i] != SIZE_MAX) {
+                    remapped[newIndices[i]] = (*reference)[i];
+                }
+            }
+            reference->swap(remapped);
+        }
     }
 
     void LinkedCellContainer::initializeNeighbours() {
          SPDLOG_DEBUG("Initializing neighbours...");
         const int numCellsInXDim = cellNumPerDimension[0];
         const int numCellsInYDim = cellNumPerDimension[1];
-        for (int x = -1; x < numCellsInXDim + 1; ++x) {
-            for (int y = -1; y < numCellsInYDim + 1; ++y) {
-                    int z = 0; // for 2d
-                    Cell& cell = cells.at(cellIndex(x, y, z));
-                    for (int neighbourX = -1; neighbourX <= 1; ++neighbourX) {
-                        for (int neighbourY = -1; neighbourY <= 1; ++neighbourY) {
-                                if (neighbourX == 0 && neighbourY == 0) {
-                                    continue;
-                                }
-                                int neighbourIndex = cellIndex(x + neighbourX, y + neighbourY, z);
-                                if (neighbourIndex == -1) {
-                                    continue;
-                                }
-                                cell.addNeighbourCell(&cells.at(neighbourIndex));
-
+        const int h = haloDepth;
+        const int zBegin = threeDimensional ? -h : 0;
+        const int zEnd = threeDimensional ? cellNumPerDimension[2] + h : 1;
+        // in 2d there are no neighbours in z direction
+        const int neighbourZRange = threeDimensional ? h : 0;
+
+        // offsets of the stencil, cells whose closest points are further apart than cutoff + skin are skipped
+        const double interactionLength = cutoff + skin;
+        std::vector<std::array<int, 3> > stencil;
+        for (int neighbourX = -h; neighbourX <= h; ++neighbourX) {
+            for (int neighbourY = -h; neighbourY <= h; ++neighbourY) {
+                for (int neighbourZ = -neighbourZRange; neighbourZ <= neighbourZRange; ++neighbourZ) {
+                    if (neighbourX == 0 && neighbourY == 0 && neighbourZ == 0) {
+                        continue;
+                    }
+                    const std::array<int, 3> offset{neighbourX, neighbourY, neighbourZ};
+                    double gapSquared = 0;
+                    for (int d = 0; d < 3; ++d) {
+                        const double gap = std::max(std::abs(offset[d]) - 1, 0) * cellSizePerDimension[d];
+                        gapSquared += gap * gap;
+                    }
+                    if (gapSquared <= interactionLength * interactionLength) {
+                        stencil.push_back(offset);
+                    }
+                }
+            }
+        }
+        SPDLOG_DEBUG("Stencil with {} neighbour cells", stencil.size());
+
+        for (int x = -h; x < numCellsInXDim + h; ++x) {
+            for (int y = -h; y < numCellsInYDim + h; ++y) {
+                for (int z = zBegin; z < zEnd; ++z) {
+                    const int ownIndex = cellIndex(x, y, z);
+                    Cell& cell = cells.at(ownIndex);
+                    for (const std::array<int, 3> &offset: stencil) {
+                        int neighbourIndex = cellIndex(x + offset[0], y + offset[1], z + offset[2]);
+                        if (neighbourIndex == -1) {
+                            continue;
+                        }
+                        cell.addNeighbourCell(&cells.at(neighbourIndex));
+                        // half-shell stencil: the pair of cells is handled by the one with the lower index
+                        if (neighbourIndex > ownIndex) {
+                            cell.addForwardNeighbourCell(&cells.at(neighbourIndex));
                         }
                     }
+                }
             }
         }
     }
 
+    void LinkedCellContainer::initializeColours() {
+        SPDLOG_DEBUG("Initializing colours...");
+        // a cell writes to its neighbours with a higher index, i.e. up to haloDepth cells ahead in x and haloDepth
+        // cells to both sides in y. Blocks of 2 * haloDepth cells in x and y with 2 x 2 colours keep these apart.
+        const int h = haloDepth;
+        const int blockSize = 2 * h;
+        const int blocksY = (cellNumPerDimension[1] + 2 * h + blockSize - 1) / blockSize;
+        const int blocksX = (cellNumPerDimension[0] + 2 * h + blockSize - 1) / blockSize;
+        const int zBegin = threeDimensional ? -h : 0;
+        const int zEnd = threeDimensional ? cellNumPerDimension[2] + h : 1;
+        std::vector<std::vector<size_t> > blocks(static_cast<size_t>(blocksX) * blocksY);
+        // the cells are visited in the order of their index, so every block is sorted
+        for (int x = -h; x < cellNumPerDimension[0] + h; ++x) {
+            for (int y = -h; y < cellNumPerDimension[1] + h; ++y) {
+                for (int z = zBegin; z < zEnd; ++z) {
+                    blocks[((x + h) / blockSize) * blocksY + (y + h) / blockSize].push_back(cellIndex(x, y, z));
+                }
+            }
+        }
+        colouredBlocks.assign(4, {});
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int by = 0; by < blocksY; ++by) {
+                colouredBlocks[(bx % 2) * 2 + by % 2].push_back(std::move(blocks[bx * blocksY + by]));
+            }
+        }
+
+        // a cell receives forces while its own colour and the colours of the cells it is a forward neighbour of run
+        std::vector<size_t> completingColour(cells.size(), 0);
+        for (size_t colour = 0; colour < colouredBlocks.size(); ++colour) {
+            for (const std::vector<size_t> &block: colouredBlocks[colour]) {
+                for (size_t index: block) {
+                    completingColour[index] = std::max(completingColour[index], colour);
+                    for (const Cell *neighbour: cells[index].getForwardNeighbourCells()) {
+                        const auto neighbourIndex = static_cast<size_t>(neighbour - cells.data());
+                        completingColour[neighbourIndex] = std::max(completingColour[neighbourIndex], colour);
+                    }
+                }
+            }
+        }
+        cellsCompletedByColour.assign(colouredBlocks.size(), {});
+        for (size_t index = 0; index < cells.size(); ++index) {
+            cellsCompletedByColour[completingColour[index]].push_back(index);
+        }
+    }
 
-    std::vector<Particle>::iterator LinkedCellContainer::begin() { return particles.begin(); }
+    ParticleIterator LinkedCellContainer::begin() { return particles.begin(); }
 
-    std::vector<Particle>::iterator LinkedCellContainer::end() { return particles.end(); }
+    ParticleIterator LinkedCellContainer::end() { return particles.end(); }
 
-    std::vector<Cell>::iterator LinkedCellContainer::beginCells() { return cells.begin(); }
+    std::vector<Cell>::iterator LinkedCellContainer::beginCells() {
+        sortIfNecessary();
+        return cells.begin();
+    }
 
     std::vector<Cell>::iterator LinkedCellContainer::endCells() { return cells.end(); }
 
     std::vector<std::reference_wrapper<Cell> >::iterator LinkedCellContainer::beginInnerCells() {
+        sortIfNecessary();
         return innerCells.begin();
     }
 
     std::vector<std::reference_wrapper<Cell> >::iterator LinkedCellContainer::endInnerCells() { return innerCells.end(); }
 
     std::vector<std::reference_wrapper<Cell> >::iterator LinkedCellContainer::beginBoundaryCells() {
+        sortIfNecessary();
         return boundaryCells.begin();
     }
 
@@ -235,29 +632,80 @@ namespace ParticleContainers {
         return boundaryCells.end();
     }
 
-    std::vector<std::reference_wrapper<Cell> >::iterator LinkedCellContainer::beginHaloCells() { return haloCells.begin(); }
+    std::vector<std::reference_wrapper<Cell> >::iterator LinkedCellContainer::beginHaloCells() {
+        sortIfNecessary();
+        return haloCells.begin();
+    }
 
     std::vector<std::reference_wrapper<Cell> >::iterator LinkedCellContainer::endHaloCells() { return haloCells.end(); }
 
-    std::vector<Particle> LinkedCellContainer::getParticles() const { return particles; }
+    std::vector<Particle> LinkedCellContainer::getParticles() const {
+        std::vector<Particle> result;
+        result.reserve(particles.size());
+        for (size_t i = 0; i < particles.size(); ++i) {
+            result.push_back(particles.get(i));
+        }
+        return result;
+    }
+
+    ParticleStorage &LinkedCellContainer::getStorage() { return particles; }
 
     size_t LinkedCellContainer::sizeParticles() const { return particles.size(); }
 
-    std::vector<Cell> LinkedCellContainer::getCells() const { return cells; }
+    std::vector<Cell> LinkedCellContainer::getCells() {
+        sortIfNecessary();
+        return cells;
+    }
 
     size_t LinkedCellContainer::sizeCells() const { return cells.size(); }
 
-    std::vector<std::reference_wrapper<Cell> > LinkedCellContainer::getInnerCells() { return innerCells; }
+    std::vector<std::reference_wrapper<Cell> > LinkedCellContainer::getInnerCells() {
+        sortIfNecessary();
+        return innerCells;
+    }
+
+    std::vector<std::reference_wrapper<Cell> > LinkedCellContainer::getBoundaryCells() {
+        sortIfNecessary();
+        return boundaryCells;
+    }
 
-    std::vector<std::reference_wrapper<Cell> > LinkedCellContainer::getBoundaryCells() { return boundaryCells; }
+    std::vector<std::reference_wrapper<Cell> > LinkedCellContainer::getHaloCells() {
+        sortIfNecessary();
+        return haloCells;
+    }
 
-    std::vector<std::reference_wrapper<Cell> > LinkedCellContainer::getHaloCells() { return haloCells; }
+    const std::vector<std::vector<std::vector<size_t> > > &LinkedCellContainer::getColouredBlocks() const {
+        return colouredBlocks;
+    }
+
+    const std::vector<std::vector<size_t> > &LinkedCellContainer::getCellsCompletedByColour() const {
+        return cellsCompletedByColour;
+    }
+
+    Particle LinkedCellContainer::getParticle(ParticleId id) {
+        size_t index = particles.findIndex(id);
+        if (index == particles.size()) {
+            SPDLOG_WARN("Particle not found");
+            throw std::runtime_error("Particle not found");
+        }
+        return particles.get(index);
+    }
 
     double LinkedCellContainer::getCutoff() const { return cutoff; }
 
+    double LinkedCellContainer::getSkin() const { return skin; }
+
+    int LinkedCellContainer::getRebuildFrequency() const { return rebuildFrequency; }
+
+    double LinkedCellContainer::getCellSizeFactor() const { return cellSizeFactor; }
+
+    int LinkedCellContainer::getHaloDepth() const { return haloDepth; }
+
     std::array<double, 3> LinkedCellContainer::getDomainSize() const { return domainSize; }
 
     std::array<double, 3> LinkedCellContainer::getCellSizePerDimension() const { return cellSizePerDimension; }
 
     std::array<int, 3> LinkedCellContainer::getCellNumPerDimension() const { return cellNumPerDimension; }
+
+    bool LinkedCellContainer::isThreeDimensional() const { return threeDimensional; }
 }
\ No newline at end of file
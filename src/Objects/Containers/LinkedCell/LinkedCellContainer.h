@@ -5,6 +5,8 @@
 #include "Objects/Cell.h"
 #include "Objects/Containers/ParticleContainer.h"
 
+#include <utility>
+
 namespace ParticleContainers {
  /**
   * @brief Container for LinkedCell algorithm for improving the performance of the DirectSum algorithm.
@@ -13,9 +15,40 @@ namespace ParticleContainers {
  class LinkedCellContainer : public ParticleContainer {
  private:
   /**
-   * @brief A vector to store Particle objects.
+   * @brief Structure-of-arrays storage for the particles.
+   * The particles are sorted by cell, every cell owns a contiguous range of storage indices.
+   */
+  ParticleStorage particles;
+
+  /**
+   * @brief Buffer the particles are sorted into, reused between sorts to avoid reallocations.
+   */
+  ParticleStorage sortBuffer;
+
+  /**
+   * @brief Cell index of every particle, computed during the sort. -1 for particles outside of the grid.
+   */
+  std::vector<int> particleCellIndices;
+
+  /**
+   * @brief Storage index of the first particle of every cell, followed by the total number of particles.
+   */
+  std::vector<size_t> cellStarts;
+
+  /**
+   * @brief Permutation applied to the storage by the counting sort.
+   */
+  std::vector<size_t> sortOrder;
+
+  /**
+   * @brief Particles marked by markForRemoval, dropped by the next sort. Empty if no particle is marked.
    */
-  std::vector<Particle> particles;
+  std::vector<bool> removalMarks;
+
+  /**
+   * @brief false if particles were added or removed since the last sort, i.e. the cell ranges are outdated.
+   */
+  bool sorted = true;
 
   /**
   * @brief A vector to store Cell objects.
@@ -32,6 +65,38 @@ namespace ParticleContainers {
    */
   double cutoff;
 
+  /**
+   * @brief skin added to the cutoff radius when building the Verlet list. 0 disables the Verlet list.
+   */
+  double skin;
+
+  /**
+   * @brief number of force calculations after which the Verlet list is rebuilt regardless of the displacements.
+   * 0 means the list is only rebuilt when a particle moved further than skin / 2.
+   */
+  int rebuildFrequency;
+
+  /**
+   * @brief Pairs of storage indices with a distance of at most cutoff + skin at the time the list was built.
+   * Every pair is stored once.
+   */
+  std::vector<std::pair<size_t, size_t> > verletPairs;
+
+  /**
+   * @brief Positions of the particles when the Verlet list was built, used to measure displacements
+   */
+  std::vector<double> verletX, verletY, verletZ;
+
+  /**
+   * @brief number of calls of getVerletPairs() since the last rebuild
+   */
+  int stepsSinceRebuild = 0;
+
+  /**
+   * @brief false if particles were added since the Verlet list was built
+   */
+  bool verletListValid = false;
+
   /**
    * @brief Vector containing references to inner cells in the domain
    */
@@ -57,6 +122,70 @@ namespace ParticleContainers {
    */
   std::array<int, 3> cellNumPerDimension{};
 
+  /**
+   * @brief requested edge length of the cells relative to cutoff + skin, in (0, 1]
+   */
+  double cellSizeFactor;
+
+  /**
+   * @brief number of cells that cover cutoff + skin, i.e. the reach of the stencil and the number of halo and boundary
+   * cell layers. 1 for cells that are at least cutoff + skin wide.
+   */
+  int haloDepth = 1;
+
+  /**
+   * @brief true if the domain is thicker than one cell in z direction. Otherwise the grid is a single layer of cells
+   * without a z halo and the z coordinate of the particles is ignored when mapping them to cells.
+   */
+  bool threeDimensional = false;
+
+  /**
+   * @brief Blocks of 2 * haloDepth by 2 * haloDepth columns of cells in x and y direction, grouped by colour. Every
+   * block holds the indices of its cells in increasing order. Blocks of the same colour are a block apart in x or y,
+   * so they and the neighbours of their cells with a higher index never overlap and can be processed in parallel.
+   */
+  std::vector<std::vector<std::vector<size_t> > > colouredBlocks;
+
+  /**
+   * @brief Indices of the cells whose particles receive no more force contributions after the colour of the same
+   * index, i.e. the last colour that contains the cell itself or a cell it is a forward neighbour of.
+   */
+  std::vector<std::vector<size_t> > cellsCompletedByColour;
+
+  /**
+   * @brief true for every axis with periodic boundaries. Particles leaving the domain along such an axis are wrapped
+   * to the opposite side and the halo cells hold periodic images during the force calculation.
+   */
+  std::array<bool, 3> periodic{false, false, false};
+
+  /**
+   * @brief A halo cell on a periodic axis together with the cell at the opposite side of the domain it mirrors
+   */
+  struct PeriodicImageCell {
+   /** index of the halo cell the images are placed in */
+   size_t haloCell;
+   /** index of the cell whose particles are mirrored */
+   size_t sourceCell;
+   /** offset added to the positions of the mirrored particles */
+   std::array<double, 3> shift;
+  };
+
+  /**
+   * @brief All halo cells that are filled with periodic images, empty without periodic boundaries
+   */
+  std::vector<PeriodicImageCell> periodicImageCells;
+
+  /**
+   * @brief number of particles in the storage without the periodic images appended by createPeriodicImages
+   */
+  size_t numRealParticles = 0;
+
+
+  /**
+   * @brief computes the cell grid from the domain size, cutoff + skin and the cell size factor and initializes the
+   * cells, their neighbours and colours. The cell vectors have to be empty.
+   */
+  void initializeGrid();
 
   /**
    * @brief initialize the cell vector and set the cell types
@@ -64,20 +193,92 @@ namespace ParticleContainers {
   void initializeCells();
 
   /**
-   * @brief Set the neighbouring cells for every cell in the cells vector
+   * @brief Set the neighbouring cells for every cell in the cells vector. The neighbours are all cells within
+   * haloDepth cells in every dimension that are not entirely further away than cutoff + skin.
    */
   void initializeNeighbours();
 
+  /**
+   * @brief Groups the cells into coloured blocks for the force traversal and determines after which colour the
+   * forces of every cell are complete. Needs the neighbours of the cells.
+   */
+  void initializeColours();
+
+  /**
+   * @brief Second half of updateParticlesInCell: sorts the storage by the cell indices computed in the sweep over the
+   * particles and updates the cell ranges.
+   * @param ordered true if the storage is already ordered by cell and no particle is dropped
+   */
+  void sortIntoCells(bool ordered);
+
+  /**
+   * @brief computes the index of the cell containing the passed position
+   * @return index of the cell in the cells vector or -1 if the position is outside of the grid
+   */
+  int cellIndexOfPosition(double x, double y, double z) const;
+
+  /**
+   * @brief Rebuilds the Verlet list from the cells
+   */
+  void buildVerletList();
+
+  /**
+   * @brief Adapts the Verlet list to changed storage indices
+   * @param newIndices new storage index for every old storage index, or SIZE_MAX if the particle was removed
+   */
+  void remapVerletList(const std::vector<size_t> &newIndices);
+
+  /**
+   * @brief Moves the particle to the opposite side of the domain if it left it along a periodic axis
+   * @param index storage index of the particle
+   */
+  void wrapPeriodicPosition(size_t index);
 
 
  public:
   /**
    * @brief Constructor for a new Linked Cell Container
-   * BOUNDARIES FROM TASK 3 HAS TO BE ADDED!!!
+   * The domain is covered by cells of at least cellSizeFactor * (cutoff + skin) and surrounded by haloDepth layers of
+   * halo cells. The boundaries are handled by a BoundaryHandler, periodic ones are enabled with setPeriodic.
    * @param domainSize size of the domain that will be used for the simulation
    * @param cutoff cut off radius for the simulation
+   * @param skin skin radius of the Verlet list, 0 disables the Verlet list.
+   * If the Verlet list is used, the cells are at least cutoff + skin wide.
+   * @param rebuildFrequency number of steps after which the Verlet list is rebuilt, 0 to only rebuild on displacement
+   * @param cellSizeFactor edge length of the cells relative to cutoff + skin, in (0, 1]. Smaller cells need a larger
+   * stencil but check fewer pairs beyond the cutoff, e.g. 0.5 for cells of half the cutoff radius.
+   * @throws std::invalid_argument if cellSizeFactor is not in (0, 1]
    */
-  LinkedCellContainer(const std::array<double, 3> &domainSize, const double cutoff);
+  LinkedCellContainer(const std::array<double, 3> &domainSize, const double cutoff, const double skin = 0.,
+                      const int rebuildFrequency = 0, const double cellSizeFactor = 1.);
+
+  /**
+   * @brief The cells point to each other and into the cell vector, a copy would point into the original
+   */
+  LinkedCellContainer(const LinkedCellContainer &) = delete;
+
+  LinkedCellContainer &operator=(const LinkedCellContainer &) = delete;
+
+  /**
+   * @brief Moving keeps the buffer of the cell vector, so the pointers between the cells stay valid
+   */
+  LinkedCellContainer(LinkedCellContainer &&) = default;
+
+  LinkedCellContainer &operator=(LinkedCellContainer &&) = default;
+
+  /**
+   * @brief Rebuilds the cell grid and the Verlet list in place for another configuration.
+   *
+   * The container keeps its particles, including their forces, and its periodic boundaries. Storage indices are
+   * invalidated. Must not be called while periodic images exist.
+   * @param newCellSizeFactor edge length of the cells relative to cutoff + skin, in (0, 1]
+   * @param newSkin skin radius of the Verlet list, 0 disables the Verlet list
+   * @param newRebuildFrequency number of steps after which the Verlet list is rebuilt, 0 to only rebuild on
+   * displacement
+   * @throws std::invalid_argument if the cell size factor is not in (0, 1] or the cells do not fit the periodic
+   * boundaries
+   */
+  void reconfigure(double newCellSizeFactor, double newSkin, int newRebuildFrequency);
 
   /**
    * @brief Add the particle passed in to the container.
@@ -85,12 +286,37 @@ namespace ParticleContainers {
    */
   void addParticle(const Particle &particle) override;
 
+  /**
+   * @brief Append all particles of the passed storage to the container. They are binned once by the next sort,
+   * particles outside of the cell grid are dropped.
+   * @param newParticles the particles to be added.
+   */
+  void addParticles(const ParticleStorage &newParticles) override;
+
   /**
    * @brief Remove the particle passed from the container.
    * @param particle is the particle to be removed
   */
   void removeParticle(const Particle &particle);
 
+  /**
+   * @brief Marks the particle at a storage index to be removed by the next call of updateParticlesInCell.
+   *
+   * Removing many particles this way costs a single pass, the storage is compacted by the same counting sort
+   * that rebuilds the cells. Indices stay valid until the next sort.
+   * @param index storage index of the particle
+   */
+  void markForRemoval(size_t index);
+
+  /**
+   * This method returns a copy of the particle with the corresponding id
+   * @param id is a unique identifier
+   * @returns the corresponding particle
+   *
+   * Throws an error if the container does not contain a particle with this id
+   */
+  Particle getParticle(ParticleId id);
+
   /**
    * @brief allocates memory for the given number of particles
    * @param numParticles number of particles
@@ -99,14 +325,14 @@ namespace ParticleContainers {
 
 
   /**
-  * @return an iterator to the beginning of the particles vector.
+  * @return an iterator to the first particle.
   */
-  std::vector<Particle>::iterator begin() override;
+  ParticleIterator begin() override;
 
   /**
-  * @return an iterator to the end of the particles vector.
+  * @return an iterator past the last particle.
   */
-  std::vector<Particle>::iterator end() override;
+  ParticleIterator end() override;
 
   /**
   * @return an iterator to the beginning of the cells vector.
@@ -156,6 +382,11 @@ namespace ParticleContainers {
     */
   std::vector<Particle> getParticles() const override;
 
+  /**
+   * @return the structure-of-arrays storage of the particles
+   */
+  ParticleStorage &getStorage() override;
+
   /**
    *
    * @return size of the particles vector
@@ -166,7 +397,7 @@ namespace ParticleContainers {
    *
    * @return a vector containing the cells
    */
-  std::vector<Cell> getCells() const;
+  std::vector<Cell> getCells();
 
   /**
    *
@@ -192,12 +423,99 @@ namespace ParticleContainers {
    */
   std::vector<std::reference_wrapper<Cell>> getHaloCells();
 
+  /**
+   *
+   * @return the blocks of cell indices grouped by colour, see colouredBlocks
+   */
+  const std::vector<std::vector<std::vector<size_t> > > &getColouredBlocks() const;
+
+  /**
+   *
+   * @return for every colour the indices of the cells whose forces are complete after it, see cellsCompletedByColour
+   */
+  const std::vector<std::vector<size_t> > &getCellsCompletedByColour() const;
+
   /**
    * @brief Getter for the cutoff radius.
    * @return cutoff radius
    */
   double getCutoff() const;
 
+  /**
+   *
+   * @return the skin of the Verlet list
+   */
+  double getSkin() const;
+
+  /**
+   *
+   * @return the number of steps after which the Verlet list is rebuilt
+   */
+  int getRebuildFrequency() const;
+
+  /**
+   *
+   * @return the edge length of the cells relative to cutoff + skin that was requested
+   */
+  double getCellSizeFactor() const;
+
+  /**
+   *
+   * @return the number of halo cell layers, which is also the number of cells that cover cutoff + skin
+   */
+  int getHaloDepth() const;
+
+  /**
+   *
+   * @return true if forces are calculated with the Verlet list instead of the cells
+   */
+  bool usesVerletList() const;
+
+  /**
+   * @brief Returns the Verlet list for the next force calculation.
+   *
+   * The list is rebuilt if particles were added, if a particle moved further than skin / 2 since the last build
+   * or if rebuildFrequency steps passed. Otherwise the list of the last call is reused.
+   * Pairs in the list can be further apart than the cutoff radius and have to be checked by the caller.
+   * @return the pairs of storage indices that can interact
+   */
+  const std::vector<std::pair<size_t, size_t> > &getVerletPairs();
+
+  /**
+   * @brief Makes the boundaries along the passed axes periodic.
+   *
+   * Periodic axes need at least two times haloDepth cells, otherwise a particle could interact with its own image. The Verlet list
+   * does not know about periodic images and is disabled if any axis is periodic. The z axis is ignored in 2d.
+   * @param periodicAxes true for every axis x, y, z with periodic boundaries
+   */
+  void setPeriodic(const std::array<bool, 3> &periodicAxes);
+
+  /**
+   *
+   * @return true for every axis x, y, z with periodic boundaries
+   */
+  const std::array<bool, 3> &getPeriodic() const;
+
+  /**
+   *
+   * @return true if any axis has periodic boundaries
+   */
+  bool hasPeriodicBoundaries() const;
+
+  /**
+   * @brief Fills the halo cells of the periodic axes with images of the particles at the opposite side of the domain.
+   *
+   * The images are appended to the storage behind the real particles and carry their mass, type and id, so that
+   * the cell traversal computes the forces across periodic boundaries without further changes. The images have to
+   * be removed by removePeriodicImages before the particles are moved or sorted again.
+   */
+  void createPeriodicImages();
+
+  /**
+   * @brief Removes the images added by createPeriodicImages and empties their halo cells
+   */
+  void removePeriodicImages();
+
   /**
    * @brief Getter for domain size
    * @return an array containing the domain size
@@ -216,6 +534,12 @@ namespace ParticleContainers {
    */
   std::array<int, 3> getCellNumPerDimension() const;
 
+  /**
+   *
+   * @return true if the cell grid is three dimensional, false for a single layer of cells
+   */
+  bool isThreeDimensional() const;
+
   /**
    * @brief Computes which cell the passed particle should be added into based on its position
    * @param particle is the particle to be added
@@ -223,11 +547,72 @@ namespace ParticleContainers {
    */
   Cell* mapParticleToCell(const Particle &particle);
 
+  /**
+   * @brief Computes which cell a particle at the passed position belongs to
+   * @param particlePosition position of the particle
+   * @return a pointer to the Cell or nullptr if the position is outside of the grid
+   */
+  Cell* mapPositionToCell(const std::array<double, 3> &particlePosition);
+
 
   /**
-   * @brief Updates all cells according to changed particle positions*/
+   * @brief Updates all cells according to changed particle positions.
+   *
+   * The particles are sorted by cell with a counting sort, so that every cell owns a contiguous range of
+   * storage indices. If no particle changed its cell since the last call, only the cell ranges are
+   * recomputed and the storage is left untouched. Particles that crossed a periodic boundary are wrapped to the
+   * opposite side first. Particles that left the grid or were marked for removal are removed.
+   * Storage indices and ParticleRef handles are invalidated by this call.
+   */
   void updateParticlesInCell();
 
+  /**
+   * @brief Calls updateParticle for every particle and sorts the particles into their cells in the same sweep.
+   *
+   * Lets the integrator move the particles and bin them without a second pass over the storage, see
+   * updateParticlesInCell.
+   * @param updateParticle called with the storage index of every particle before its cell is computed
+   */
+  template<class Update>
+  void updateParticlesInCell(Update &&updateParticle) {
+   const size_t numParticles = particles.size();
+   particleCellIndices.resize(numParticles);
+   cellStarts.assign(cells.size() + 1, 0);
+
+   // count the particles per cell and check whether the storage is still ordered by cell
+   // particles added after the marking are kept
+   removalMarks.resize(removalMarks.empty() ? 0 : numParticles, false);
+   const bool wrap = hasPeriodicBoundaries();
+   bool ordered = true;
+   int previousCell = -1;
+   for (size_t i = 0; i < numParticles; ++i) {
+    updateParticle(i);
+    if (wrap) {
+     wrapPeriodicPosition(i);
+    }
+    int cell = removalMarks.empty() || !removalMarks[i]
+               ? cellIndexOfPosition(particles.x[i], particles.y[i], particles.z[i]) : -1;
+    particleCellIndices[i] = cell;
+    if (cell < 0) {
+     //the particle left the grid or was marked for removal and is dropped by the sort
+     ordered = false;
+     continue;
+    }
+    if (cell < previousCell) {
+     ordered = false;
+    }
+    previousCell = cell;
+    ++cellStarts[cell + 1];
+   }
+   sortIntoCells(ordered);
+  }
+
+  /**
+   * @brief Sorts the particles into their cells if particles were added or removed since the last sort.
+   * Positions changed outside of updateParticlesInCell are not detected.
+   */
+  void sortIfNecessary();
+
   /**
    * @brief computes the index of the passed cell based on its position in the cells grid.
    * @param x
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include "Objects/Particle.h"
+#include "Objects/ParticleStorage.h"
 namespace ParticleContainers {
     class ParticleContainer {
     public:
@@ -20,6 +21,12 @@ namespace ParticleContainers {
         */
         virtual void addParticle(const Particle& particle) = 0;
 
+        /**
+         * This method adds all particles of the passed storage into the container with a single reservation.
+         * @param newParticles the particles to be added, including their ids.
+         */
+        virtual void addParticles(const ParticleStorage& newParticles) = 0;
+
 
         /**
          * @return the number of particles in the container
@@ -29,14 +36,19 @@ namespace ParticleContainers {
         virtual std::vector<Particle> getParticles() const = 0;
 
         /**
-        * @return an iterator to the beginning of the particles vector.
+         * @return the structure-of-arrays storage holding the particles of the container
+         */
+        virtual ParticleStorage &getStorage() = 0;
+
+        /**
+        * @return an iterator to the first particle of the container.
         */
-        virtual std::vector<Particle>::iterator begin() = 0;
+        virtual ParticleIterator begin() = 0;
 
         /**
-        * @return an iterator to the end of the particles vector.
+        * @return an iterator past the last particle of the container.
         */
-        virtual std::vector<Particle>::iterator end() = 0;
+        virtual ParticleIterator end() = 0;
 
     };
 }
\ No newline at end of file
@@ -37,6 +37,10 @@ private:
  * Mean velocity of the particles in the cuboid.
  */
  const double mv;
+ /**
+ * Type of the particles in the cuboid.
+ */
+ const int type;
     public:
     /**
     * @brief Constructor with initializer list.
@@ -46,9 +50,10 @@ private:
     * @param m Mass of the particles.
     * @param v Initial velocity of the particles.
     * @param mv Mean velocity of the particles.
+    * @param type Type of the particles.
     */
     Cuboid(const std::array<double, 3> x, const std::array<double, 3> N, const double h, const double m, const std::array<double, 3> v
-    ,const double mv) : x(x), N(N), h(h), m(m), v(v), mv(mv){}
+    ,const double mv, const int type = 0) : x(x), N(N), h(h), m(m), v(v), mv(mv), type(type){}
 
     /**
     * @brief default destructor of the cuboid.
@@ -96,6 +101,13 @@ private:
     double  getMeanVelocity() const {
      return mv;
     }
+     /**
+    * @brief Get the type of particles in the cuboid.
+    * @return the type of particles in the cuboid.
+    */
+    int getType() const {
+     return type;
+    }
 
 };
 
@@ -30,6 +30,10 @@ private:
  * mass of molecules
  */
   double m;
+ /*
+ * type of molecules
+ */
+  int type;
 
 public:
  /**
@@ -38,9 +42,12 @@ public:
   * @param initVelocity: initial velocity of the whole disc
   * @param radius: radius in terms of the number of molecules along the radius
   * @param h: distance between molecules
+  * @param m: mass of molecules
+  * @param type: type of molecules
   */
- Disc(const  std::array<double, 3> centerCoordinate, const std::array<double,3> initVelocity, const int radius, const double h, const double m):
-centerCoordinate(centerCoordinate), initVelocity(initVelocity), radius(radius), h(h), m(m) {}
+ Disc(const  std::array<double, 3> centerCoordinate, const std::array<double,3> initVelocity, const int radius, const double h, const double m,
+      const int type = 0):
+centerCoordinate(centerCoordinate), initVelocity(initVelocity), radius(radius), h(h), m(m), type(type) {}
 
  /**
   * @return center coordinate of the disc
@@ -75,6 +82,12 @@ centerCoordinate(centerCoordinate), initVelocity(initVelocity), radius(radius),
  double getMass() const {
   return m;
  }
+ /**
+  * @return type of molecules
+  */
+ int getType() const {
+  return type;
+ }
 };
 
 
@@ -38,6 +38,13 @@ Particle::Particle(std::array<double, 3> x_arg, std::array<double, 3> v_arg,
   SPDLOG_DEBUG("Particle with id {} generated by value!", id);
 }
 
+Particle::Particle(std::array<double, 3> x_arg, std::array<double, 3> v_arg,
+                   std::array<double, 3> f_arg, std::array<double, 3> old_f_arg,
+                   double m_arg, int type_arg, ParticleId id_arg)
+    : x(x_arg), v(v_arg), f(f_arg), old_f(old_f_arg), m(m_arg), type(type_arg), id(id_arg) {
+  SPDLOG_DEBUG("Particle with id {} generated from storage!", id);
+}
+
 Particle::~Particle() {SPDLOG_DEBUG("Particle destructed!");}
 
 const std::array<double, 3> &Particle::getX() const { return x; }
@@ -48,7 +55,7 @@ const std::array<double, 3> &Particle::getF() const { return f; }
 
 const std::array<double, 3> &Particle::getOldF() const { return old_f; }
 
-int Particle::getID() const { return id; }
+ParticleId Particle::getID() const { return id; }
 
 double Particle::getM() const { return m; }
 
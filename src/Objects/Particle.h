@@ -50,7 +50,7 @@ private:
   *  The ids of shadow particles are the negated ids of their corresponding particles in the boundary
  */
 
-int id;
+ParticleId id;
 
 public:
  explicit Particle(int type = 0);
@@ -63,6 +63,14 @@ public:
      std::array<double, 3> x_arg, std::array<double, 3> v_arg, double m_arg,
      int type = 0);
 
+ /**
+  * Creates a particle with the complete given state, including its id.
+  * Used to copy particles out of a ParticleStorage, therefore no new id is generated.
+  */
+ Particle(std::array<double, 3> x_arg, std::array<double, 3> v_arg,
+          std::array<double, 3> f_arg, std::array<double, 3> old_f_arg,
+          double m_arg, int type_arg, ParticleId id_arg);
+
  virtual ~Particle();
 
  const std::array<double, 3> &getX() const;
@@ -73,7 +81,7 @@ public:
 
  const std::array<double, 3> &getOldF() const;
 
- int getID() const;
+ ParticleId getID() const;
 
  double getM() const;
 
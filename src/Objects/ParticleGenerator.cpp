@@ -4,11 +4,28 @@
 
 #include "ParticleGenerator.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "spdlog/spdlog.h"
+#include "Objects/Containers/ParticleContainer.h"
+#include "Objects/ParticleIdInitializer.h"
 #include "utils/MaxwellBoltzmannDistribution.h"
 
 
-void ParticleGenerator::generateCuboid(ParticleContainers::ParticleContainer &particles, Cuboid &cuboid) {
+void ParticleGenerator::generateCuboid(ParticleContainers::ParticleContainer &particles, Cuboid &cuboid, uint64_t shapeIndex) {
+    ParticleStorage newParticles;
+    generateCuboid(newParticles, cuboid, shapeIndex);
+    particles.addParticles(newParticles);
+}
+
+void ParticleGenerator::generateDisc(ParticleContainers::ParticleContainer &particles, Disc &disc) {
+    ParticleStorage newParticles;
+    generateDisc(newParticles, disc);
+    particles.addParticles(newParticles);
+}
+
+void ParticleGenerator::generateCuboid(ParticleStorage &particles, const Cuboid &cuboid, uint64_t shapeIndex) {
     // iterate over the specified dimensions and generate particles
     SPDLOG_DEBUG("generating cuboid particles");
     std::array<double,3> N = cuboid.getNumOfParticlesPerDimension();
@@ -17,53 +34,83 @@ void ParticleGenerator::generateCuboid(ParticleContainers::ParticleContainer &pa
     double h = cuboid.getDistBetweenParticles();
     double mv = cuboid.getMeanVelocity();
     double m = cuboid.getMass();
-    for (int k=0; k < N[2];++k) {
-        for (int j=0; j < N[1];++j) {
-            for (int i=0; i < N[0];++i) {
+    const int type = cuboid.getType();
+    const int nx = std::max(static_cast<int>(N[0]), 0);
+    const int ny = std::max(static_cast<int>(N[1]), 0);
+    const int nz = std::max(static_cast<int>(N[2]), 0);
+    const size_t numParticles = static_cast<size_t>(nx) * ny * nz;
+    // the new particles are written into place, every lattice point knows its index in the storage
+    const size_t offset = particles.size();
+    particles.resize(offset + numParticles);
+    // the ids of the whole cuboid are claimed at once
+    const ParticleId firstId = ParticleIdInitializer::reserveRange(numParticles);
+#pragma omp parallel for collapse(2) schedule(static)
+    for (int k=0; k < nz;++k) {
+        for (int j=0; j < ny;++j) {
+            for (int i=0; i < nx;++i) {
+                const size_t latticeIndex = (static_cast<size_t>(k) * ny + j) * nx + i;
+                const size_t index = offset + latticeIndex;
                 // calculate x,y,z coordinates
-                double x_coor = x[0] + i*h;
-                double y_coor = x[1] + j*h;
-                double z_coor = x[2] + k*h;
-                std::array<double, 3> particle_pos = {x_coor,y_coor,z_coor};
-                // get the maxwell velocity
-                std::array<double, 3> maxwell_vel = maxwellBoltzmannDistributedVelocity(mv,2);
-                // get the initial velocity
-                std::array<double, 3> vel = v;
-                // add maxwell velocity to initial velocity? --> I don't know if this is what we are supposed
-                for (int m = 0; m < 3; ++m) {
-                    vel[m] += maxwell_vel[m];
-                }
-                // create new particle
-                Particle nParticle(particle_pos,vel,m,0);
-                // add new particle to container
-                particles.addParticle(nParticle);
+                particles.x[index] = x[0] + i*h;
+                particles.y[index] = x[1] + j*h;
+                particles.z[index] = x[2] + k*h;
+                // get the maxwell velocity of this lattice point
+                std::array<double, 3> maxwell_vel = maxwellBoltzmannDistributedVelocity(mv, 2, seed, shapeIndex, latticeIndex);
+                // add maxwell velocity to initial velocity
+                particles.vx[index] = v[0] + maxwell_vel[0];
+                particles.vy[index] = v[1] + maxwell_vel[1];
+                particles.vz[index] = v[2] + maxwell_vel[2];
+                particles.m[index] = m;
+                particles.type[index] = type;
+                particles.id[index] = firstId + static_cast<ParticleId>(latticeIndex);
             }
         }
     }
 }
 
-void ParticleGenerator::generateDisc(ParticleContainers::ParticleContainer &particles, Disc &disc) {
+void ParticleGenerator::generateDisc(ParticleStorage &particles, const Disc &disc) {
     const std::array<double, 3> center = disc.getCenterCoordinate();
     const  std::array<double, 3> initVel = disc.getInitVelocity();
     const int r = disc.getRadius();
     const double mass = disc.getMass();
     const double h = disc.getDistanceBetweenParticles();
+    const int type = disc.getType();
     SPDLOG_DEBUG("generating disc particles");
     SPDLOG_DEBUG("r: {}", r);
+    if (r < 0) {
+        return;
+    }
+    // storage index of the first point of every row inside the circle j*j + i*i <= r*r
+    std::vector<size_t> rowStarts(2 * r + 2, particles.size());
     for (int i = -r ; i <= r ; ++i) {
-        SPDLOG_DEBUG("column {}", i);
-        // check if position is inside the circle j*j + i*i <= r*r
+        int rowLength = 0;
         for (int j = -r ; j <= r; ++j) {
             if (((j*j) + (i*i) <= r*r)) {
-                SPDLOG_DEBUG("line {}", j);
-                const std::array<double, 3> particlePosition = {center[0] + j*h, center[1] + i*h, center[2]};
-                // create new particle
-                Particle nParticle(particlePosition,initVel, mass,0);
-                // add new particle to container
-                particles.addParticle(nParticle);
+                ++rowLength;
+            }
+        }
+        rowStarts[i + r + 1] = rowStarts[i + r] + rowLength;
+    }
+    const size_t offset = particles.size();
+    const size_t numParticles = rowStarts.back() - offset;
+    particles.resize(offset + numParticles);
+    const ParticleId firstId = ParticleIdInitializer::reserveRange(numParticles);
+#pragma omp parallel for schedule(static)
+    for (int i = -r ; i <= r ; ++i) {
+        size_t index = rowStarts[i + r];
+        for (int j = -r ; j <= r; ++j) {
+            if (((j*j) + (i*i) <= r*r)) {
+                particles.x[index] = center[0] + j*h;
+                particles.y[index] = center[1] + i*h;
+                particles.z[index] = center[2];
+                particles.vx[index] = initVel[0];
+                particles.vy[index] = initVel[1];
+                particles.vz[index] = initVel[2];
+                particles.m[index] = mass;
+                particles.type[index] = type;
+                particles.id[index] = firstId + static_cast<ParticleId>(index - offset);
+                ++index;
             }
         }
     }
-
-
 }
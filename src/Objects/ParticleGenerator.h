@@ -3,26 +3,51 @@
 //
 
 #pragma once
+#include <cstdint>
 #include "Cuboid.h"
 #include "Disc.h"
+#include "ParticleStorage.h"
 /**class that generates particles from a given cuboid or disc */
 class ParticleGenerator {
 
 public:
+   /**
+   * @brief seed of the Maxwell-Boltzmann velocities, every shape draws from its own stream of this seed
+   */
+   static constexpr uint64_t seed = 42;
+
    ParticleGenerator() = default;
    ~ParticleGenerator() = default;
    /**
    * @brief generates particles from a given cuboid
    * @param particles empty Particle container where particles will be inserted
    * @param cuboid Cuboid that defines parameters
+   * @param shapeIndex index of the shape in the input, selects the random stream of the velocities
    */
-   static void generateCuboid(ParticleContainers::ParticleContainer &particles, Cuboid& cuboid);
+   static void generateCuboid(ParticleContainers::ParticleContainer &particles, Cuboid& cuboid, uint64_t shapeIndex = 0);
    /**
    * @brief generates particles from a given disc
    * @param particles empty Particle container where particles will be inserted
    * @param disc Disc that defines parameters
    */
    static void generateDisc(ParticleContainers::ParticleContainer &particles, Disc& disc);
+   /**
+   * @brief appends the particles of a cuboid to a storage, which is resized only once
+   *
+   * The particles are generated in parallel. The Maxwell-Boltzmann velocity of every particle is drawn from a
+   * counter-based random number generator keyed by (seed, shapeIndex, lattice index), so the result does not
+   * depend on the number of threads.
+   * @param particles storage the particles are appended to, pass it to ParticleContainer::addParticles afterwards
+   * @param cuboid Cuboid that defines parameters
+   * @param shapeIndex index of the shape in the input, selects the random stream of the velocities
+   */
+   static void generateCuboid(ParticleStorage &particles, const Cuboid& cuboid, uint64_t shapeIndex = 0);
+   /**
+   * @brief appends the particles of a disc to a storage, which is resized only once
+   *
+   * The rows of the disc are generated in parallel.
+   * @param particles storage the particles are appended to, pass it to ParticleContainer::addParticles afterwards
+   * @param disc Disc that defines parameters
+   */
+   static void generateDisc(ParticleStorage &particles, const Disc& disc);
 };
-
-
@@ -2,19 +2,21 @@
 // Created by Stefanie Blattenberger on 28/11/2024.
 //
 
-#include <mutex>
+#include <atomic>
 #include "ParticleIdInitializer.h"
 
-int id = 1;
-std::mutex id_mutex;
+namespace {
+    std::atomic<ParticleId> nextId{1};
+}
 
-int ParticleIdInitializer::getNewId(){
-        id_mutex.lock();
-        int newID = id++;
-        id_mutex.unlock();
-        return newID;
+ParticleId ParticleIdInitializer::getNewId(){
+        return nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+ParticleId ParticleIdInitializer::reserveRange(std::size_t count){
+        return nextId.fetch_add(static_cast<ParticleId>(count), std::memory_order_relaxed);
     }
 
 void ParticleIdInitializer::reset(){
-        id = 1;
-}
\ No newline at end of file
+        nextId.store(1, std::memory_order_relaxed);
+}
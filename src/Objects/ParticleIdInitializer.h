@@ -3,14 +3,27 @@
 // Created by Stefanie Blattenberger on 28/11/2024.
 //
 
+#include <cstddef>
+#include <cstdint>
+
+/** Type of the unique particle ids, 64 bit wide so that long runs with particle insertion do not overflow */
+using ParticleId = std::int64_t;
+
 /**Namespace that provides functionality for creating unique particle ids */
 namespace ParticleIdInitializer {
 
 /**Returns a new unique id. The ids start with 1 and are returned in ascending order.
- * Guarantees unique ids even if several particles are created parallelly.
- * @returns unique int id for a new particle
+ * Guarantees unique ids even if several particles are created parallelly, the counter is a lock-free atomic.
+ * @returns unique id for a new particle
+ */
+    ParticleId getNewId();
+
+/**Claims count consecutive ids with a single atomic operation.
+ * Used to give the particles of a whole cuboid or input file their ids at once.
+ * @param count number of ids
+ * @returns the first id of the range, the range is [first, first + count)
  */
-    int getNewId();
+    ParticleId reserveRange(std::size_t count);
 
 /**Resets the ParticleIdInitializer to id = 1
  * Only used for testing purposes
@@ -0,0 +1,138 @@
+//
+// ParticleStorage.cpp
+//
+
+#include "ParticleStorage.h"
+
+#include <sstream>
+#include "utils/ArrayUtils.h"
+
+std::string ParticleRef::toString() const {
+    std::stringstream stream;
+    stream << "Particle: X:" << getX() << " v: " << getV() << " f: " << getF()
+           << " old_f: " << getOldF() << " type: " << getType() << " id: " << getID();
+    return stream.str();
+}
+
+ParticleRef::operator Particle() const {
+    return storage->get(index);
+}
+
+void ParticleStorage::reserve(size_t numParticles) {
+    for (auto *array: {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &oldFx, &oldFy, &oldFz, &m}) {
+        array->reserve(numParticles);
+    }
+    type.reserve(numParticles);
+    id.reserve(numParticles);
+}
+
+void ParticleStorage::resize(size_t numParticles) {
+    for (auto *array: {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &oldFx, &oldFy, &oldFz, &m}) {
+        array->resize(numParticles, 0.);
+    }
+    type.resize(numParticles, 0);
+    id.resize(numParticles, 0);
+}
+
+void ParticleStorage::clear() {
+    resize(0);
+}
+
+void ParticleStorage::push_back(const Particle &particle) {
+    const std::array<double, 3> &pX = particle.getX();
+    const std::array<double, 3> &pV = particle.getV();
+    const std::array<double, 3> &pF = particle.getF();
+    const std::array<double, 3> &pOldF = particle.getOldF();
+    x.push_back(pX[0]);
+    y.push_back(pX[1]);
+    z.push_back(pX[2]);
+    vx.push_back(pV[0]);
+    vy.push_back(pV[1]);
+    vz.push_back(pV[2]);
+    fx.push_back(pF[0]);
+    fy.push_back(pF[1]);
+    fz.push_back(pF[2]);
+    oldFx.push_back(pOldF[0]);
+    oldFy.push_back(pOldF[1]);
+    oldFz.push_back(pOldF[2]);
+    m.push_back(particle.getM());
+    type.push_back(particle.getType());
+    id.push_back(particle.getID());
+}
+
+void ParticleStorage::append(const ParticleStorage &other) {
+    // insert grows the arrays geometrically, an exact reserve would reallocate on every call
+    for (auto array: {&ParticleStorage::x, &ParticleStorage::y, &ParticleStorage::z,
+                      &ParticleStorage::vx, &ParticleStorage::vy, &ParticleStorage::vz,
+                      &ParticleStorage::fx, &ParticleStorage::fy, &ParticleStorage::fz,
+                      &ParticleStorage::oldFx, &ParticleStorage::oldFy, &ParticleStorage::oldFz, &ParticleStorage::m}) {
+        (this->*array).insert((this->*array).end(), (other.*array).begin(), (other.*array).end());
+    }
+    type.insert(type.end(), other.type.begin(), other.type.end());
+    id.insert(id.end(), other.id.begin(), other.id.end());
+}
+
+void ParticleStorage::erase(size_t index) {
+    for (auto *array: {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &oldFx, &oldFy, &oldFz, &m}) {
+        array->erase(array->begin() + index);
+    }
+    type.erase(type.begin() + index);
+    id.erase(id.begin() + index);
+}
+
+size_t ParticleStorage::eraseIf(const std::vector<bool> &remove) {
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        if (remove[i]) {
+            continue;
+        }
+        if (kept != i) {
+            for (auto *array: {&x, &y, &z, &vx, &vy, &vz, &fx, &fy, &fz, &oldFx, &oldFy, &oldFz, &m}) {
+                (*array)[kept] = (*array)[i];
+            }
+            type[kept] = type[i];
+            id[kept] = id[i];
+        }
+        ++kept;
+    }
+    size_t removed = size() - kept;
+    resize(kept);
+    return removed;
+}
+
+void ParticleStorage::gather(const ParticleStorage &source, const std::vector<size_t> &order) {
+    const size_t numParticles = order.size();
+    resize(numParticles);
+    std::vector<double> ParticleStorage::*const arrays[] = {
+        &ParticleStorage::x, &ParticleStorage::y, &ParticleStorage::z,
+        &ParticleStorage::vx, &ParticleStorage::vy, &ParticleStorage::vz,
+        &ParticleStorage::fx, &ParticleStorage::fy, &ParticleStorage::fz,
+        &ParticleStorage::oldFx, &ParticleStorage::oldFy, &ParticleStorage::oldFz, &ParticleStorage::m
+    };
+    for (auto array: arrays) {
+        const std::vector<double> &from = source.*array;
+        double *to = (this->*array).data();
+        for (size_t k = 0; k < numParticles; ++k) {
+            to[k] = from[order[k]];
+        }
+    }
+    for (size_t k = 0; k < numParticles; ++k) {
+        type[k] = source.type[order[k]];
+        id[k] = source.id[order[k]];
+    }
+}
+
+size_t ParticleStorage::findIndex(ParticleId particleId) const {
+    for (size_t i = 0; i < id.size(); ++i) {
+        if (id[i] == particleId) {
+            return i;
+        }
+    }
+    return size();
+}
+
+Particle ParticleStorage::get(size_t index) const {
+    return {{x[index], y[index], z[index]}, {vx[index], vy[index], vz[index]},
+            {fx[index], fy[index], fz[index]}, {oldFx[index], oldFy[index], oldFz[index]},
+            m[index], type[index], id[index]};
+}
@@ -0,0 +1,314 @@
+//
+// ParticleStorage.h
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Particle.h"
+
+class ParticleStorage;
+
+/**
+ * @brief Handle to a single particle inside a ParticleStorage.
+ *
+ * Offers the same getters and setters as Particle, but reads and writes the
+ * structure-of-arrays storage directly. Handles are cheap to copy and are
+ * invalidated if the storage is reordered or particles are removed.
+ */
+class ParticleRef {
+private:
+    /**
+     * @brief the storage the particle lives in
+     */
+    ParticleStorage *storage;
+
+    /**
+     * @brief index of the particle inside the storage
+     */
+    size_t index;
+
+public:
+    /**
+     * @brief Constructor for a handle to the particle at position index of storage
+     * @param storage the storage that contains the particle
+     * @param index position of the particle in the storage
+     */
+    ParticleRef(ParticleStorage &storage, size_t index) : storage(&storage), index(index) {}
+
+    std::array<double, 3> getX() const;
+
+    std::array<double, 3> getV() const;
+
+    std::array<double, 3> getF() const;
+
+    std::array<double, 3> getOldF() const;
+
+    ParticleId getID() const;
+
+    double getM() const;
+
+    int getType() const;
+
+    void setF(const std::array<double, 3> &newF);
+
+    void setOldF(const std::array<double, 3> &newOldF);
+
+    void setX(const std::array<double, 3> &X);
+
+    void setV(const std::array<double, 3> &V);
+
+    /**
+     * @return the position of the particle inside the storage
+     */
+    size_t getIndex() const { return index; }
+
+    std::string toString() const;
+
+    /**
+     * @brief Copies the referenced particle out of the storage.
+     */
+    operator Particle() const;
+};
+
+/**
+ * @brief Random access iterator over the particles of a ParticleStorage. Dereferencing yields a ParticleRef.
+ */
+class ParticleIterator {
+private:
+    ParticleStorage *storage = nullptr;
+    size_t index = 0;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Particle;
+    using difference_type = std::ptrdiff_t;
+    using reference = ParticleRef;
+
+    /**
+     * @brief Helper that makes it->getX() work although dereferencing returns a temporary handle.
+     */
+    struct ArrowProxy {
+        ParticleRef ref;
+
+        ParticleRef *operator->() { return &ref; }
+    };
+
+    using pointer = ArrowProxy;
+
+    ParticleIterator() = default;
+
+    ParticleIterator(ParticleStorage &storage, size_t index) : storage(&storage), index(index) {}
+
+    ParticleRef operator*() const { return {*storage, index}; }
+
+    ArrowProxy operator->() const { return ArrowProxy{ParticleRef(*storage, index)}; }
+
+    ParticleRef operator[](difference_type n) const { return {*storage, index + n}; }
+
+    ParticleIterator &operator++() {
+        ++index;
+        return *this;
+    }
+
+    ParticleIterator operator++(int) {
+        ParticleIterator tmp = *this;
+        ++index;
+        return tmp;
+    }
+
+    ParticleIterator &operator--() {
+        --index;
+        return *this;
+    }
+
+    ParticleIterator operator--(int) {
+        ParticleIterator tmp = *this;
+        --index;
+        return tmp;
+    }
+
+    ParticleIterator &operator+=(difference_type n) {
+        index += n;
+        return *this;
+    }
+
+    ParticleIterator &operator-=(difference_type n) {
+        index -= n;
+        return *this;
+    }
+
+    ParticleIterator operator+(difference_type n) const { return {*storage, index + n}; }
+
+    ParticleIterator operator-(difference_type n) const { return {*storage, index - n}; }
+
+    difference_type operator-(const ParticleIterator &other) const {
+        return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+    }
+
+    bool operator==(const ParticleIterator &other) const { return index == other.index; }
+
+    bool operator!=(const ParticleIterator &other) const { return index != other.index; }
+
+    bool operator<(const ParticleIterator &other) const { return index < other.index; }
+
+    /**
+     * @return the position inside the storage the iterator points to
+     */
+    size_t getIndex() const { return index; }
+};
+
+/**
+ * @brief Structure-of-arrays storage for particles.
+ *
+ * Every particle attribute lives in its own contiguous array, so that kernels which only need
+ * positions (e.g. the force calculation) do not have to pull velocities, masses and ids through the cache.
+ * The particle with index i is made up of the i-th entry of every array.
+ */
+class ParticleStorage {
+public:
+    /** Positions */
+    std::vector<double> x, y, z;
+    /** Velocities */
+    std::vector<double> vx, vy, vz;
+    /** Forces of the current iteration */
+    std::vector<double> fx, fy, fz;
+    /** Forces of the previous iteration */
+    std::vector<double> oldFx, oldFy, oldFz;
+    /** Masses */
+    std::vector<double> m;
+    /** Types */
+    std::vector<int> type;
+    /** Ids */
+    std::vector<ParticleId> id;
+
+    /**
+     * @return number of stored particles
+     */
+    size_t size() const { return x.size(); }
+
+    /**
+     * @return true if no particles are stored
+     */
+    bool empty() const { return x.empty(); }
+
+    /**
+     * @brief allocates memory for the given number of particles in every array
+     * @param numParticles number of particles
+     */
+    void reserve(size_t numParticles);
+
+    /**
+     * @brief resizes every array to hold numParticles particles. New particles are zero initialized.
+     * @param numParticles number of particles
+     */
+    void resize(size_t numParticles);
+
+    /**
+     * @brief removes all particles
+     */
+    void clear();
+
+    /**
+     * @brief appends a copy of the passed particle
+     * @param particle is the particle to be added
+     */
+    void push_back(const Particle &particle);
+
+    /**
+     * @brief appends copies of all particles of other. Each array grows geometrically through insert, so repeated
+     * appends reallocate only a logarithmic number of times
+     * @param other storage containing the particles to be added, must not be this storage
+     */
+    void append(const ParticleStorage &other);
+
+    /**
+     * @brief removes the particle at position index. The order of the remaining particles is preserved.
+     * @param index position of the particle to be removed
+     */
+    void erase(size_t index);
+
+    /**
+     * @brief removes all particles whose entry in remove is true. The order of the remaining particles is preserved.
+     * @param remove flag for every particle in the storage
+     * @return number of removed particles
+     */
+    size_t eraseIf(const std::vector<bool> &remove);
+
+    /**
+     * @brief replaces the content of this storage by the particles of source in the given order
+     * @param source storage to copy the particles from, must not be this storage
+     * @param order storage indices in source, the k-th particle of this storage becomes source[order[k]]
+     */
+    void gather(const ParticleStorage &source, const std::vector<size_t> &order);
+
+    /**
+     * @brief finds a particle by its id
+     * @param particleId id of the particle
+     * @return position of the particle or size() if there is no such particle
+     */
+    size_t findIndex(ParticleId particleId) const;
+
+    /**
+     * @param index position of the particle
+     * @return a copy of the particle at position index
+     */
+    Particle get(size_t index) const;
+
+    ParticleRef operator[](size_t index) { return {*this, index}; }
+
+    ParticleIterator begin() { return {*this, 0}; }
+
+    ParticleIterator end() { return {*this, size()}; }
+};
+
+inline std::array<double, 3> ParticleRef::getX() const {
+    return {storage->x[index], storage->y[index], storage->z[index]};
+}
+
+inline std::array<double, 3> ParticleRef::getV() const {
+    return {storage->vx[index], storage->vy[index], storage->vz[index]};
+}
+
+inline std::array<double, 3> ParticleRef::getF() const {
+    return {storage->fx[index], storage->fy[index], storage->fz[index]};
+}
+
+inline std::array<double, 3> ParticleRef::getOldF() const {
+    return {storage->oldFx[index], storage->oldFy[index], storage->oldFz[index]};
+}
+
+inline ParticleId ParticleRef::getID() const { return storage->id[index]; }
+
+inline double ParticleRef::getM() const { return storage->m[index]; }
+
+inline int ParticleRef::getType() const { return storage->type[index]; }
+
+inline void ParticleRef::setF(const std::array<double, 3> &newF) {
+    storage->fx[index] = newF[0];
+    storage->fy[index] = newF[1];
+    storage->fz[index] = newF[2];
+}
+
+inline void ParticleRef::setOldF(const std::array<double, 3> &newOldF) {
+    storage->oldFx[index] = newOldF[0];
+    storage->oldFy[index] = newOldF[1];
+    storage->oldFz[index] = newOldF[2];
+}
+
+inline void ParticleRef::setX(const std::array<double, 3> &X) {
+    storage->x[index] = X[0];
+    storage->y[index] = X[1];
+    storage->z[index] = X[2];
+}
+
+inline void ParticleRef::setV(const std::array<double, 3> &V) {
+    storage->vx[index] = V[0];
+    storage->vy[index] = V[1];
+    storage->vz[index] = V[2];
+}
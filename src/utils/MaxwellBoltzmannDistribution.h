@@ -7,27 +7,60 @@
 
 #pragma once
 
-#include <random>
 #include <array>
+#include <cmath>
+#include <cstdint>
 
 /**
- * Generate a random velocity vector according to the Maxwell-Boltzmann distribution, with a given average velocity.
+ * Counter-based random number generator: returns a pseudo random 64 bit value that depends only on the key
+ * (seed, stream, counter). The key is mixed with the SplitMix64 finalizer, so no state is shared between calls and
+ * the values can be drawn in any order and from any number of threads.
+ *
+ * @param seed global seed of the simulation
+ * @param stream independent sequence, e.g. the index of the generated shape
+ * @param counter position inside the sequence, e.g. the lattice index of the particle
+ * @return uniformly distributed 64 bit value
+ */
+inline uint64_t counterBasedRandom(uint64_t seed, uint64_t stream, uint64_t counter) {
+  auto mix = [](uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  };
+  const uint64_t golden = 0x9E3779B97F4A7C15ULL;
+  return mix(mix(mix(seed + golden) + stream * golden) + counter * golden);
+}
+
+/**
+ * Generate the Maxwell-Boltzmann velocity of a single particle with a counter-based random number generator.
+ * The result depends only on the key, therefore particles can be generated in parallel and in any order with
+ * results that do not depend on the number of threads.
  *
  * @param averageVelocity The average velocity of the brownian motion for the system.
  * @param dimensions Number of dimensions for which the velocity vector shall be generated. Set this to 2 or 3.
+ * @param seed global seed of the simulation
+ * @param stream independent sequence, e.g. the index of the generated shape
+ * @param index index of the particle inside the stream
  * @return Array containing the generated velocity vector.
  */
-std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
-  // we use a constant seed for repeatability.
-  // random engine needs static lifetime otherwise it would be recreated for every call.
-  static std::default_random_engine randomEngine(42);
-
-  // when adding independent normally distributed values to all velocity components
-  // the velocity change is maxwell boltzmann distributed
-  std::normal_distribution<double> normalDistribution{0, 1};
+inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions,
+                                                                  uint64_t seed, uint64_t stream, uint64_t index) {
+  // Box-Muller transform, every pair of uniform values gives two independent normally distributed values
+  constexpr double twoPi = 6.283185307179586;
+  std::array<double, 4> normal{};
+  for (uint64_t pair = 0; 2 * pair < dimensions; ++pair) {
+    const uint64_t first = counterBasedRandom(seed, stream, 4 * index + 2 * pair);
+    const uint64_t second = counterBasedRandom(seed, stream, 4 * index + 2 * pair + 1);
+    // uniform values in (0, 1] and [0, 1) with 53 random bits
+    const double u1 = static_cast<double>((first >> 11) + 1) * 0x1.0p-53;
+    const double u2 = static_cast<double>(second >> 11) * 0x1.0p-53;
+    const double radius = std::sqrt(-2.0 * std::log(u1));
+    normal[2 * pair] = radius * std::cos(twoPi * u2);
+    normal[2 * pair + 1] = radius * std::sin(twoPi * u2);
+  }
   std::array<double, 3> randomVelocity{};
   for (size_t i = 0; i < dimensions; ++i) {
-    randomVelocity[i] = averageVelocity * normalDistribution(randomEngine);
+    randomVelocity[i] = averageVelocity * normal[i];
   }
   return randomVelocity;
 }
@@ -0,0 +1,135 @@
+//
+// PhaseTimers.cpp
+//
+
+#include "PhaseTimers.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char *const phaseNames[PhaseTimers::numPhases] = {"position", "force", "boundary", "output", "checkpoint", "tuning"};
+
+    double seconds(PhaseTimers::Clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    bool endsWith(const std::string &string, const std::string &suffix) {
+        return string.size() >= suffix.size() &&
+               string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+PhaseTimers::PhaseTimers() : start(Clock::now()), windowStart(start) {}
+
+void PhaseTimers::setDump(const std::string &filename, int frequency) {
+    dumpFrequency = frequency;
+    if (frequency <= 0) {
+        return;
+    }
+    dumpFile.open(filename, std::ios::trunc);
+    if (!dumpFile) {
+        throw std::runtime_error("Could not open " + filename + " for writing");
+    }
+    dumpJson = endsWith(filename, ".json");
+    if (!dumpJson) {
+        dumpFile << "iteration,particles";
+        for (const char *name: phaseNames) {
+            dumpFile << "," << name;
+        }
+        dumpFile << ",wall,MUPS\n";
+    }
+}
+
+void PhaseTimers::add(Phase phase, Clock::duration duration) {
+    current[static_cast<size_t>(phase)] += seconds(duration);
+}
+
+void PhaseTimers::endIteration(int iteration, size_t numParticles) {
+    for (size_t phase = 0; phase < numPhases; ++phase) {
+        samples[phase].push_back(static_cast<float>(current[phase]));
+        totals[phase] += current[phase];
+        windowTotals[phase] += current[phase];
+        current[phase] = 0;
+    }
+    ++iterations;
+    particleUpdates += static_cast<double>(numParticles);
+    windowUpdates += static_cast<double>(numParticles);
+
+    if (dumpFrequency > 0 && iteration % dumpFrequency == 0) {
+        writeDump(iteration, numParticles);
+    }
+}
+
+void PhaseTimers::writeDump(int iteration, size_t numParticles) {
+    const Clock::time_point now = Clock::now();
+    const double wall = seconds(now - windowStart);
+    const double mups = wall > 0 ? windowUpdates / wall * 1e-6 : 0.0;
+    if (dumpJson) {
+        dumpFile << "{\"iteration\":" << iteration << ",\"particles\":" << numParticles;
+        for (size_t phase = 0; phase < numPhases; ++phase) {
+            dumpFile << ",\"" << phaseNames[phase] << "\":" << windowTotals[phase];
+        }
+        dumpFile << ",\"wall\":" << wall << ",\"MUPS\":" << mups << "}\n";
+    } else {
+        dumpFile << iteration << "," << numParticles;
+        for (double total: windowTotals) {
+            dumpFile << "," << total;
+        }
+        dumpFile << "," << wall << "," << mups << "\n";
+    }
+    dumpFile.flush();
+    windowTotals.fill(0);
+    windowUpdates = 0;
+    windowStart = now;
+}
+
+double PhaseTimers::getTotal(Phase phase) const {
+    return totals[static_cast<size_t>(phase)];
+}
+
+double PhaseTimers::getPercentile(Phase phase, double fraction) const {
+    std::vector<float> sorted = samples[static_cast<size_t>(phase)];
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+double PhaseTimers::getMUPS() const {
+    const double wall = seconds(Clock::now() - start);
+    return wall > 0 ? particleUpdates / wall * 1e-6 : 0.0;
+}
+
+std::string PhaseTimers::summary() const {
+    const double wall = seconds(Clock::now() - start);
+    const double timed = std::accumulate(totals.begin(), totals.end(), 0.0);
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    stream << std::left << std::setw(12) << "phase" << std::right
+           << std::setw(12) << "total [s]" << std::setw(9) << "share"
+           << std::setw(12) << "mean [ms]" << std::setw(12) << "p50 [ms]" << std::setw(12) << "p90 [ms]"
+           << std::setw(12) << "p99 [ms]" << std::setw(12) << "max [ms]" << "\n";
+    for (size_t phase = 0; phase < numPhases; ++phase) {
+        const auto p = static_cast<Phase>(phase);
+        const double mean = iterations > 0 ? totals[phase] / static_cast<double>(iterations) : 0.0;
+        stream << std::left << std::setw(12) << phaseNames[phase] << std::right
+               << std::setw(12) << totals[phase]
+               << std::setw(8) << (wall > 0 ? 100 * totals[phase] / wall : 0.0) << "%"
+               << std::setw(12) << 1e3 * mean
+               << std::setw(12) << 1e3 * getPercentile(p, 0.5)
+               << std::setw(12) << 1e3 * getPercentile(p, 0.9)
+               << std::setw(12) << 1e3 * getPercentile(p, 0.99)
+               << std::setw(12) << 1e3 * getPercentile(p, 1.0) << "\n";
+    }
+    stream << std::left << std::setw(12) << "other" << std::right << std::setw(12) << std::max(0.0, wall - timed)
+           << "\n";
+    stream << std::left << std::setw(12) << "wall" << std::right << std::setw(12) << wall << "\n";
+    stream << iterations << " iterations, " << std::setprecision(2) << getMUPS() << " million molecule updates per second";
+    return stream.str();
+}
@@ -0,0 +1,147 @@
+//
+// PhaseTimers.h
+//
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief phases of one iteration of the simulation loop
+ */
+enum class Phase : size_t {
+    /** position update and sorting the particles into their cells */
+    POSITION = 0,
+    /** force calculation and velocity update */
+    FORCE = 1,
+    /** outflow, reflecting and periodic boundaries */
+    BOUNDARY = 2,
+    /** handing the particles to the output writer */
+    OUTPUT = 3,
+    /** writing checkpoints */
+    CHECKPOINT = 4,
+    /** selecting the configuration of the container */
+    TUNING = 5
+};
+
+/**
+ * @brief Measures the wall time of every phase of the simulation loop
+ *
+ * The time of every phase is recorded per iteration, the summary reports the total, mean and percentiles of every
+ * phase and the molecule updates per second (MUPS). Optionally the totals are written every N iterations to a CSV file
+ * or, if the file name ends with .json, to a file with one JSON object per line.
+ */
+class PhaseTimers {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** number of phases of one iteration */
+    static constexpr size_t numPhases = 6;
+
+    /** true if the simulation loop is timed, disabled with the CMake option PHASE_TIMERS */
+#ifdef PHASE_TIMERS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    /**
+     * @brief adds the time from its construction to its destruction to a phase of the current iteration
+     */
+    class Scope {
+    public:
+        Scope(PhaseTimers &timers, Phase phase) : timers(timers), phase(phase), start(Clock::now()) {}
+
+        ~Scope() { timers.add(phase, Clock::now() - start); }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        PhaseTimers &timers;
+        Phase phase;
+        Clock::time_point start;
+    };
+
+    PhaseTimers();
+
+    /**
+     * @brief writes the phase times to a file every frequency iterations
+     * @param filename CSV file, or JSON Lines file if the name ends with .json
+     * @param frequency number of iterations between two lines, 0 disables the file
+     * @throws std::runtime_error if the file can not be opened
+     */
+    void setDump(const std::string &filename, int frequency);
+
+    /**
+     * @brief adds a duration to a phase of the current iteration
+     */
+    void add(Phase phase, Clock::duration duration);
+
+    /**
+     * @brief stores the times of the current iteration and writes them to the dump if it is due
+     * @param iteration number of the finished iteration
+     * @param numParticles number of particles that were updated in the iteration
+     */
+    void endIteration(int iteration, size_t numParticles);
+
+    /**
+     * @return table with total, share of the run time, mean, median, 90th and 99th percentile and maximum of every
+     * phase followed by the molecule updates per second
+     */
+    std::string summary() const;
+
+    /**
+     * @return seconds spent in a phase over all finished iterations
+     */
+    double getTotal(Phase phase) const;
+
+    /**
+     * @return seconds of a phase in the iteration at which the given fraction of iterations was faster
+     * @param fraction between 0 and 1
+     */
+    double getPercentile(Phase phase, double fraction) const;
+
+    /**
+     * @return number of finished iterations
+     */
+    size_t getIterations() const { return iterations; }
+
+    /**
+     * @return million molecule updates per second over the wall time since the construction
+     */
+    double getMUPS() const;
+
+private:
+    /** seconds of every phase in the current iteration */
+    std::array<double, numPhases> current{};
+    /** seconds of every phase in every finished iteration */
+    std::array<std::vector<float>, numPhases> samples;
+    std::array<double, numPhases> totals{};
+    size_t iterations = 0;
+    /** sum of the particles of every finished iteration */
+    double particleUpdates = 0;
+    Clock::time_point start;
+
+    std::ofstream dumpFile;
+    bool dumpJson = false;
+    int dumpFrequency = 0;
+    /** phase times and particle updates since the last line of the dump */
+    std::array<double, numPhases> windowTotals{};
+    double windowUpdates = 0;
+    Clock::time_point windowStart;
+
+    void writeDump(int iteration, size_t numParticles);
+};
+
+#ifdef PHASE_TIMERS
+/** times the rest of the enclosing scope as the given phase */
+#define TIME_PHASE(timers, phase) PhaseTimers::Scope phaseScope(timers, phase)
+#else
+#define TIME_PHASE(timers, phase) ((void) 0)
+#endif
@@ -2,11 +2,22 @@
 // Created by Yasmine Farah on 07/11/2024.
 //
 #include "gtest/gtest.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include "../../src/Calculator/Calculator.h"
 #include "../../src/Calculator/GravityCalculator.h"
 #include "../../src/Calculator/LennardJonesCalculator.h"
+#include "../../src/Calculator/LennardJonesSIMDCalculator.h"
+#include "../../src/Calculator/TabulatedCalculator.h"
 #include "../../src/Objects/Containers/DirectSum/DirectSumContainer.h"
+#include "../../src/Objects/Containers/LinkedCell/LinkedCellContainer.h"
 #include "../../src/Objects/Particle.h"
+#include "TestUtils.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /*Checks that calculateX() correctly updates the position of a particle*/
 TEST(CalculatorTest, correctXcalculations) {
@@ -20,7 +31,7 @@ TEST(CalculatorTest, correctXcalculations) {
     Calculators::GravityCalculator calc;
     calc.calculateX(testContainer,0.5); //value different from 1 to check that (delta_t)^2 is calculated correctly
 
-    for (auto &t : testContainer) {
+    for (auto t : testContainer) {
         SPDLOG_DEBUG("Looking at particle");
         EXPECT_NEAR(0.075, t.getX()[0], 0.00001);
         EXPECT_NEAR(0.075, t.getX()[1], 0.00001);
@@ -50,7 +61,7 @@ TEST(CalculatorTest, correctFIJcalculations) {
     Calculators::GravityCalculator calc;
     calc.calculateF(testContainer); 
 
-    for (Particle& p: testContainer) {
+    for (auto p: testContainer) {
      EXPECT_EQ(old, testContainer.getParticle(p.getID()).getOldF());
     }  
 
@@ -71,7 +82,7 @@ TEST(CalculatorTest, correctVcalculations) {
     Calculators::GravityCalculator calc;
     calc.calculateV(testContainer,0.5); //value different from 1 to check that (delta_t)^2 is calculated correctly
 
-    for (auto &t : testContainer) {
+    for (auto t : testContainer) {
         EXPECT_NEAR(1.3125, t.getV()[0], 0.00001);
         EXPECT_NEAR(1.3125, t.getV()[1], 0.00001);
         EXPECT_NEAR(1.3125, t.getV()[2], 0.00001);
@@ -145,4 +156,284 @@ TEST(CalculatorTest, correctLJcalculations) {
     
 
 }
-    
\ No newline at end of file
+    
+
+/*Checks that forces calculated from the Verlet list match the forces calculated from the linked cells,
+ * also after the list had to be rebuilt*/
+TEST(CalculatorTest, verletListMatchesLinkedCells) {
+    ParticleContainers::LinkedCellContainer cellContainer({20.0, 20.0, 1.0}, 2.5);
+    ParticleContainers::LinkedCellContainer verletContainer({20.0, 20.0, 1.0}, 2.5, 0.3, 20);
+    EXPECT_TRUE(verletContainer.usesVerletList());
+    EXPECT_FALSE(cellContainer.usesVerletList());
+    for (const Particle &p: testUtils::createLattice()) {
+        cellContainer.addParticle(p);
+        verletContainer.addParticle(p);
+    }
+
+    Calculators::LennardJonesCalculator calc;
+    for (int step = 0; step < 200; step++) {
+        calc.calculateXFV(cellContainer, 0.002);
+        calc.calculateXFV(verletContainer, 0.002);
+    }
+    testUtils::expectSameParticles(cellContainer, verletContainer);
+}
+
+/*Checks that the fused sweeps of calculateXFV give the same trajectory as the separate position, force and velocity
+ * updates*/
+TEST(CalculatorTest, fusedIntegrationMatchesSeparateSweeps) {
+    ParticleContainers::LinkedCellContainer fused({20.0, 20.0, 1.0}, 2.5);
+    ParticleContainers::LinkedCellContainer separate({20.0, 20.0, 1.0}, 2.5);
+    for (const Particle &p: testUtils::createLattice(true)) {
+        fused.addParticle(p);
+        separate.addParticle(p);
+    }
+
+    Calculators::LennardJonesCalculator calc;
+    for (int step = 0; step < 100; step++) {
+        calc.calculateXFV(fused, 0.002);
+        calc.calculateX(separate, 0.002);
+        separate.updateParticlesInCell();
+        calc.calculateF(separate);
+        calc.calculateV(separate, 0.002);
+    }
+
+    ParticleStorage &expected = separate.getStorage();
+    ParticleStorage &actual = fused.getStorage();
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected.id[i], actual.id[i]);
+        EXPECT_DOUBLE_EQ(expected.x[i], actual.x[i]);
+        EXPECT_DOUBLE_EQ(expected.y[i], actual.y[i]);
+        EXPECT_DOUBLE_EQ(expected.vx[i], actual.vx[i]);
+        EXPECT_DOUBLE_EQ(expected.vy[i], actual.vy[i]);
+        EXPECT_DOUBLE_EQ(expected.fx[i], actual.fx[i]);
+        EXPECT_DOUBLE_EQ(expected.oldFy[i], actual.oldFy[i]);
+    }
+}
+
+/*Checks that the vectorized Lennard-Jones cell kernels match the scalar LennardJonesCalculator
+ * for every instruction set the CPU supports, in two and three dimensions and for one and several particle types*/
+TEST(CalculatorTest, simdLennardJonesMatchesScalar) {
+    using InstructionSet = Calculators::LennardJonesSIMDCalculator::InstructionSet;
+    std::vector<InstructionSet> instructionSets = {InstructionSet::SCALAR};
+    if (Calculators::LennardJonesSIMDCalculator::detectInstructionSet() >= InstructionSet::AVX2) {
+        instructionSets.push_back(InstructionSet::AVX2);
+    }
+    if (Calculators::LennardJonesSIMDCalculator::detectInstructionSet() >= InstructionSet::AVX512) {
+        instructionSets.push_back(InstructionSet::AVX512);
+    }
+
+    for (std::array<double, 3> domainSize: {std::array<double, 3>{15.0, 15.0, 1.0}, std::array<double, 3>{9.0, 9.0, 9.0}})
+    for (bool mixture: {false, true}) {
+        // irregular positions, so that cells hold different numbers of particles and the remainder loops are used
+        std::vector<Particle> particles;
+        const bool threeDimensional = domainSize[2] > 1.0;
+        const int perDimension = threeDimensional ? 8 : 13;
+        for (int x = 0; x < perDimension; x++) {
+            for (int y = 0; y < perDimension; y++) {
+                for (int z = 0; z < (threeDimensional ? perDimension : 1); z++) {
+                    particles.emplace_back(std::array<double, 3>{0.4 + 1.1 * x + 0.13 * ((y * 7 + z) % 5) - 0.03 * (x % 3),
+                                                                 0.4 + 1.1 * y + 0.11 * ((x * 3 + z) % 4),
+                                                                 threeDimensional ? 0.4 + 1.1 * z + 0.09 * ((x + y) % 6) : 0.5},
+                                           std::array<double, 3>{0.0, 0.0, 0.0}, 1.0, mixture ? (x + 2 * y + z) % 3 : 0);
+                }
+            }
+        }
+
+        ParticleContainers::LinkedCellContainer reference(domainSize, 2.5);
+        for (const Particle &p: particles) {
+            reference.addParticle(p);
+        }
+        Calculators::LennardJonesCalculator scalarCalc;
+        scalarCalc.setTypeParameters(1, 2.0, 1.1);
+        scalarCalc.setTypeParameters(2, 0.5, 0.9);
+        scalarCalc.calculateF(reference);
+
+        for (InstructionSet instructionSet: instructionSets) {
+            ParticleContainers::LinkedCellContainer container(domainSize, 2.5);
+            for (const Particle &p: particles) {
+                container.addParticle(p);
+            }
+            Calculators::LennardJonesSIMDCalculator simdCalc(instructionSet);
+            simdCalc.setTypeParameters(1, 2.0, 1.1);
+            simdCalc.setTypeParameters(2, 0.5, 0.9);
+            ASSERT_EQ(simdCalc.getInstructionSet(), instructionSet);
+            simdCalc.calculateF(container);
+
+            ParticleStorage &expected = reference.getStorage();
+            ParticleStorage &actual = container.getStorage();
+            ASSERT_EQ(expected.size(), particles.size());
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); i++) {
+                ASSERT_EQ(expected.id[i], actual.id[i]);
+                const double norm = std::sqrt(expected.fx[i] * expected.fx[i] + expected.fy[i] * expected.fy[i] +
+                                              expected.fz[i] * expected.fz[i]);
+                EXPECT_NEAR(expected.fx[i], actual.fx[i], 1e-12 * norm);
+                EXPECT_NEAR(expected.fy[i], actual.fy[i], 1e-12 * norm);
+                EXPECT_NEAR(expected.fz[i], actual.fz[i], 1e-12 * norm);
+            }
+        }
+    }
+}
+
+/*Checks the Lorentz-Berthelot mixing of the per-type parameters and the force between particles of different types*/
+TEST(CalculatorTest, lennardJonesMixture) {
+    Calculators::LennardJonesMixingTable table;
+    table.setTypeParameters(2, 2.0, 1.4);
+    EXPECT_EQ(table.getNumTypes(), 3);
+    // type 1 was never configured and uses the defaults epsilon = 5, sigma = 1
+    EXPECT_EQ(table.getEpsilon(1), 5.0);
+    EXPECT_EQ(table.getSigma(7), 1.0);
+    EXPECT_NEAR(table.get(0, 2).epsilon24, 24 * std::sqrt(10.0), 1e-12);
+    EXPECT_NEAR(table.get(2, 0).sigma6, std::pow(1.2, 6), 1e-12);
+    EXPECT_NEAR(table.get(2, 2).sigma6, std::pow(1.4, 6), 1e-12);
+
+    ParticleContainers::DirectSumContainer testContainer;
+    testContainer.addParticle(Particle({0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    testContainer.addParticle(Particle({1.5, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 2));
+    Calculators::LennardJonesCalculator calc;
+    calc.setTypeParameters(2, 2.0, 1.4);
+    calc.calculateF(testContainer);
+
+    // F = 24 * epsilon / r * (2 * (sigma / r)^12 - (sigma / r)^6) pointing away from the other particle
+    const double epsilon = std::sqrt(5.0 * 2.0);
+    const double sr6 = std::pow(1.2 / 1.5, 6);
+    const double expected = 24 * epsilon / 1.5 * (2 * sr6 * sr6 - sr6);
+    EXPECT_NEAR(testContainer.getStorage().fx[0], -expected, 1e-12);
+    EXPECT_NEAR(testContainer.getStorage().fx[1], expected, 1e-12);
+}
+
+#ifdef _OPENMP
+/*Checks that the linked cell traversal calculates bitwise the same forces and trajectory for any number of threads*/
+TEST(CalculatorTest, parallelLinkedCellsReproducible) {
+    std::vector<Particle> particles;
+    for (int x = 0; x < 20; x++) {
+        for (int y = 0; y < 20; y++) {
+            particles.emplace_back(std::array<double, 3>{1.0 + 0.9 * x + 0.01 * (y % 3), 1.0 + 0.9 * y + 0.02 * (x % 4), 0.5},
+                                   std::array<double, 3>{0.0, 0.0, 0.0}, 1.0, 0);
+        }
+    }
+    std::vector<ParticleContainers::LinkedCellContainer> containers;
+    containers.reserve(3);
+    for (int threads: {1, 2, 4}) {
+        containers.emplace_back(std::array<double, 3>{20.0, 20.0, 1.0}, 2.5);
+        for (const Particle &p: particles) {
+            containers.back().addParticle(p);
+        }
+        omp_set_num_threads(threads);
+        Calculators::LennardJonesCalculator calc;
+        calc.calculateF(containers.back());
+        for (int step = 0; step < 5; step++) {
+            calc.calculateXFV(containers.back(), 0.0005);
+        }
+    }
+    omp_set_num_threads(omp_get_num_procs());
+
+    ParticleStorage &serial = containers[0].getStorage();
+    ParticleStorage &twoThreads = containers[1].getStorage();
+    ParticleStorage &fourThreads = containers[2].getStorage();
+    ASSERT_EQ(serial.size(), particles.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        ASSERT_EQ(serial.id[i], fourThreads.id[i]);
+        ASSERT_EQ(twoThreads.id[i], fourThreads.id[i]);
+        for (ParticleStorage *other: {&twoThreads, &fourThreads}) {
+            EXPECT_EQ(serial.fx[i], other->fx[i]);
+            EXPECT_EQ(serial.fy[i], other->fy[i]);
+            EXPECT_EQ(serial.x[i], other->x[i]);
+            EXPECT_EQ(serial.y[i], other->y[i]);
+            EXPECT_EQ(serial.vx[i], other->vx[i]);
+            EXPECT_EQ(serial.vy[i], other->vy[i]);
+        }
+    }
+}
+#endif
+
+/*Checks the tabulated Lennard-Jones, Morse and Mie potentials against their analytic forces and energies*/
+TEST(CalculatorTest, tabulatedPotentialsMatchAnalytic) {
+    const auto lj = Calculators::TabulatedPotential::fromSpecification("LJ", 2.5);
+    const auto morse = Calculators::TabulatedPotential::fromSpecification("Morse:2,1.5,1.2", 2.5);
+    const auto mie = Calculators::TabulatedPotential::fromSpecification("Mie:1,1,14,7", 2.5);
+    const Calculators::LennardJonesMixingTable::PairParameters parameters{24 * 5.0, 1.0};
+    const double ljShift = 20 * (std::pow(2.5, -12) - std::pow(2.5, -6));
+    const double morseShift = 2 * (std::exp(-3 * 1.3) - 2 * std::exp(-1.5 * 1.3));
+    for (double r = 0.85; r < 2.5; r += 0.0123) {
+        const double ljForce = Calculators::LennardJonesCalculator::lennardJonesFactor(r * r, parameters);
+        EXPECT_NEAR(lj.forceFactor(r * r), ljForce, 1e-7 * std::max(1.0, std::abs(ljForce)));
+        const double ljEnergy = 20 * (std::pow(r, -12) - std::pow(r, -6)) - ljShift;
+        EXPECT_NEAR(lj.energy(r * r), ljEnergy, 1e-7 * std::max(1.0, std::abs(ljEnergy)));
+
+        const double e = std::exp(-1.5 * (r - 1.2));
+        EXPECT_NEAR(morse.forceFactor(r * r), -6 * (e * e - e) / r, 1e-8);
+        EXPECT_NEAR(morse.energy(r * r), 2 * (e * e - 2 * e) - morseShift, 1e-8);
+
+        // the Mie potential with n = 14 and m = 7 has the prefactor 4
+        const double mieForce = 4 / (r * r) * (7 * std::pow(r, -7) - 14 * std::pow(r, -14));
+        EXPECT_NEAR(mie.forceFactor(r * r), mieForce, 1e-7 * std::max(1.0, std::abs(mieForce)));
+    }
+    // truncated and shifted: the energy goes to zero at the cutoff radius and both vanish beyond it
+    EXPECT_NEAR(lj.energy(std::nextafter(2.5 * 2.5, 0.0)), 0.0, 1e-12);
+    EXPECT_EQ(lj.forceFactor(2.5 * 2.5), 0.0);
+    EXPECT_EQ(morse.energy(3.0 * 3.0), 0.0);
+
+    EXPECT_THROW(Calculators::TabulatedPotential::fromSpecification("Morse:2,1.5", 2.5), std::invalid_argument);
+    EXPECT_THROW(Calculators::TabulatedPotential::fromSpecification("Mie:1,1,6,12", 2.5), std::invalid_argument);
+    EXPECT_THROW(Calculators::TabulatedPotential::fromSpecification("LJ:5,x", 2.5), std::invalid_argument);
+    EXPECT_THROW(Calculators::TabulatedPotential::fromSpecification("Buckingham", 2.5), std::invalid_argument);
+}
+
+/*Checks that a potential read from a file reproduces the potential it was sampled from*/
+TEST(CalculatorTest, tabulatedPotentialFromFile) {
+    {
+        std::ofstream file("TabulatedPotentialTest.txt");
+        file << std::setprecision(17);
+        file << "# r U(r) -dU/dr of the Morse potential with D = 2, a = 1.5 and r0 = 1.2\n";
+        for (int k = 60; k <= 300; ++k) {
+            const double r = 0.01 * k;
+            const double e = std::exp(-1.5 * (r - 1.2));
+            file << r << " " << 2 * (e * e - 2 * e) << " " << 6 * (e * e - e) << "\n";
+        }
+    }
+    const auto fromFile = Calculators::TabulatedPotential::fromSpecification("file:TabulatedPotentialTest.txt", 2.5);
+    const auto analytic = Calculators::TabulatedPotential::morse(2, 1.5, 1.2, 2.5);
+    EXPECT_NEAR(fromFile.getMinDistance(), 0.6, 1e-12);
+    for (double r = 0.7; r < 2.5; r += 0.0123) {
+        EXPECT_NEAR(fromFile.forceFactor(r * r), analytic.forceFactor(r * r), 1e-4);
+        EXPECT_NEAR(fromFile.energy(r * r), analytic.energy(r * r), 1e-6);
+    }
+    // the file has to reach the cutoff radius
+    EXPECT_THROW(Calculators::TabulatedPotential::fromFile("TabulatedPotentialTest.txt", 3.5), std::invalid_argument);
+    std::remove("TabulatedPotentialTest.txt");
+    EXPECT_THROW(Calculators::TabulatedPotential::fromFile("TabulatedPotentialTest.txt", 2.5), std::invalid_argument);
+}
+
+/*Checks that the tabulated calculator moves the particles like the Lennard-Jones calculator*/
+TEST(CalculatorTest, tabulatedCalculatorMatchesLennardJones) {
+    ParticleContainers::LinkedCellContainer tabulated({20.0, 20.0, 1.0}, 2.5);
+    ParticleContainers::LinkedCellContainer reference({20.0, 20.0, 1.0}, 2.5);
+    for (int x = 0; x < 8; x++) {
+        for (int y = 0; y < 8; y++) {
+            Particle p({5.0 + 1.1225 * x + 0.03 * (y % 3), 5.0 + 1.1225 * y, 0.5}, {0.0, 0.0, 0.0}, 1.0, 0);
+            tabulated.addParticle(p);
+            reference.addParticle(p);
+        }
+    }
+    Calculators::TabulatedCalculator tab(Calculators::TabulatedPotential::lennardJones(5, 1, 2.5));
+    Calculators::LennardJonesCalculator lj;
+    EXPECT_EQ(tab.toString(), "TAB");
+    for (int step = 0; step < 20; step++) {
+        tab.calculateXFV(tabulated, 0.0005);
+        lj.calculateXFV(reference, 0.0005);
+    }
+    for (auto p : reference) {
+        Particle q = tabulated.getParticle(p.getID());
+        for (int in = 0; in < 3; in++) {
+            EXPECT_NEAR(p.getX()[in], q.getX()[in], 1e-9);
+            EXPECT_NEAR(p.getF()[in], q.getF()[in], 1e-5);
+        }
+    }
+    const std::array<double, 3> sub{1.1, 0.2, 0.0};
+    const auto force = tab.calculateFIJ(sub, 1, 1, ArrayUtils::L2Norm(sub));
+    const auto expected = lj.calculateFIJ(sub, 1, 1, ArrayUtils::L2Norm(sub));
+    EXPECT_NEAR(force[0], expected[0], 1e-7);
+    EXPECT_NEAR(force[1], expected[1], 1e-7);
+}
@@ -0,0 +1,95 @@
+//
+// AsyncOutputWriterTest.cpp
+//
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "IO/Output/outputWriter/AsyncOutputWriter.h"
+#include "IO/Output/outputWriter/VTKBinaryWriter.h"
+
+namespace {
+    /**
+     * @brief slow writer that remembers what it was asked to write
+     */
+    class RecordingWriter : public outputWriters::OutputWriter {
+    public:
+        std::vector<int> iterations;
+        std::vector<double> firstX;
+        int failAt = -1;
+
+        void plotParticles(int iteration, ParticleContainers::ParticleContainer &particleContainer, const std::string &) override {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            if (iteration == failAt) {
+                throw std::runtime_error("disk full");
+            }
+            iterations.push_back(iteration);
+            firstX.push_back(particleContainer.getStorage().x[0]);
+        }
+
+        std::string toString() override {
+            return "RecordingWriter";
+        }
+    };
+
+    std::string readFile(const std::string &name) {
+        std::ifstream file(name, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+/* Checks that the snapshots are written in order and with the particles at the time of the call */
+TEST(AsyncOutputWriterTest, writesSnapshotsInOrder) {
+    auto recording = std::make_unique<RecordingWriter>();
+    RecordingWriter &writer = *recording;
+    outputWriters::AsyncOutputWriter asyncWriter(std::move(recording), 2);
+    EXPECT_EQ(asyncWriter.toString(), "RecordingWriter");
+
+    ParticleContainers::DirectSumContainer container;
+    container.addParticle(Particle({0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    for (int iteration = 1; iteration <= 20; iteration++) {
+        container.getStorage().x[0] = iteration;
+        asyncWriter.plotParticles(iteration, container, "unused");
+    }
+    asyncWriter.flush();
+    ASSERT_EQ(writer.iterations.size(), 20);
+    for (int k = 0; k < 20; k++) {
+        EXPECT_EQ(writer.iterations[k], k + 1);
+        EXPECT_EQ(writer.firstX[k], k + 1);
+    }
+}
+
+/* Checks that an exception of the writer thread reaches the caller */
+TEST(AsyncOutputWriterTest, rethrowsWriterErrors) {
+    auto recording = std::make_unique<RecordingWriter>();
+    recording->failAt = 2;
+    outputWriters::AsyncOutputWriter asyncWriter(std::move(recording), 1);
+    ParticleContainers::DirectSumContainer container;
+    container.addParticle(Particle({0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    asyncWriter.plotParticles(1, container, "unused");
+    asyncWriter.plotParticles(2, container, "unused");
+    EXPECT_THROW(asyncWriter.flush(), std::runtime_error);
+    EXPECT_THROW(outputWriters::AsyncOutputWriter(std::make_unique<RecordingWriter>(), 0), std::invalid_argument);
+}
+
+/* Checks that the asynchronous output is byte for byte the synchronous output */
+TEST(AsyncOutputWriterTest, sameFilesAsSynchronousWriter) {
+    ParticleContainers::DirectSumContainer container;
+    for (int k = 0; k < 50; k++) {
+        container.addParticle(Particle({k * 0.5, k * 0.25, 0.0}, {1.0, -1.0, 0.0}, 1.0, k % 2));
+    }
+    outputWriters::VTKBinaryWriter syncWriter;
+    syncWriter.plotParticles(3, container, "AsyncOutputWriterTestSync");
+    {
+        outputWriters::AsyncOutputWriter asyncWriter(std::make_unique<outputWriters::VTKBinaryWriter>());
+        asyncWriter.plotParticles(3, container, "AsyncOutputWriterTestAsync");
+        // the destructor writes the remaining snapshots
+        container.getStorage().x[0] = 100.0;
+    }
+    EXPECT_EQ(readFile("AsyncOutputWriterTestSync_0003.vtu"), readFile("AsyncOutputWriterTestAsync_0003.vtu"));
+    std::remove("AsyncOutputWriterTestSync_0003.vtu");
+    std::remove("AsyncOutputWriterTestAsync_0003.vtu");
+}
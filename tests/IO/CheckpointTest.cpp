@@ -0,0 +1,153 @@
+//
+// CheckpointTest.cpp
+//
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include "IO/Checkpoint/Checkpoint.h"
+#include "Calculator/LennardJonesCalculator.h"
+#include "Calculator/GravityCalculator.h"
+
+namespace {
+    /**
+     * @brief a mixture of two types in a box with reflecting walls at the bottom and the left
+     */
+    std::unique_ptr<ParticleContainers::ParticleContainer> createMixture(std::unique_ptr<BoundaryHandler> &boundaryHandler) {
+        // both simulations get the same ids
+        ParticleIdInitializer::reset();
+        auto container = std::make_unique<ParticleContainers::LinkedCellContainer>(std::array<double, 3>{20, 20, 1}, 3.0);
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                container->addParticle(Particle({1.0 + i * 1.2, 1.0 + j * 1.2, 0.5}, {-1.0 + 0.1 * j, -2.0 + 0.3 * i, 0.0},
+                                                1.0 + (i + j) % 2, (i + j) % 2));
+            }
+        }
+        boundaryHandler = std::make_unique<BoundaryHandler>(1, std::array<bool, 6>{1, 0, 0, 1, 0, 0}, *container);
+        return container;
+    }
+
+    void simulate(ParticleContainers::ParticleContainer &container, BoundaryHandler &boundaryHandler,
+                  Calculators::Calculator &calculator, int steps) {
+        for (int step = 0; step < steps; step++) {
+            calculator.calculateXFV(container, 0.0005);
+            boundaryHandler.handleBoundaries();
+        }
+    }
+}
+
+/* Checks that a simulation continued from a checkpoint is bit-identical to an uninterrupted simulation */
+TEST(CheckpointTest, restartIsBitIdentical) {
+    std::unique_ptr<BoundaryHandler> referenceHandler;
+    auto reference = createMixture(referenceHandler);
+    Calculators::LennardJonesCalculator referenceCalculator;
+    referenceCalculator.setTypeParameters(1, 2.0, 1.2);
+    referenceHandler->setMixingTable(referenceCalculator.getMixingTable());
+    simulate(*reference, *referenceHandler, referenceCalculator, 200);
+
+    std::unique_ptr<BoundaryHandler> handler;
+    auto interrupted = createMixture(handler);
+    Calculators::LennardJonesCalculator calculator;
+    calculator.setTypeParameters(1, 2.0, 1.2);
+    handler->setMixingTable(calculator.getMixingTable());
+    simulate(*interrupted, *handler, calculator, 100);
+    Checkpoint::write("CheckpointTest.checkpoint", *interrupted, handler.get(), calculator, {0.05, 100, 0.0005});
+
+    std::unique_ptr<ParticleContainers::ParticleContainer> restarted = std::make_unique<ParticleContainers::DirectSumContainer>();
+    std::unique_ptr<BoundaryHandler> restartedHandler;
+    Calculators::LennardJonesCalculator restartedCalculator;
+    SimulationState state = Checkpoint::read("CheckpointTest.checkpoint", restarted, restartedHandler, restartedCalculator);
+    std::remove("CheckpointTest.checkpoint");
+    EXPECT_EQ(state.iteration, 100);
+    EXPECT_EQ(state.time, 0.05);
+    EXPECT_EQ(state.deltaT, 0.0005);
+    ASSERT_NE(dynamic_cast<ParticleContainers::LinkedCellContainer *>(restarted.get()), nullptr);
+    ASSERT_NE(restartedHandler, nullptr);
+    EXPECT_EQ(restartedHandler->getBoundaryConditions(), handler->getBoundaryConditions());
+    EXPECT_EQ(restartedCalculator.getMixingTable().getEpsilon(1), 2.0);
+    EXPECT_EQ(restartedCalculator.getMixingTable().getSigma(1), 1.2);
+
+    simulate(*restarted, *restartedHandler, restartedCalculator, 100);
+    ParticleStorage &expected = reference->getStorage();
+    ParticleStorage &actual = restarted->getStorage();
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_EQ(actual.x, expected.x);
+    EXPECT_EQ(actual.y, expected.y);
+    EXPECT_EQ(actual.vx, expected.vx);
+    EXPECT_EQ(actual.vy, expected.vy);
+    EXPECT_EQ(actual.fx, expected.fx);
+    EXPECT_EQ(actual.oldFy, expected.oldFy);
+    EXPECT_EQ(actual.type, expected.type);
+    EXPECT_EQ(actual.id, expected.id);
+}
+
+/* Checks that the Barnes-Hut container is restored with its opening angle and without a boundary handler */
+TEST(CheckpointTest, barnesHutContainer) {
+    ParticleContainers::BarnesHutContainer container(0.7);
+    container.addParticle(Particle({1.0, 2.0, 3.0}, {0.5, 0.0, 0.0}, 3.0, 0));
+    container.addParticle(Particle({-1.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    Calculators::GravityCalculator calculator;
+    Checkpoint::write("CheckpointTestBH.checkpoint", container, nullptr, calculator, {1.5, 7, 0.01});
+
+    std::unique_ptr<ParticleContainers::ParticleContainer> restored;
+    std::unique_ptr<BoundaryHandler> boundaryHandler;
+    Checkpoint::read("CheckpointTestBH.checkpoint", restored, boundaryHandler, calculator);
+    std::remove("CheckpointTestBH.checkpoint");
+    auto *bhCont = dynamic_cast<ParticleContainers::BarnesHutContainer *>(restored.get());
+    ASSERT_NE(bhCont, nullptr);
+    EXPECT_EQ(bhCont->getTheta(), 0.7);
+    EXPECT_EQ(boundaryHandler, nullptr);
+    EXPECT_EQ(restored->getStorage().m, container.getStorage().m);
+    EXPECT_EQ(restored->getStorage().z, container.getStorage().z);
+}
+
+/* Checks that invalid and truncated files are rejected */
+TEST(CheckpointTest, invalidFiles) {
+    std::unique_ptr<ParticleContainers::ParticleContainer> restored;
+    std::unique_ptr<BoundaryHandler> boundaryHandler;
+    Calculators::GravityCalculator calculator;
+    EXPECT_THROW(Checkpoint::read("CheckpointTestMissing.checkpoint", restored, boundaryHandler, calculator), std::runtime_error);
+
+    std::ofstream("CheckpointTestInvalid.checkpoint") << "this is not a checkpoint, but long enough to contain a header of a checkpoint"
+                                                         " and some more bytes that could be particles";
+    EXPECT_THROW(Checkpoint::read("CheckpointTestInvalid.checkpoint", restored, boundaryHandler, calculator), std::runtime_error);
+
+    ParticleContainers::DirectSumContainer container;
+    container.addParticle(Particle({1.0, 2.0, 3.0}, {0.5, 0.0, 0.0}, 3.0, 0));
+    Checkpoint::write("CheckpointTestInvalid.checkpoint", container, nullptr, calculator, {});
+    std::ifstream file("CheckpointTestInvalid.checkpoint", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::ofstream("CheckpointTestInvalid.checkpoint", std::ios::binary) << content.substr(0, content.size() - 4);
+    EXPECT_THROW(Checkpoint::read("CheckpointTestInvalid.checkpoint", restored, boundaryHandler, calculator), std::runtime_error);
+
+    // an iteration beyond the range of int, patched into the 64 bit field of the header
+    Checkpoint::write("CheckpointTestInvalid.checkpoint", container, nullptr, calculator, {0.0, 123456789, 0.01});
+    file.open("CheckpointTestInvalid.checkpoint", std::ios::binary);
+    content.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    const int64_t written = 123456789;
+    const int64_t tooLarge = int64_t{std::numeric_limits<int>::max()} + 1;
+    const size_t offset = content.find(std::string(reinterpret_cast<const char *>(&written), sizeof(written)));
+    ASSERT_NE(offset, std::string::npos);
+    content.replace(offset, sizeof(tooLarge), reinterpret_cast<const char *>(&tooLarge), sizeof(tooLarge));
+    std::ofstream("CheckpointTestInvalid.checkpoint", std::ios::binary) << content;
+    EXPECT_THROW(Checkpoint::read("CheckpointTestInvalid.checkpoint", restored, boundaryHandler, calculator), std::runtime_error);
+
+    // a particle count far beyond the file size, the count is the last header field before the single particle
+    Checkpoint::write("CheckpointTestInvalid.checkpoint", container, nullptr, calculator, {});
+    file.open("CheckpointTestInvalid.checkpoint", std::ios::binary);
+    content.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    const size_t particleBytes = 13 * sizeof(double) + sizeof(int32_t) + sizeof(int64_t);
+    const size_t countOffset = content.size() - particleBytes - sizeof(uint64_t);
+    uint64_t numParticles = 0;
+    std::memcpy(&numParticles, content.data() + countOffset, sizeof(numParticles));
+    ASSERT_EQ(numParticles, 1u);
+    numParticles = std::numeric_limits<uint64_t>::max() / 2;
+    content.replace(countOffset, sizeof(numParticles), reinterpret_cast<const char *>(&numParticles), sizeof(numParticles));
+    std::ofstream("CheckpointTestInvalid.checkpoint", std::ios::binary) << content;
+    EXPECT_THROW(Checkpoint::read("CheckpointTestInvalid.checkpoint", restored, boundaryHandler, calculator), std::runtime_error);
+    std::remove("CheckpointTestInvalid.checkpoint");
+}
@@ -0,0 +1,111 @@
+//
+// FileReaderTest.cpp
+//
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include "IO/Input/FileReader.h"
+#include "Objects/Containers/DirectSum/DirectSumContainer.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+
+namespace {
+    /**
+     * @brief particles with positions, velocities and masses that need the full precision to be read back
+     */
+    ParticleStorage createParticles(size_t numParticles) {
+        ParticleStorage particles;
+        for (size_t i = 0; i < numParticles; i++) {
+            const double k = static_cast<double>(i);
+            particles.push_back(Particle({k / 3.0, 1e-5 * k, -k * 0.7}, {1.0 / (k + 1), -2.5, 1e10 / (k + 7)},
+                                         1.0 + k / 11.0, static_cast<int>(i % 3)));
+        }
+        return particles;
+    }
+
+    void writeText(const ParticleStorage &particles, const std::string &filename, const std::string &lineEnd) {
+        std::ofstream file(filename);
+        file << "# generated by the FileReaderTest\n# xyz-coord velocity mass\n0\n" << particles.size() << "\n";
+        file << std::setprecision(17);
+        for (size_t i = 0; i < particles.size(); i++) {
+            file << particles.x[i] << " " << particles.y[i] << "\t" << particles.z[i] << "   "
+                 << particles.vx[i] << " " << particles.vy[i] << " " << particles.vz[i] << "  " << particles.m[i];
+            // the last line has no line break
+            if (i + 1 < particles.size()) {
+                file << lineEnd;
+            }
+        }
+    }
+
+    void expectEqualState(const ParticleStorage &expected, const ParticleStorage &actual, bool compareTypes) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_EQ(expected.x[i], actual.x[i]);
+            EXPECT_EQ(expected.y[i], actual.y[i]);
+            EXPECT_EQ(expected.z[i], actual.z[i]);
+            EXPECT_EQ(expected.vx[i], actual.vx[i]);
+            EXPECT_EQ(expected.vy[i], actual.vy[i]);
+            EXPECT_EQ(expected.vz[i], actual.vz[i]);
+            EXPECT_EQ(expected.m[i], actual.m[i]);
+            EXPECT_EQ(compareTypes ? expected.type[i] : 0, actual.type[i]);
+        }
+    }
+}
+
+/* Checks that the mapped reader parses every value of a large particle file exactly and in order */
+TEST(FileReaderTest, readParticlesMapped) {
+    const ParticleStorage particles = createParticles(20000);
+    for (const std::string lineEnd: {"\n", "\r\n"}) {
+        writeText(particles, "FileReaderTest.txt", lineEnd);
+        const ParticleStorage read = FileReader::readParticlesMapped("FileReaderTest.txt");
+        expectEqualState(particles, read, false);
+        for (size_t i = 1; i < read.size(); i++) {
+            EXPECT_NE(read.id[i], read.id[i - 1]);
+        }
+    }
+    std::remove("FileReaderTest.txt");
+}
+
+/* Checks that a malformed particle line is reported */
+TEST(FileReaderTest, malformedParticle) {
+    std::ofstream("FileReaderTestMalformed.txt") << "0\n3\n0 0 0 0 0 0 1\n0 0 0 zero 0 0 1\n0 0 0 0 0 0 1\n";
+    EXPECT_THROW(FileReader::readParticlesMapped("FileReaderTestMalformed.txt"), std::invalid_argument);
+    std::ofstream("FileReaderTestMalformed.txt") << "0\n3\n0 0 0 0 0 0 1\n";
+    EXPECT_THROW(FileReader::readParticlesMapped("FileReaderTestMalformed.txt"), std::invalid_argument);
+    std::remove("FileReaderTestMalformed.txt");
+}
+
+/* Checks that particles written to the binary format are read back with all their values */
+TEST(FileReaderTest, binaryRoundTrip) {
+    const ParticleStorage particles = createParticles(1000);
+    FileReader::writeBinaryParticles(particles, "FileReaderTest.bin");
+
+    ParticleContainers::DirectSumContainer container;
+    FileReader::readFile(container, "FileReaderTest.bin");
+    expectEqualState(particles, container.getStorage(), true);
+
+    std::ofstream("FileReaderTestInvalid.bin") << "0\n1\n0 0 0 0 0 0 1\n";
+    EXPECT_THROW(FileReader::readBinaryParticles("FileReaderTestInvalid.bin"), std::invalid_argument);
+    std::remove("FileReaderTest.bin");
+    std::remove("FileReaderTestInvalid.bin");
+}
+
+/* Checks that particles added in bulk are sorted into the cells of the LinkedCellContainer */
+TEST(FileReaderTest, addParticlesToLinkedCells) {
+    ParticleStorage particles;
+    particles.push_back(Particle({3.5, 3.5, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    particles.push_back(Particle({0.5, 0.5, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    particles.push_back(Particle({1.5, 2.5, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+
+    ParticleContainers::LinkedCellContainer container(std::array<double, 3>{4, 4, 1}, 1.0);
+    container.addParticle(Particle({2.5, 0.5, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+    container.addParticles(particles);
+    ASSERT_EQ(container.sizeParticles(), 4);
+    container.updateParticlesInCell();
+    for (auto cell = container.beginCells(); cell != container.endCells(); ++cell) {
+        for (size_t p: cell->getParticlesInCell()) {
+            EXPECT_EQ(container.mapPositionToCell(container.getStorage()[p].getX()), &*cell);
+        }
+    }
+    EXPECT_EQ(container.getStorage().x[0], 0.5);
+}
@@ -0,0 +1,126 @@
+//
+// VTKBinaryWriterTest.cpp
+//
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "IO/Output/outputWriter/VTKBinaryWriter.h"
+#include "Objects/Containers/DirectSum/DirectSumContainer.h"
+
+namespace {
+    std::string readFile(const std::string &name) {
+        std::ifstream file(name, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    std::string decodeBase64(const std::string &encoded) {
+        const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string decoded;
+        uint32_t bits = 0;
+        int numBits = 0;
+        for (char c: encoded) {
+            if (c == '=') {
+                break;
+            }
+            bits = (bits << 6) | alphabet.find(c);
+            numBits += 6;
+            if (numBits >= 8) {
+                numBits -= 8;
+                decoded.push_back(static_cast<char>((bits >> numBits) & 0xFF));
+            }
+        }
+        return decoded;
+    }
+
+    /**
+     * @return the offset attribute of the data array with the given name
+     */
+    size_t offsetOf(const std::string &file, const std::string &name) {
+        const size_t array = file.find("Name=\"" + name + "\"");
+        EXPECT_NE(array, std::string::npos);
+        const size_t offset = file.find("offset=\"", array) + std::strlen("offset=\"");
+        return std::stoul(file.substr(offset, file.find('"', offset) - offset));
+    }
+
+    /**
+     * @return the appended data section, starting behind the underscore
+     */
+    std::string appendedData(const std::string &file) {
+        const size_t begin = file.find('_', file.find("<AppendedData")) + 1;
+        const size_t end = file.rfind("\n  </AppendedData>");
+        return file.substr(begin, end - begin);
+    }
+}
+
+/* Checks the raw appended arrays against the particles and that base64 encodes exactly the same bytes */
+TEST(VTKBinaryWriterTest, appendedArrays) {
+    ParticleContainers::DirectSumContainer container;
+    container.addParticle(Particle({1.0, 2.0, 3.0}, {0.5, 0.0, -0.5}, 2.0, 4));
+    container.addParticle(Particle({-1.0, 0.25, 0.0}, {0.0, 1.0, 0.0}, 1.0, 1));
+    container.getStorage().oldFx[1] = 7.0;
+
+    outputWriters::VTKBinaryWriter rawWriter(outputWriters::VTKBinaryWriter::Encoding::RAW,
+                                             outputWriters::VTKBinaryWriter::Precision::FLOAT64);
+    rawWriter.plotParticles(1, container, "VTKBinaryWriterTestRaw");
+    const std::string raw = readFile("VTKBinaryWriterTestRaw_0001.vtu");
+    EXPECT_NE(raw.find("NumberOfPoints=\"2\""), std::string::npos);
+    EXPECT_NE(raw.find("encoding=\"raw\""), std::string::npos);
+
+    const std::string rawData = appendedData(raw);
+    auto readArray = [&rawData](size_t offset, auto *values, size_t numValues) {
+        uint64_t numBytes;
+        std::memcpy(&numBytes, rawData.data() + offset, sizeof(numBytes));
+        EXPECT_EQ(numBytes, numValues * sizeof(*values));
+        std::memcpy(values, rawData.data() + offset + sizeof(numBytes), numBytes);
+    };
+    double points[6];
+    readArray(offsetOf(raw, "points"), points, 6);
+    EXPECT_EQ(points[0], 1.0);
+    EXPECT_EQ(points[2], 3.0);
+    EXPECT_EQ(points[4], 0.25);
+    double force[6];
+    readArray(offsetOf(raw, "force"), force, 6);
+    EXPECT_EQ(force[3], 7.0);
+    double mass[2];
+    readArray(offsetOf(raw, "mass"), mass, 2);
+    EXPECT_EQ(mass[0], 2.0);
+    int32_t type[2];
+    readArray(offsetOf(raw, "type"), type, 2);
+    EXPECT_EQ(type[0], 4);
+    EXPECT_EQ(type[1], 1);
+    int32_t none[1];
+    readArray(offsetOf(raw, "connectivity"), none, 0);
+
+    outputWriters::VTKBinaryWriter base64Writer(outputWriters::VTKBinaryWriter::Encoding::BASE64,
+                                                outputWriters::VTKBinaryWriter::Precision::FLOAT64);
+    base64Writer.plotParticles(1, container, "VTKBinaryWriterTestBase64");
+    const std::string base64 = readFile("VTKBinaryWriterTestBase64_0001.vtu");
+    const std::string base64Data = appendedData(base64);
+    // every array is a separately padded base64 block
+    const char *names[] = {"mass", "velocity", "force", "type", "points", "connectivity", "offsets", "types"};
+    for (size_t k = 0; k < 8; k++) {
+        const size_t rawBegin = offsetOf(raw, names[k]);
+        const size_t rawEnd = k + 1 < 8 ? offsetOf(raw, names[k + 1]) : rawData.size();
+        const size_t begin = offsetOf(base64, names[k]);
+        const size_t end = k + 1 < 8 ? offsetOf(base64, names[k + 1]) : base64Data.size();
+        EXPECT_EQ(decodeBase64(base64Data.substr(begin, end - begin)), rawData.substr(rawBegin, rawEnd - rawBegin));
+    }
+    std::remove("VTKBinaryWriterTestRaw_0001.vtu");
+    std::remove("VTKBinaryWriterTestBase64_0001.vtu");
+}
+
+/* Checks the base64 encoding against known values, including both kinds of padding */
+TEST(VTKBinaryWriterTest, base64) {
+    std::string encoded;
+    outputWriters::appendBase64(reinterpret_cast<const unsigned char *>("Man"), 3, encoded);
+    EXPECT_EQ(encoded, "TWFu");
+    encoded.clear();
+    outputWriters::appendBase64(reinterpret_cast<const unsigned char *>("Ma"), 2, encoded);
+    EXPECT_EQ(encoded, "TWE=");
+    encoded.clear();
+    outputWriters::appendBase64(reinterpret_cast<const unsigned char *>("M"), 1, encoded);
+    EXPECT_EQ(encoded, "TQ==");
+}
@@ -7,6 +7,7 @@
 #include "../../src/Objects/Containers/LinkedCell/BoundaryHandler.h"
 #include "../../src/Objects/ParticleIdInitializer.h"
 #include "../../src/Calculator/LennardJonesCalculator.h"
+#include "../../src/Objects/Containers/DirectSum/DirectSumContainer.h"
 
 /**Test the function handleOutflow() from BoundaryHandler */
 TEST(BoundaryHandlerTest, conditionOutflow) {
@@ -34,8 +35,8 @@ for (auto p : testContainer.getParticles()){
 for (int i = 1; i < 5; i++) {
      bool contains = false;
      for (auto cell : testContainer.getBoundaryCells()){
-          for (Particle* p : cell.get().getParticlesInCell()) {
-               if (p->getID() == i) {
+          for (size_t p : cell.get().getParticlesInCell()) {
+               if (testContainer.getStorage()[p].getID() == i) {
                     contains = true;
                }
           }
@@ -52,8 +53,8 @@ for (auto p : testContainer.getParticles()){
 for (int i = 1; i < 5; i++) {
      bool contains = false;
      for (auto cell : testContainer.getHaloCells()){
-          for (Particle* p : cell.get().getParticlesInCell()) {
-               if (p->getID() == i) {
+          for (size_t p : cell.get().getParticlesInCell()) {
+               if (testContainer.getStorage()[p].getID() == i) {
                     contains = true;
                }
           }
@@ -105,15 +106,15 @@ EXPECT_EQ(testContainer.getParticles().size(), 4);
 calculator.calculateXFV(testContainer, 0.5);
 handler.handleBoundaries();
 
-while (testContainer.getParticles().at(0).getV()[1] > 0) {
+while (testContainer.getParticle(1).getV()[1] > 0) {
      calculator.calculateXFV(testContainer, 0.01); 
      handler.handleBoundaries();
 }
 
-EXPECT_TRUE(testContainer.getParticles().at(0).getV()[1] < 0);
-EXPECT_TRUE(testContainer.getParticles().at(1).getV()[1] > 0);
-EXPECT_TRUE(testContainer.getParticles().at(2).getV()[0] > 0);
-EXPECT_TRUE(testContainer.getParticles().at(3).getV()[0] < 0);
+EXPECT_TRUE(testContainer.getParticle(1).getV()[1] < 0);
+EXPECT_TRUE(testContainer.getParticle(2).getV()[1] > 0);
+EXPECT_TRUE(testContainer.getParticle(3).getV()[0] > 0);
+EXPECT_TRUE(testContainer.getParticle(4).getV()[0] < 0);
 
 for (int i = 0; i < 100; i++){
 calculator.calculateXFV(testContainer, 0.01); 
@@ -149,11 +150,11 @@ handler.handleBoundaries();
 do {
      calculator.calculateXFV(testContainer, 0.01); 
      handler.handleBoundaries();
-} while (testContainer.getParticles().at(0).getV()[0] > 0);
+} while (testContainer.getParticle(1).getV()[0] > 0);
 
 
-EXPECT_TRUE(testContainer.getParticles().at(0).getV()[0] < 0);
-EXPECT_TRUE(testContainer.getParticles().at(1).getV()[0] > 0);
+EXPECT_TRUE(testContainer.getParticle(1).getV()[0] < 0);
+EXPECT_TRUE(testContainer.getParticle(2).getV()[0] > 0);
 EXPECT_EQ(testContainer.getParticles().size(), 4); //when 1 and 2 get repelled, 3 and 4 have not been removed yet
 
 bool outflowed = false; 
@@ -174,8 +175,8 @@ if (outflowed) {
      for (int a = 1; a < 3; a++) {
      bool contains = false;
      for (auto cell : testContainer.getCells()){
-          for (Particle* p : cell.getParticlesInCell()) {
-               if (p->getID() == a) {
+          for (size_t p : cell.getParticlesInCell()) {
+               if (testContainer.getStorage()[p].getID() == a) {
                     contains = true;
                }
           }
@@ -189,3 +190,109 @@ if (outflowed) {
 EXPECT_TRUE(outflowed);
 }
 
+
+/**Test that particles crossing a periodic boundary enter the domain at the opposite side */
+TEST(BoundaryHandlerTest, conditionPeriodicWrap) {
+ParticleContainers::LinkedCellContainer testContainer = ParticleContainers::LinkedCellContainer({6, 6, 1}, 1);
+std::array<BoundaryCondition, 6> conditions;
+conditions.fill(BoundaryCondition::PERIODIC);
+BoundaryHandler handler = BoundaryHandler(1, conditions, testContainer);
+Calculators::LennardJonesCalculator calculator = Calculators::LennardJonesCalculator();
+ParticleIdInitializer::reset();
+
+testContainer.addParticle(Particle({5.9, 3, 0}, {1, 0, 0}, 1, 0)); //right
+testContainer.addParticle(Particle({3, 0.1, 0}, {0, -1, 0}, 1, 0)); //bottom
+
+calculator.calculateXFV(testContainer, 0.5);
+handler.handleBoundaries();
+
+ASSERT_EQ(testContainer.getParticles().size(), 2);
+EXPECT_NEAR(testContainer.getParticle(1).getX()[0], 0.4, 1e-12);
+EXPECT_NEAR(testContainer.getParticle(2).getX()[1], 5.6, 1e-12);
+for (auto cell : testContainer.getHaloCells()) {
+     EXPECT_EQ(cell.get().getParticlesInCell().size(), 0);
+}
+}
+
+/**Test that periodic boundaries have to be set on both sides of an axis */
+TEST(BoundaryHandlerTest, conditionPeriodicPairs) {
+ParticleContainers::LinkedCellContainer testContainer = ParticleContainers::LinkedCellContainer({6, 6, 1}, 1);
+std::array<BoundaryCondition, 6> conditions;
+conditions.fill(BoundaryCondition::OUTFLOW);
+conditions[0] = BoundaryCondition::PERIODIC;
+EXPECT_THROW(BoundaryHandler(1, conditions, testContainer), std::invalid_argument);
+
+//a single cell along a periodic axis would let particles interact with their own image
+ParticleContainers::LinkedCellContainer narrowContainer = ParticleContainers::LinkedCellContainer({1.5, 6, 1}, 1);
+conditions[1] = BoundaryCondition::PERIODIC;
+EXPECT_THROW(BoundaryHandler(1, conditions, narrowContainer), std::invalid_argument);
+}
+
+/**Test that the force across periodic boundaries equals the force between the particle and the nearest image */
+TEST(BoundaryHandlerTest, conditionPeriodicForce) {
+//pairs of particles that are close to each other across the boundaries, and the nearest image of the second one
+const std::vector<std::array<std::array<double, 3>, 3>> pairs = {
+     {{{0.5, 5, 0}, {9.4, 5, 0}, {-0.6, 5, 0}}},
+     {{{0.4, 0.4, 0}, {9.8, 9.8, 0}, {-0.2, -0.2, 0}}},
+     {{{0.4, 0.4, 0.4}, {9.8, 9.8, 9.8}, {-0.2, -0.2, -0.2}}}
+};
+std::array<BoundaryCondition, 6> conditions;
+conditions.fill(BoundaryCondition::PERIODIC);
+Calculators::LennardJonesCalculator calculator = Calculators::LennardJonesCalculator();
+for (const auto &pair : pairs) {
+     const bool threeDimensional = pair[0][2] != 0;
+     ParticleContainers::LinkedCellContainer testContainer = ParticleContainers::LinkedCellContainer(
+          {10, 10, threeDimensional ? 10. : 1.}, 2.5);
+     BoundaryHandler handler = BoundaryHandler(1, conditions, testContainer);
+     testContainer.addParticle(Particle(pair[0], {0, 0, 0}, 1, 0));
+     testContainer.addParticle(Particle(pair[1], {0, 0, 0}, 1, 0));
+     calculator.calculateF(testContainer);
+
+     ParticleContainers::DirectSumContainer reference;
+     reference.addParticle(Particle(pair[0], {0, 0, 0}, 1, 0));
+     reference.addParticle(Particle(pair[2], {0, 0, 0}, 1, 0));
+     calculator.calculateF(reference);
+
+     ASSERT_EQ(testContainer.sizeParticles(), 2);
+     const ParticleStorage &particles = testContainer.getStorage();
+     const ParticleStorage &expected = reference.getStorage();
+     const size_t first = particles.x[0] == pair[0][0] ? 0 : 1;
+     EXPECT_GT(std::abs(expected.fx[0]), 1.);
+     EXPECT_NEAR(particles.fx[first], expected.fx[0], 1e-9);
+     EXPECT_NEAR(particles.fy[first], expected.fy[0], 1e-9);
+     EXPECT_NEAR(particles.fz[first], expected.fz[0], 1e-9);
+     EXPECT_NEAR(particles.fx[1 - first], expected.fx[1], 1e-9);
+     EXPECT_NEAR(particles.fy[1 - first], expected.fy[1], 1e-9);
+     EXPECT_NEAR(particles.fz[1 - first], expected.fz[1], 1e-9);
+}
+}
+
+/**Test that no particle is lost and all stay inside a fully periodic domain */
+TEST(BoundaryHandlerTest, conditionPeriodicConservation) {
+ParticleContainers::LinkedCellContainer testContainer = ParticleContainers::LinkedCellContainer({8, 8, 8}, 2);
+std::array<BoundaryCondition, 6> conditions;
+conditions.fill(BoundaryCondition::PERIODIC);
+BoundaryHandler handler = BoundaryHandler(1, conditions, testContainer);
+Calculators::LennardJonesCalculator calculator = Calculators::LennardJonesCalculator();
+
+for (int x = 0; x < 4; x++) {
+     for (int y = 0; y < 4; y++) {
+          for (int z = 0; z < 4; z++) {
+               testContainer.addParticle(Particle({0.2 + 2 * x, 0.2 + 2 * y, 0.2 + 2 * z},
+                                                  {1 - 0.5 * x, 0.5 * y - 1, 0.3 * z}, 1, 0));
+          }
+     }
+}
+
+for (int i = 0; i < 200; i++) {
+     calculator.calculateXFV(testContainer, 0.005);
+     handler.handleBoundaries();
+     ASSERT_EQ(testContainer.sizeParticles(), 64);
+}
+for (auto p : testContainer.getParticles()) {
+     for (int d = 0; d < 3; d++) {
+          EXPECT_GE(p.getX()[d], 0);
+          EXPECT_LT(p.getX()[d], 8);
+     }
+}
+}
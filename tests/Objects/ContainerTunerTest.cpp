@@ -0,0 +1,42 @@
+//
+// ContainerTunerTest.cpp
+//
+#include "gtest/gtest.h"
+#include "Calculator/LennardJonesCalculator.h"
+#include "Objects/Containers/ContainerTuner.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+#include "TestUtils.h"
+
+/* Checks that tuning the container neither changes the trajectory nor loses particles */
+TEST(ContainerTunerTest, tuningKeepsTrajectory) {
+    ParticleContainers::LinkedCellContainer tuned({20.0, 20.0, 1.0}, 2.5);
+    ParticleContainers::LinkedCellContainer reference({20.0, 20.0, 1.0}, 2.5);
+    for (const Particle &p: testUtils::createLattice()) {
+        tuned.addParticle(p);
+        reference.addParticle(p);
+    }
+    // three cell sizes and three Verlet skins
+    EXPECT_EQ(ParticleContainers::ContainerTuner::candidates(tuned).size(), 6);
+
+    Calculators::LennardJonesCalculator calc;
+    const ParticleContainers::ContainerTuner tuner(3, 50);
+    for (int step = 1; step <= 100; step++) {
+        calc.calculateXFV(tuned, 0.002);
+        calc.calculateXFV(reference, 0.002);
+        if (tuner.isDue(step)) {
+            tuner.tune(tuned, calc, 0.002);
+        }
+    }
+    testUtils::expectSameParticles(reference, tuned);
+}
+
+/* Checks that periodic boundaries are only simulated with the cells */
+TEST(ContainerTunerTest, periodicCandidatesWithoutVerletList) {
+    ParticleContainers::LinkedCellContainer periodic({20.0, 20.0, 1.0}, 2.5, 0.5);
+    periodic.setPeriodic({true, true, false});
+    const auto candidates = ParticleContainers::ContainerTuner::candidates(periodic);
+    ASSERT_EQ(candidates.size(), 3);
+    for (const auto &candidate: candidates) {
+        EXPECT_EQ(candidate.skin, 0.0);
+    }
+}
@@ -2,9 +2,22 @@
 // Created by Yasmine Farah on 01/11/2024.
 //
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <type_traits>
 #include "../../src/Objects/Containers/DirectSum/DirectSumContainer.h"
 #include "../src/Objects/Particle.h"
 #include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+#include "Objects/Containers/BarnesHut/BarnesHutContainer.h"
+#include "Calculator/GravityCalculator.h"
+#include "Calculator/LennardJonesCalculator.h"
+#include "TestUtils.h"
+#include "utils/ArrayUtils.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /** Checks if sizeParticles() and addParticle() of DirectSumContainer work correctly */
 TEST(DirectSumContainerTest, StrctureAfterAddParticle) {
@@ -48,6 +61,366 @@ TEST(LinkedCellContainerTest, correctCellInitialization) {
     EXPECT_EQ(testContainer.getHaloCells().size(), 184);
 }
 
+/** Checks that a domain thicker than one cell gets a three dimensional cell grid */
+TEST(LinkedCellContainerTest, correctCellInitialization3D) {
+    ParticleContainers::LinkedCellContainer testContainer(std::array<double,3>{9,9,12}, 3.0);
+    EXPECT_TRUE(testContainer.isThreeDimensional());
+    EXPECT_EQ(testContainer.getCellNumPerDimension()[2], 4);
+    // 5*5*6 = 150
+    EXPECT_EQ(testContainer.getCells().size(), 150);
+    // 3*3*4
+    EXPECT_EQ(testContainer.getInnerCells().size(), 36);
+    // only the center column of 1*1*2 cells is not at a boundary
+    EXPECT_EQ(testContainer.getBoundaryCells().size(), 34);
+    EXPECT_EQ(testContainer.getHaloCells().size(), 114);
+
+    for (auto cell = testContainer.beginCells(); cell != testContainer.endCells(); ++cell) {
+        if (cell->getCellType() == Cell::CType::INNER) {
+            EXPECT_EQ(cell->getNeighbourCells().size(), 26);
+            EXPECT_EQ(cell->getForwardNeighbourCells().size(), 13);
+        }
+    }
+
+    ParticleContainers::LinkedCellContainer flatContainer(std::array<double,3>{9,9,1}, 3.0);
+    EXPECT_FALSE(flatContainer.isThreeDimensional());
+    EXPECT_EQ(flatContainer.getCells().size(), 25);
+}
+
+/** Checks that the three dimensional linked cells find every pair within the cutoff radius */
+TEST(LinkedCellContainerTest, linkedCells3DMatchCutoffDirectSum) {
+    std::vector<Particle> particles;
+    ParticleContainers::LinkedCellContainer linkedCells({12.0, 12.0, 12.0}, 3.0);
+    ASSERT_TRUE(linkedCells.isThreeDimensional());
+    for (int x = 0; x < 6; x++) {
+        for (int y = 0; y < 6; y++) {
+            for (int z = 0; z < 6; z++) {
+                particles.emplace_back(std::array<double, 3>{1.5 + 1.6 * x + 0.05 * (y % 2), 1.5 + 1.6 * y, 1.5 + 1.6 * z + 0.07 * (x % 3)},
+                                       std::array<double, 3>{0.0, 0.0, 0.0}, 1.0, 0);
+                linkedCells.addParticle(particles.back());
+            }
+        }
+    }
+
+    Calculators::LennardJonesCalculator calc;
+    calc.calculateF(linkedCells);
+
+    // reference: all pairs within the cutoff radius
+    for (size_t i = 0; i < particles.size(); i++) {
+        std::array<double, 3> expected = {0.0, 0.0, 0.0};
+        for (size_t j = 0; j < particles.size(); j++) {
+            std::array<double, 3> sub = operator-(particles[j].getX(), particles[i].getX());
+            double norm = ArrayUtils::L2Norm(sub);
+            if (i == j || norm > 3.0) {
+                continue;
+            }
+            expected = operator+(expected, calc.calculateFIJ(sub, 1.0, 1.0, norm));
+        }
+        Particle actual = linkedCells.getParticle(particles[i].getID());
+        for (int in = 0; in < 3; in++) {
+            EXPECT_NEAR(expected[in], actual.getF()[in], 1e-9);
+        }
+    }
+
+#ifdef _OPENMP
+    // the colouring has to cover the 3d stencil as well, the forces do not depend on the number of threads
+    ParticleContainers::LinkedCellContainer parallelCells({12.0, 12.0, 12.0}, 3.0);
+    for (const Particle &p: particles) {
+        parallelCells.addParticle(p);
+    }
+    omp_set_num_threads(3);
+    calc.calculateF(parallelCells);
+    omp_set_num_threads(omp_get_num_procs());
+    for (size_t i = 0; i < linkedCells.sizeParticles(); i++) {
+        EXPECT_EQ(linkedCells.getStorage().fx[i], parallelCells.getStorage().fx[i]);
+        EXPECT_EQ(linkedCells.getStorage().fz[i], parallelCells.getStorage().fz[i]);
+    }
+#endif
+}
+
+/** Checks that the half-shell stencil contains every pair of neighbouring cells exactly once */
+TEST(LinkedCellContainerTest, halfShellStencil) {
+    ParticleContainers::LinkedCellContainer testContainer(std::array<double,3>{10,8,1}, 2.0);
+    size_t neighbourPairs = 0;
+    size_t forwardPairs = 0;
+    for (auto cell = testContainer.beginCells(); cell != testContainer.endCells(); ++cell) {
+        neighbourPairs += cell->getNeighbourCells().size();
+        for (Cell *forward: cell->getForwardNeighbourCells()) {
+            EXPECT_GT(forward, &*cell);
+            const auto &backward = forward->getNeighbourCells();
+            EXPECT_NE(std::find(backward.begin(), backward.end(), &*cell), backward.end());
+            const auto &backwardForward = forward->getForwardNeighbourCells();
+            EXPECT_EQ(std::find(backwardForward.begin(), backwardForward.end(), &*cell), backwardForward.end());
+            forwardPairs++;
+        }
+    }
+    EXPECT_EQ(2 * forwardPairs, neighbourPairs);
+}
+
+/** Checks the cell grid and the stencil of cells that are smaller than the cutoff radius */
+TEST(LinkedCellContainerTest, subCutoffCells) {
+    ParticleContainers::LinkedCellContainer halfCells(std::array<double,3>{180,90,1}, 3.0, 0, 0, 0.5);
+    EXPECT_EQ(halfCells.getHaloDepth(), 2);
+    EXPECT_EQ(halfCells.getCellNumPerDimension()[0], 120);
+    EXPECT_EQ(halfCells.getCellNumPerDimension()[1], 60);
+    // 124*64 = 7936
+    EXPECT_EQ(halfCells.getCells().size(), 7936);
+    // 120*60 - 116*56
+    EXPECT_EQ(halfCells.getBoundaryCells().size(), 704);
+    EXPECT_EQ(halfCells.getInnerCells().size(), 7200);
+
+    ParticleContainers::LinkedCellContainer thirdCells(std::array<double,3>{12,12,12}, 3.0, 0, 0, 1.0 / 3);
+    EXPECT_EQ(thirdCells.getHaloDepth(), 3);
+    // the 7*7*7 stencil without the cell itself and the 8 corners, which are more than one cutoff radius away
+    for (auto cell = thirdCells.beginCells(); cell != thirdCells.endCells(); ++cell) {
+        if (cell->getCellType() == Cell::CType::INNER) {
+            EXPECT_EQ(cell->getNeighbourCells().size(), 334);
+        }
+    }
+
+    EXPECT_THROW(ParticleContainers::LinkedCellContainer(std::array<double,3>{12,12,12}, 3.0, 0, 0, 0), std::invalid_argument);
+    EXPECT_THROW(ParticleContainers::LinkedCellContainer(std::array<double,3>{12,12,12}, 3.0, 0, 0, 1.5), std::invalid_argument);
+    // the halo of three layers does not fit into a periodic axis of five cells
+    ParticleContainers::LinkedCellContainer thinCells(std::array<double,3>{5,12,12}, 3.0, 0, 0, 1.0 / 3);
+    EXPECT_THROW(thinCells.setPeriodic({true, false, false}), std::invalid_argument);
+}
+
+/** Checks that cells smaller than the cutoff radius find the same pairs as cells of the cutoff radius */
+TEST(LinkedCellContainerTest, subCutoffCellsMatchLinkedCells) {
+    for (bool periodic: {false, true}) {
+        ParticleContainers::LinkedCellContainer reference({12.0, 12.0, 12.0}, 3.0);
+        ParticleContainers::LinkedCellContainer halfCells({12.0, 12.0, 12.0}, 3.0, 0, 0, 0.5);
+        ParticleContainers::LinkedCellContainer thirdCells({12.0, 12.0, 12.0}, 3.0, 0, 0, 1.0 / 3);
+        if (periodic) {
+            reference.setPeriodic({true, true, true});
+            halfCells.setPeriodic({true, true, true});
+            thirdCells.setPeriodic({true, true, true});
+        }
+        for (int x = 0; x < 7; x++) {
+            for (int y = 0; y < 7; y++) {
+                for (int z = 0; z < 7; z++) {
+                    Particle p({0.3 + 1.65 * x + 0.05 * (y % 2), 0.4 + 1.65 * y, 0.2 + 1.65 * z + 0.07 * (x % 3)},
+                               {0.0, 0.0, 0.0}, 1.0, 0);
+                    reference.addParticle(p);
+                    halfCells.addParticle(p);
+                    thirdCells.addParticle(p);
+                }
+            }
+        }
+
+        Calculators::LennardJonesCalculator calc;
+        for (int step = 0; step < 5; step++) {
+            calc.calculateXFV(reference, 0.0005);
+            calc.calculateXFV(halfCells, 0.0005);
+            calc.calculateXFV(thirdCells, 0.0005);
+        }
+        testUtils::expectSameParticles(reference, halfCells);
+        testUtils::expectSameParticles(reference, thirdCells);
+    }
+}
+
+/** Checks that reconfiguring the grid in place keeps the particles, their forces and the periodic boundaries */
+TEST(LinkedCellContainerTest, reconfigureInPlace) {
+    static_assert(!std::is_copy_constructible<ParticleContainers::LinkedCellContainer>::value,
+                  "the cells point into the container");
+    ParticleContainers::LinkedCellContainer container(std::array<double,3>{12,12,12}, 3.0);
+    container.setPeriodic({true, false, false});
+    for (int i = 0; i < 20; i++) {
+        Particle p({0.3 + 0.55 * i, 6.0, 1.0 + 0.5 * (i % 7)}, {0.0, 0.0, 0.0}, 1.0, 0);
+        p.setF({1.0 * i, 0.0, 0.0});
+        container.addParticle(p);
+    }
+    container.updateParticlesInCell();
+
+    container.reconfigure(0.5, 0, 0);
+    EXPECT_EQ(container.getHaloDepth(), 2);
+    EXPECT_EQ(container.getCellNumPerDimension()[0], 8);
+    EXPECT_EQ(container.getCells().size(), 12 * 12 * 12);
+    EXPECT_TRUE(container.getPeriodic()[0]);
+    ASSERT_EQ(container.sizeParticles(), 20);
+    double forceSum = 0;
+    for (auto cell = container.beginCells(); cell != container.endCells(); ++cell) {
+        for (size_t i: cell->getParticlesInCell()) {
+            EXPECT_EQ(container.mapPositionToCell({container.getStorage().x[i], container.getStorage().y[i],
+                                                   container.getStorage().z[i]}), &*cell);
+            forceSum += container.getStorage().fx[i];
+        }
+    }
+    EXPECT_EQ(forceSum, 190.0);
+
+    container.reconfigure(1, 0.5, 10);
+    EXPECT_EQ(container.getHaloDepth(), 1);
+    // the Verlet list is disabled for periodic boundaries
+    EXPECT_FALSE(container.usesVerletList());
+    EXPECT_THROW(container.reconfigure(0, 0, 0), std::invalid_argument);
+}
+
+/** Checks that the particles are stored sorted by cell and stay sorted after they moved */
+TEST(LinkedCellContainerTest, particlesSortedByCell) {
+    ParticleContainers::LinkedCellContainer testContainer(std::array<double,3>{4,4,1}, 1.0);
+    testContainer.addParticle(Particle({3.5, 3.5, 0.0},{0.0, 0.0, 0.0},1.0,0));
+    testContainer.addParticle(Particle({0.5, 0.5, 0.0},{0.0, 0.0, 0.0},1.0,0));
+    testContainer.addParticle(Particle({3.2, 3.7, 0.0},{0.0, 0.0, 0.0},1.0,0));
+    testContainer.addParticle(Particle({1.5, 2.5, 0.0},{0.0, 0.0, 0.0},1.0,0));
+
+    auto checkCells = [&testContainer]() {
+        size_t expectedBegin = 0;
+        for (auto cell = testContainer.beginCells(); cell != testContainer.endCells(); ++cell) {
+            EXPECT_EQ(*cell->beginParticle(), expectedBegin);
+            for (size_t p: cell->getParticlesInCell()) {
+                EXPECT_EQ(testContainer.mapPositionToCell(testContainer.getStorage()[p].getX()), &*cell);
+            }
+            expectedBegin += cell->getParticlesInCell().size();
+        }
+        EXPECT_EQ(expectedBegin, testContainer.sizeParticles());
+    };
+    checkCells();
+
+    auto &storage = testContainer.getStorage();
+    EXPECT_EQ(storage.x[0], 0.5);
+    EXPECT_EQ(storage.x[1], 1.5);
+    EXPECT_EQ(storage.x[2] + storage.x[3], 3.5 + 3.2);
+
+    // move the first particle into the last inner cell and the second one out of the domain
+    storage.x[0] = 3.9;
+    storage.y[0] = 3.9;
+    storage.x[1] = 7.0;
+    testContainer.updateParticlesInCell();
+    EXPECT_EQ(testContainer.sizeParticles(), 3);
+    // the sort is stable, so the moved particle is placed in front of the particles of its new cell
+    EXPECT_EQ(storage.x[0], 3.9);
+    checkCells();
+}
+
+/** Checks that particles marked for removal are dropped by one sort and that the Verlet list follows the compaction */
+TEST(LinkedCellContainerTest, markForRemoval) {
+    ParticleContainers::LinkedCellContainer testContainer(std::array<double,3>{6,6,1}, 1.5, 0.3);
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) {
+            testContainer.addParticle(Particle({0.5 + i, 0.5 + j, 0.0},{0.0, 0.0, 0.0},1.0,0));
+        }
+    }
+    const size_t pairsBefore = testContainer.getVerletPairs().size();
+    std::set<ParticleId> removedIds;
+    for (size_t p = 0; p < testContainer.sizeParticles(); p += 3) {
+        removedIds.insert(testContainer.getStorage().id[p]);
+        testContainer.markForRemoval(p);
+    }
+    testContainer.updateParticlesInCell();
+    EXPECT_EQ(testContainer.sizeParticles(), 36 - removedIds.size());
+    for (ParticleId id: testContainer.getStorage().id) {
+        EXPECT_EQ(removedIds.count(id), 0);
+    }
+
+    const auto &pairs = testContainer.getVerletPairs();
+    EXPECT_LT(pairs.size(), pairsBefore);
+    auto &storage = testContainer.getStorage();
+    for (const auto &pair: pairs) {
+        ASSERT_LT(pair.second, storage.size());
+        const double dx = storage.x[pair.first] - storage.x[pair.second];
+        const double dy = storage.y[pair.first] - storage.y[pair.second];
+        EXPECT_LE(dx * dx + dy * dy, 1.8 * 1.8);
+    }
+}
+
+/** Checks that every node of the Barnes-Hut tree contains its particles and knows their mass and center of mass */
+TEST(BarnesHutContainerTest, treeStructure) {
+    for (bool threeDimensional: {false, true}) {
+        ParticleContainers::BarnesHutContainer testContainer(0.5);
+        for (int k = 0; k < 300; k++) {
+            double z = threeDimensional ? (k * 37 % 23) * 0.7 : 0.0;
+            testContainer.addParticle(Particle({(k * 17 % 31) * 0.5, (k * 13 % 29) * 0.3, z}, {0.0, 0.0, 0.0}, 1.0 + k % 3, 0));
+        }
+        // particles at the same position end up in one leaf at the maximal depth
+        testContainer.addParticle(Particle({1.0, 1.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+        testContainer.addParticle(Particle({1.0, 1.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0));
+        testContainer.buildTree();
+        EXPECT_EQ(testContainer.isTwoDimensional(), !threeDimensional);
+
+        auto &storage = testContainer.getStorage();
+        const auto &nodes = testContainer.getNodes();
+        const auto &order = testContainer.getTreeOrder();
+        ASSERT_FALSE(nodes.empty());
+        EXPECT_EQ(nodes[0].particlesBegin, 0);
+        EXPECT_EQ(nodes[0].particlesEnd, storage.size());
+        EXPECT_EQ(std::set<size_t>(order.begin(), order.end()).size(), storage.size());
+
+        for (const auto &node: nodes) {
+            double mass = 0;
+            std::array<double, 3> weighted = {0, 0, 0};
+            // particles on a cell face may be off by a rounding error
+            const double extent = node.halfSize * (1 + 1e-12);
+            for (size_t k = node.particlesBegin; k < node.particlesEnd; k++) {
+                const size_t p = order[k];
+                EXPECT_LE(std::abs(storage.x[p] - node.center[0]), extent);
+                EXPECT_LE(std::abs(storage.y[p] - node.center[1]), extent);
+                EXPECT_LE(std::abs(storage.z[p] - node.center[2]), extent);
+                mass += storage.m[p];
+                weighted[0] += storage.m[p] * storage.x[p];
+                weighted[1] += storage.m[p] * storage.y[p];
+                weighted[2] += storage.m[p] * storage.z[p];
+            }
+            EXPECT_NEAR(node.mass, mass, 1e-9);
+            for (int d = 0; d < 3; d++) {
+                EXPECT_NEAR(node.centerOfMass[d], weighted[d] / mass, 1e-9);
+            }
+            if (node.numChildren > 0) {
+                // the children partition the range of their parent
+                EXPECT_EQ(nodes[node.firstChild].particlesBegin, node.particlesBegin);
+                EXPECT_EQ(nodes[node.firstChild + node.numChildren - 1].particlesEnd, node.particlesEnd);
+                EXPECT_LE(node.numChildren, threeDimensional ? 8 : 4);
+            }
+        }
+    }
+}
+
+/** Checks the Barnes-Hut forces against the direct sum: exact for theta = 0 and increasingly approximate for larger theta */
+TEST(BarnesHutContainerTest, forcesMatchDirectSum) {
+    for (bool threeDimensional: {false, true}) {
+        ParticleContainers::DirectSumContainer direct;
+        std::vector<Particle> particles;
+        for (int k = 0; k < 400; k++) {
+            // a dense core and a sparse halo, similar to a galaxy
+            const double radius = k < 200 ? 1.0 + 0.01 * k : 5.0 + 0.2 * (k % 50);
+            const double angle = 2.399963 * k;
+            const double z = threeDimensional ? radius * std::sin(0.7 * k) : 0.0;
+            particles.emplace_back(std::array<double, 3>{radius * std::cos(angle), radius * std::sin(angle), z},
+                                   std::array<double, 3>{0.0, 0.0, 0.0}, 0.5 + (k % 7) * 0.25, 0);
+            direct.addParticle(particles.back());
+        }
+        Calculators::GravityCalculator calc;
+        calc.calculateF(direct);
+
+        double previousError = -1;
+        for (double theta: {0.0, 0.3, 0.6, 1.0}) {
+            ParticleContainers::BarnesHutContainer tree(theta);
+            for (const Particle &p: particles) {
+                tree.addParticle(p);
+            }
+            calc.calculateF(tree);
+            EXPECT_EQ(tree.isTwoDimensional(), !threeDimensional);
+
+            // relative error of the force, summed over all particles
+            double error = 0;
+            double norm = 0;
+            ParticleStorage &expected = direct.getStorage();
+            ParticleStorage &actual = tree.getStorage();
+            for (size_t i = 0; i < expected.size(); i++) {
+                error += std::pow(expected.fx[i] - actual.fx[i], 2) + std::pow(expected.fy[i] - actual.fy[i], 2) +
+                         std::pow(expected.fz[i] - actual.fz[i], 2);
+                norm += std::pow(expected.fx[i], 2) + std::pow(expected.fy[i], 2) + std::pow(expected.fz[i], 2);
+            }
+            error = std::sqrt(error / norm);
+            if (theta == 0.0) {
+                EXPECT_LT(error, 1e-12);
+            } else {
+                EXPECT_LT(error, 0.05 * theta);
+                EXPECT_GT(error, previousError);
+            }
+            previousError = error;
+        }
+    }
+}
+
 /* Tests that ids of new particles get initialized correctly */
 TEST(ParticleIdInitializerTest, testIDsAreUnique) {
     ParticleIdInitializer::reset();
@@ -62,4 +435,38 @@ TEST(ParticleIdInitializerTest, testIDsAreUnique) {
 
     Particle s(1); //creating particles from copy should not influence new ids
     EXPECT_EQ(s.getID(), 3);
-}
\ No newline at end of file
+}
+
+/* Tests that ranges of ids do not overlap with single ids, also beyond the range of int */
+TEST(ParticleIdInitializerTest, ranges) {
+    ParticleIdInitializer::reset();
+    EXPECT_EQ(ParticleIdInitializer::reserveRange(10), 1);
+    EXPECT_EQ(ParticleIdInitializer::getNewId(), 11);
+    const ParticleId large = ParticleIdInitializer::reserveRange(static_cast<size_t>(1) << 32);
+    EXPECT_EQ(large, 12);
+    EXPECT_GT(ParticleIdInitializer::getNewId(), std::numeric_limits<int>::max());
+}
+
+/* Checks that particles keep their complete state in the structure-of-arrays storage
+ * and that changes through the iterator handles are written back */
+TEST(ParticleStorageTest, storeAndModifyParticles) {
+    ParticleContainers::LinkedCellContainer testContainer(std::array<double,3>{10,10,1}, 1.0);
+    Particle p({1.0, 2.0, 0.0},{0.5, 0.0, 0.0},2.0,3);
+    p.setF({1.0, 1.0, 1.0});
+    testContainer.addParticle(p);
+    testContainer.addParticle(Particle({5.0, 5.0, 0.0},{0.0, 0.0, 0.0},1.0,0));
+
+    Particle stored = testContainer.getParticles().at(0);
+    EXPECT_EQ(stored.getID(), p.getID());
+    EXPECT_EQ(stored.getType(), 3);
+    EXPECT_EQ(stored.getM(), 2.0);
+    EXPECT_EQ(stored.getF()[2], 1.0);
+
+    for (auto particle : testContainer) {
+        particle.setV({0.0, 7.0, 0.0});
+    }
+    EXPECT_EQ(testContainer.getStorage().vy[0], 7.0);
+    EXPECT_EQ(testContainer.getStorage().vy[1], 7.0);
+    EXPECT_EQ(testContainer.end() - testContainer.begin(), 2);
+    EXPECT_EQ(testContainer.begin()->getM(), 2.0);
+}
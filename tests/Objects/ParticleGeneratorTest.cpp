@@ -3,9 +3,15 @@
 //
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "../../src/Objects/ParticleGenerator.h"
 #include "../../src/Objects/Cuboid.h"
 #include "../../src/Objects/Containers/DirectSum/DirectSumContainer.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
 #include "utils/ArrayUtils.h"
 
 
@@ -70,7 +76,7 @@ TEST(ParticleGeneratorTest, checkParticlePositions1) {
     ParticleGenerator::generateCuboid(pc,cuboid1);
     std::array<std::array<double,3>,8> expected = {std::array<double,3>{0.0,0.0,0.0},std::array<double,3>{0.5,0.0,0.0},std::array<double,3>{0.0,0.5,0.0},std::array<double,3>{0.5,0.5,0.0},std::array<double,3>{0.0,0.0,0.5},std::array<double,3>{0.5,0.0,0.5},std::array<double,3>{0.0,0.5,0.5},std::array<double,3>{0.5,0.5,0.5}};
     int i = 0;
-    for (Particle &p : pc) {
+    for (auto p : pc) {
         EXPECT_EQ(expected[i][0] , p.getX()[0]);
         EXPECT_EQ(expected[i][1] , p.getX()[1]);
         EXPECT_EQ(expected[i][2] , p.getX()[2]);
@@ -90,7 +96,7 @@ TEST(ParticleGeneratorTest, checkParticlePositions2) {
     std::array<std::array<double,3>,5> expected = {std::array<double,3>{1.0,0.0,0.0},std::array<double,3>{0.0,1.0,0.0},std::array<double,3>{1.0,1.0,0.0},std::array<double,3>{2.0,1.0,0.0},
         std::array<double,3>{1.0,2.0,0.0}};
     int i = 0;
-    for (Particle &p : pc) {
+    for (auto p : pc) {
         EXPECT_EQ(expected[i][0] , p.getX()[0]);
         EXPECT_EQ(expected[i][1] , p.getX()[1]);
         EXPECT_EQ(expected[i][2] , p.getX()[2]);
@@ -110,7 +116,7 @@ TEST(ParticleGeneratorTest, checkOtherVariables) {
     Cuboid cuboid1(x,N, h, m,V,mv);
     ParticleContainers::DirectSumContainer pc;
     ParticleGenerator::generateCuboid(pc,cuboid1);
-    for (Particle &p : pc) {
+    for (auto p : pc) {
         //check X
         EXPECT_EQ(0.7 , p.getX()[0]);
         EXPECT_EQ(0.0 , p.getX()[1]);
@@ -120,4 +126,76 @@ TEST(ParticleGeneratorTest, checkOtherVariables) {
 
     }
 
-}
\ No newline at end of file
+}
+/* checks that cuboids generated into one storage are binned once and keep unique ids and their type */
+TEST(ParticleGeneratorTest, generateIntoStorage) {
+    ParticleStorage particles;
+    Cuboid cuboid1({0.5, 0.5, 0.0}, {10.0, 5.0, 1.0}, 1.0, 1.0, {0.0, 0.0, 0.0}, 0.1, 1);
+    Cuboid cuboid2({0.5, 6.5, 0.0}, {4.0, 2.0, 1.0}, 1.0, 2.0, {0.0, 0.0, 0.0}, 0.1, 0);
+    ParticleGenerator::generateCuboid(particles, cuboid1);
+    ParticleGenerator::generateCuboid(particles, cuboid2);
+    ASSERT_EQ(particles.size(), 58);
+    EXPECT_EQ(particles.type[49], 1);
+    EXPECT_EQ(particles.m[50], 2.0);
+    EXPECT_EQ(particles.y[50], 6.5);
+    EXPECT_EQ(particles.fx[57], 0.0);
+    for (size_t i = 1; i < particles.size(); i++) {
+        EXPECT_EQ(particles.id[i], particles.id[i - 1] + 1);
+    }
+
+    ParticleContainers::LinkedCellContainer pc(std::array<double, 3>{12, 9, 1}, 3.0);
+    pc.addParticles(particles);
+    EXPECT_EQ(pc.sizeParticles(), 58);
+    size_t binned = 0;
+    for (auto cell = pc.beginCells(); cell != pc.endCells(); ++cell) {
+        binned += cell->getParticlesInCell().size();
+    }
+    EXPECT_EQ(binned, 58);
+}
+
+/* checks that the generated cuboid does not depend on the number of threads and that the velocities are Maxwell-Boltzmann distributed */
+TEST(ParticleGeneratorTest, parallelGenerationIsDeterministic) {
+    Cuboid cuboid({0.0, 0.0, 0.0}, {60.0, 50.0, 4.0}, 1.1, 1.0, {1.0, 0.0, 0.5}, 2.0, 0);
+    std::vector<ParticleStorage> results;
+    for (int threads: {1, 3, 4}) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+        ParticleIdInitializer::reset();
+        results.emplace_back();
+        ParticleGenerator::generateCuboid(results.back(), cuboid, 5);
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+    for (const ParticleStorage &result: results) {
+        EXPECT_EQ(result.x, results[0].x);
+        EXPECT_EQ(result.z, results[0].z);
+        EXPECT_EQ(result.vx, results[0].vx);
+        EXPECT_EQ(result.vy, results[0].vy);
+        EXPECT_EQ(result.id, results[0].id);
+    }
+
+    const ParticleStorage &particles = results[0];
+    const size_t n = particles.size();
+    double sumX = 0, sumSquaresX = 0, sumY = 0, sumSquaresY = 0;
+    for (size_t i = 0; i < n; i++) {
+        sumX += particles.vx[i] - 1.0;
+        sumSquaresX += (particles.vx[i] - 1.0) * (particles.vx[i] - 1.0);
+        sumY += particles.vy[i];
+        sumSquaresY += particles.vy[i] * particles.vy[i];
+        // the velocities are drawn in two dimensions
+        EXPECT_EQ(particles.vz[i], 0.5);
+    }
+    // mean 0 and standard deviation 2 within a few standard errors
+    EXPECT_NEAR(sumX / n, 0.0, 0.1);
+    EXPECT_NEAR(sumY / n, 0.0, 0.1);
+    EXPECT_NEAR(std::sqrt(sumSquaresX / n), 2.0, 0.05);
+    EXPECT_NEAR(std::sqrt(sumSquaresY / n), 2.0, 0.05);
+
+    // another shape gets other velocities
+    ParticleStorage otherShape;
+    ParticleGenerator::generateCuboid(otherShape, cuboid, 6);
+    EXPECT_EQ(otherShape.x, particles.x);
+    EXPECT_NE(otherShape.vx, particles.vx);
+}
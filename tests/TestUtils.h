@@ -0,0 +1,47 @@
+//
+// TestUtils.h
+//
+#pragma once
+
+#include <array>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Objects/Containers/LinkedCell/LinkedCellContainer.h"
+#include "Objects/Particle.h"
+
+namespace testUtils {
+    /**
+     * @brief 8 x 8 particles at the minimum of the Lennard-Jones potential in the plane z = 0.5 of a 20 x 20 x 1
+     * domain, with small deterministic velocities
+     * @param variedMasses true for masses of 1, 1.1 and 1.2 alternating along x, false for mass 1
+     * @return the particles
+     */
+    inline std::vector<Particle> createLattice(bool variedMasses = false) {
+        std::vector<Particle> particles;
+        for (int x = 0; x < 8; x++) {
+            for (int y = 0; y < 8; y++) {
+                particles.emplace_back(std::array<double, 3>{5.0 + 1.1225 * x, 5.0 + 1.1225 * y, 0.5},
+                                       std::array<double, 3>{0.3 * ((x * 7 + y * 3) % 5 - 2),
+                                                             0.2 * ((x + y * 5) % 7 - 3), 0.0},
+                                       variedMasses ? 1.0 + 0.1 * (x % 3) : 1.0, 0);
+            }
+        }
+        return particles;
+    }
+
+    /**
+     * @brief Expects that both containers hold the same particles at the same positions (up to 1e-9) with the same
+     * forces (up to 1e-6), the particles are matched by their id
+     */
+    inline void expectSameParticles(ParticleContainers::LinkedCellContainer &expected,
+                                    ParticleContainers::LinkedCellContainer &actual) {
+        ASSERT_EQ(expected.sizeParticles(), actual.sizeParticles());
+        for (auto p: expected) {
+            Particle q = actual.getParticle(p.getID());
+            for (int in = 0; in < 3; in++) {
+                EXPECT_NEAR(p.getX()[in], q.getX()[in], 1e-9);
+                EXPECT_NEAR(p.getF()[in], q.getF()[in], 1e-6);
+            }
+        }
+    }
+}
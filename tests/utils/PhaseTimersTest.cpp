@@ -0,0 +1,44 @@
+//
+// PhaseTimersTest.cpp
+//
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "utils/PhaseTimers.h"
+
+/* Checks the totals and percentiles of the phases and the timing file written every N iterations */
+TEST(PhaseTimersTest, statisticsAndDump) {
+    PhaseTimers timers;
+    timers.setDump("PhaseTimersTest.csv", 4);
+    for (int iteration = 1; iteration <= 10; ++iteration) {
+        // the force phase takes iteration milliseconds, split in two parts
+        timers.add(Phase::FORCE, std::chrono::microseconds(500 * iteration));
+        timers.add(Phase::FORCE, std::chrono::microseconds(500 * iteration));
+        timers.add(Phase::POSITION, std::chrono::milliseconds(1));
+        timers.endIteration(iteration, 100);
+    }
+
+    EXPECT_EQ(timers.getIterations(), 10);
+    EXPECT_NEAR(timers.getTotal(Phase::FORCE), 0.055, 1e-9);
+    EXPECT_NEAR(timers.getTotal(Phase::POSITION), 0.010, 1e-9);
+    EXPECT_EQ(timers.getTotal(Phase::OUTPUT), 0.0);
+    EXPECT_NEAR(timers.getPercentile(Phase::FORCE, 0.0), 0.001, 1e-6);
+    EXPECT_NEAR(timers.getPercentile(Phase::FORCE, 0.5), 0.006, 1e-6);
+    EXPECT_NEAR(timers.getPercentile(Phase::FORCE, 1.0), 0.010, 1e-6);
+    EXPECT_GT(timers.getMUPS(), 0.0);
+    EXPECT_NE(timers.summary().find("force"), std::string::npos);
+
+    std::ifstream file("PhaseTimersTest.csv");
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0], "iteration,particles,position,force,boundary,output,checkpoint,tuning,wall,MUPS");
+    // iterations 5 to 8 took 4 ms for the positions and 26 ms for the forces
+    EXPECT_EQ(lines[2].rfind("8,100,0.004,0.026,0,0,0,0,", 0), 0);
+    file.close();
+    std::remove("PhaseTimersTest.csv");
+}